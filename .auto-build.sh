@@ -70,14 +70,20 @@ function autobuild()
     echo "Building examples..."
 
     # Use option -O "lib_ldf_mode=chain+" to parse defines
+    pio ci -O "lib_ldf_mode=chain+" --lib="." ${BOARDS_AVR} examples/ErriezOregonTHN128Benchmark/ErriezOregonTHN128Benchmark.ino
     pio ci -O "lib_ldf_mode=chain+" --lib="." ${BOARDS_AVR} examples/ErriezOregonTHN128Receive/ErriezOregonTHN128Receive.ino
+    pio ci -O "lib_ldf_mode=chain+" --lib="." ${BOARDS_AVR} examples/ErriezOregonTHN128ReceiveMultiple/ErriezOregonTHN128ReceiveMultiple.ino
     pio ci -O "lib_ldf_mode=chain+" --lib="." ${BOARDS_AVR} examples/ErriezOregonTHN128ReceiveSSD1306/ErriezOregonTHN128ReceiveSSD1306.ino
     pio ci -O "lib_ldf_mode=chain+" --lib="." ${BOARDS_AVR} examples/ErriezOregonTHN128Transmit/ErriezOregonTHN128Transmit.ino
+    pio ci -O "lib_ldf_mode=chain+" --lib="." ${BOARDS_AVR} examples/ErriezOregonTHN128TransmitAsync/ErriezOregonTHN128TransmitAsync.ino
     pio ci -O "lib_ldf_mode=chain+" --lib="." ${BOARDS_AVR} examples/ErriezOregonTHN128TransmitDS1820/ErriezOregonTHN128TransmitDS1820.ino
 
+    pio ci -O "lib_ldf_mode=chain+" --lib="." ${BOARDS_ESP8266} ${BOARDS_ESP32} examples/ErriezOregonTHN128Benchmark/ErriezOregonTHN128Benchmark.ino
     pio ci -O "lib_ldf_mode=chain+" --lib="." ${BOARDS_ESP8266} ${BOARDS_ESP32} examples/ErriezOregonTHN128Receive/ErriezOregonTHN128Receive.ino
+    pio ci -O "lib_ldf_mode=chain+" --lib="." ${BOARDS_ESP8266} ${BOARDS_ESP32} examples/ErriezOregonTHN128ReceiveMultiple/ErriezOregonTHN128ReceiveMultiple.ino
     pio ci -O "lib_ldf_mode=chain+" --lib="." ${BOARDS_ESP8266} ${BOARDS_ESP32} examples/ErriezOregonTHN128ReceiveSSD1306/ErriezOregonTHN128ReceiveSSD1306.ino
     pio ci -O "lib_ldf_mode=chain+" --lib="." ${BOARDS_ESP8266} ${BOARDS_ESP32} examples/ErriezOregonTHN128Transmit/ErriezOregonTHN128Transmit.ino
+    pio ci -O "lib_ldf_mode=chain+" --lib="." ${BOARDS_ESP8266} ${BOARDS_ESP32} examples/ErriezOregonTHN128TransmitAsync/ErriezOregonTHN128TransmitAsync.ino
     pio ci -O "lib_ldf_mode=chain+" --lib="." ${BOARDS_ESP8266} ${BOARDS_ESP32} examples/ErriezOregonTHN128TransmitDS1820/ErriezOregonTHN128TransmitDS1820.ino
     pio ci -O "lib_ldf_mode=chain+" --lib="."                   ${BOARDS_ESP32} examples/ESP32/Erriez_Oregon_THN128_ESP32_MQTT_Homeassistant/Erriez_Oregon_THN128_ESP32_MQTT_Homeassistant.ino
 }
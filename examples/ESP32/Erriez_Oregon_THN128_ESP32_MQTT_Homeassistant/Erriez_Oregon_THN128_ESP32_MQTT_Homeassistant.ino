@@ -28,6 +28,15 @@
  *      Source:         https://github.com/Erriez/ErriezOregonTHN128
  *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
  *
+ *  IMPORTANT: flash partition table
+ *  - This sketch writes raw flash sectors of the data partition "forward" (subtype 0x40) declared
+ *    in partitions.csv next to this sketch. Arduino-ESP32 uses this partitions.csv automatically
+ *    when the sketch is compiled, uploading replaces the partition table of the board.
+ *  - The partition replaces the spiffs partition of the default 4MB table: files stored with SPIFFS
+ *    or LittleFS on the board are lost after uploading this sketch.
+ *  - Store-and-forward is disabled when the partition is not found or contains other data than
+ *    store-and-forward sectors. The sketch never erases a file system.
+ *
  *  Hardware:
  *  - Tested with NodeMCU-32S
  *  - LED_PIN:   LED pin on the ESP32
@@ -53,6 +62,12 @@
  *  - MQTT_USERNAME   Optional: MQTT username (optional in combination with MQTT_PASSWORD)
  *  - MQTT_PASSWORD   Optional: MQTT password (optional in combination with MQTT_USERNAME)
  *  - MQTT_DEVICE_ID  MQTT unique device ID
+ *
+ *  Store-and-forward:
+ *  - Readings received while WiFi or MQTT is disconnected are stored in the flash data partition
+ *    FORWARD_PARTITION and published in batches to topic oregon_thn128/history after reconnect.
+ *    The 1408 kB partition in partitions.csv holds 27 days of 3 sensors.
+ *  - Timestamps are seconds since epoch from NTP, or since boot when NTP was not available.
  */
 
 // Enable SSL
@@ -66,7 +81,11 @@
 #endif
 #include <ArduinoJson.h>                  // https://github.com/bblanchon/ArduinoJson.git v6.19.4
 #include <MQTTClient.h>                   // https://github.com/256dpi/arduino-mqtt v2.5.0
-#include <ErriezOregonTHN128Receive.h>    // https://github.com/Erriez/ErriezOregonTHN128 v1.1.1
+#include <ErriezOregonTHN128Receive.h>    // https://github.com/Erriez/ErriezOregonTHN128 v1.2.0
+#include <ErriezOregonTHN128Registry.h>
+#include <ErriezOregonTHN128Forward.h>
+#include <esp_partition.h>
+#include <time.h>
 
 #ifndef ARDUINO_ARCH_ESP32
 #error "This example has been tested on ESP32 only"
@@ -76,6 +95,7 @@
 #define LED_PIN             LED_BUILTIN
 #define RF_RX_PIN           19  // GPIO19
 #define RX_CH_TIMETOUT_MS   (2 * 60 * 1000)
+#define RX_STATS_INTERVAL_MS (5 * 60 * 1000)
 
 // WiFi SSID and password
 #define WIFI_SSID       "YOUR_SSID"
@@ -105,6 +125,17 @@
 // MQTT device ID, subscribe topic and publish topic
 #define MQTT_DEVICE_ID  "esp32.oregon_thn128"
 
+// MQTT reconnect interval
+#define MQTT_RECONNECT_MS   5000
+
+// Store-and-forward data partition and records per publish
+#define FORWARD_PARTITION   "forward"
+#define FORWARD_SUBTYPE     ((esp_partition_subtype_t)0x40)
+#define FORWARD_BATCH       8
+
+// NTP server
+#define NTP_SERVER          "pool.ntp.org"
+
 // WiFi client
 #ifdef USE_SSL
 WiFiClientSecure wifiClient;
@@ -112,25 +143,22 @@ WiFiClientSecure wifiClient;
 WiFiClient wifiClient;
 #endif
 
-// Increase MQTT internal buffer size
-#define MQTT_BUF_SIZE   300
+// Increase MQTT internal buffer size for FORWARD_BATCH history records
+#define MQTT_BUF_SIZE   1024
 
 // MQTT client
 MQTTClient mqtt(MQTT_BUF_SIZE);
 
 volatile bool ha_online = false;
 
-typedef struct {
-    long   tlastupdate;
-    String temperature;
-    String battery;
-} OregonTHN128Device_t;
+// Last reading per sensor
+OregonTHN128Registry_t registry;
 
-OregonTHN128Device_t devices[3] = {
-    { .tlastupdate = 0, .temperature = "unknown", .battery = "unknown" },
-    { .tlastupdate = 0, .temperature = "unknown", .battery = "unknown" },
-    { .tlastupdate = 0, .temperature = "unknown", .battery = "unknown" }
-};
+// Readings received while disconnected
+const esp_partition_t *forwardPartition = NULL;
+OregonTHN128Storage_t forwardStorage;
+OregonTHN128Forward_t forward;
+bool forwardReady = false;
 
 #ifdef USE_SSL
 // Root CA certificate
@@ -156,10 +184,10 @@ YOUR CLIENT KEY
 #endif
 
 
-void mqttPublish(String topic, String payload, bool retain=false, int qos=0)
+bool mqttPublish(String topic, String payload, bool retain=false, int qos=0)
 {
     Serial.println("MQTT publish: topic=" + topic + ", retain=" + retain + ", qos=" + qos + ", payload=" + payload);
-    mqtt.publish(topic, payload, retain, qos);
+    return mqtt.publish(topic, payload, retain, qos);
 }
 
 void mqttPublishDeviceChannelConfig(int channel)
@@ -215,19 +243,45 @@ void mqttPublishHaConfig()
     }
 }
 
+OregonTHN128Sensor_t *findChannel(int channel)
+{
+    OregonTHN128Sensor_t *sensor;
+    OregonTHN128Sensor_t *found = NULL;
+
+    // Most recently received sensor on the channel which is not stale
+    for (uint8_t i = 0; i < OREGON_THN128_REGISTRY_SIZE; i++) {
+        sensor = OregonTHN128_RegistryGet(&registry, i);
+        if (sensor && (sensor->channel == channel) && !sensor->stale &&
+            ((found == NULL) || ((long)(sensor->tLastSeen - found->tLastSeen) > 0))) {
+            found = sensor;
+        }
+    }
+
+    return found;
+}
+
 void mqttPublishStates()
 {
     // Convert the value to a char array
     String topic;
     String payload;
+    OregonTHN128Sensor_t *sensor;
+    char temperatureStr[10];
 
     StaticJsonDocument<128> doc;
-    doc["t1"] = devices[0].temperature;
-    doc["t2"] = devices[1].temperature;
-    doc["t3"] = devices[2].temperature;
-    doc["b1"] = devices[0].battery;
-    doc["b2"] = devices[1].battery;
-    doc["b3"] = devices[2].battery;
+    for (int channel = 1; channel <= 3; channel++) {
+        sensor = findChannel(channel);
+        if (sensor) {
+            // JSON number without float conversion, null for an invalid temperature
+            OregonTHN128_TempAppendJson(temperatureStr, sizeof(temperatureStr), sensor->temperature);
+            doc["t" + String(channel)] = (temperatureStr[0] == 'n') ? String("unknown") : String(temperatureStr);
+            doc["b" + String(channel)] = sensor->lowBattery ? 0 : 100;
+        } else {
+            // Not received within RX_CH_TIMETOUT_MS
+            doc["t" + String(channel)] = "unknown";
+            doc["b" + String(channel)] = "unknown";
+        }
+    }
     serializeJson(doc, payload);
 
     // Publish
@@ -235,6 +289,133 @@ void mqttPublishStates()
     mqttPublish(topic, payload);
 }
 
+void mqttPublishRxStats()
+{
+    OregonTHN128RxStats_t stats;
+    String payload;
+
+    // Receive statistics to tune antenna placement
+    OregonTHN128_GetRxStats(&stats);
+
+    StaticJsonDocument<256> doc;
+    doc["edges"]               = stats.edges;
+    doc["glitches"]            = stats.glitches;
+    doc["syncs"]               = stats.syncs;
+    doc["pulse_out_of_range"]  = stats.pulseOutOfRange;
+    doc["pulse_wrong_state"]   = stats.pulseWrongState;
+    doc["space_out_of_range"]  = stats.spaceOutOfRange;
+    doc["space_wrong_state"]   = stats.spaceWrongState;
+    doc["crc_errors"]          = stats.crcErrors;
+    doc["frames"]              = stats.frames;
+    doc["recovered"]           = stats.recovered;
+    doc["soft_recovered"]      = stats.softRecovered;
+    doc["overruns"]            = stats.overruns;
+    serializeJson(doc, payload);
+
+    // Publish
+    mqttPublish(String("oregon_thn128/rx_stats"), payload);
+}
+
+bool forwardRead(void *ctx, uint32_t addr, void *buf, size_t len)
+{
+    return esp_partition_read((const esp_partition_t *)ctx, addr, buf, len) == ESP_OK;
+}
+
+bool forwardWrite(void *ctx, uint32_t addr, const void *buf, size_t len)
+{
+    return esp_partition_write((const esp_partition_t *)ctx, addr, buf, len) == ESP_OK;
+}
+
+bool forwardErase(void *ctx, uint32_t addr)
+{
+    return esp_partition_erase_range((const esp_partition_t *)ctx, addr, SPI_FLASH_SEC_SIZE) == ESP_OK;
+}
+
+bool forwardIsUnused(const esp_partition_t *partition)
+{
+    uint32_t magic;
+
+    // Every sector must be erased or start with a store-and-forward header
+    for (uint32_t addr = 0; addr < partition->size; addr += SPI_FLASH_SEC_SIZE) {
+        if (esp_partition_read(partition, addr, &magic, sizeof(magic)) != ESP_OK) {
+            return false;
+        }
+        if ((magic != 0xffffffffUL) && (magic != OREGON_THN128_FORWARD_MAGIC)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void forwardBegin()
+{
+    // Dedicated partition from partitions.csv, never a file system partition
+    forwardPartition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, FORWARD_SUBTYPE,
+                                                FORWARD_PARTITION);
+    if (forwardPartition == NULL) {
+        Serial.println(F("Store-and-forward: partition " FORWARD_PARTITION " not found, "
+                         "upload with partitions.csv of this sketch"));
+        return;
+    }
+    if (!forwardIsUnused(forwardPartition)) {
+        Serial.println(F("Store-and-forward: partition " FORWARD_PARTITION " contains other data, "
+                         "disabled"));
+        forwardPartition = NULL;
+        return;
+    }
+
+    // Raw flash access
+    forwardStorage.sectorSize = SPI_FLASH_SEC_SIZE;
+    forwardStorage.numSectors = min((uint32_t)(forwardPartition->size / SPI_FLASH_SEC_SIZE),
+                                    (uint32_t)0xfffe);
+    forwardStorage.read = forwardRead;
+    forwardStorage.write = forwardWrite;
+    forwardStorage.erase = forwardErase;
+    forwardStorage.ctx = (void *)forwardPartition;
+
+    forwardReady = OregonTHN128_ForwardBegin(&forward, &forwardStorage);
+    Serial.print(F("Store-and-forward: pending "));
+    Serial.println(OregonTHN128_ForwardPending(&forward));
+}
+
+void forwardDrain()
+{
+    OregonTHN128ForwardRecord_t records[FORWARD_BATCH];
+    OregonTHN128Data_t data;
+    char temperatureStr[10];
+    String payload;
+    size_t n;
+
+    if (!forwardReady || (OregonTHN128_ForwardPending(&forward) == 0)) {
+        return;
+    }
+
+    n = OregonTHN128_ForwardPeek(&forward, records, FORWARD_BATCH);
+
+    StaticJsonDocument<1024> doc;
+    for (size_t i = 0; i < n; i++) {
+        OregonTHN128_RawToData(records[i].rawData, &data);
+        OregonTHN128_TempAppendJson(temperatureStr, sizeof(temperatureStr), data.temperature);
+
+        JsonObject record = doc.createNestedObject();
+        record["time"]            = records[i].timestamp;
+        record["rolling_address"] = data.rollingAddress;
+        record["channel"]         = data.channel;
+        record["temperature"]     = serialized(String(temperatureStr));
+        record["low_battery"]     = data.lowBattery;
+    }
+    serializeJson(doc, payload);
+
+    // Consume the records after the broker acknowledged the batch
+    if (mqttPublish(String("oregon_thn128/history"), payload, false, 1)) {
+        OregonTHN128_ForwardConsume(&forward, n);
+        if (OregonTHN128_ForwardPending(&forward) == 0) {
+            mqttPublishStates();
+        }
+    }
+}
+
 void mqttReceive(String &topic, String &payload) 
 {
     digitalWrite(LED_PIN, HIGH);
@@ -249,48 +430,69 @@ void mqttReceive(String &topic, String &payload)
     digitalWrite(LED_PIN, LOW);
 }
 
-void mqttConnect() 
+bool mqttConnect() 
 {
-    // Loop until we're reconnected
-    while (!mqtt.connected()) {
-        Serial.print("Connecting to MQTT broker ");
-        Serial.print(MQTT_HOST);
-        Serial.print(":");
-        Serial.print(MQTT_PORT);
-        Serial.print("...");
+    static unsigned long tConnect = 0;
+    static bool first = true;
+
+    if (mqtt.connected()) {
+        return true;
+    }
+
+    // Try to reconnect every 5 seconds without blocking the receiver
+    if (!first && ((millis() - tConnect) < MQTT_RECONNECT_MS)) {
+        return false;
+    }
+    first = false;
+    tConnect = millis();
+
+    Serial.print("Connecting to MQTT broker ");
+    Serial.print(MQTT_HOST);
+    Serial.print(":");
+    Serial.print(MQTT_PORT);
+    Serial.print("...");
 
 #if defined(MQTT_USERNAME) && defined(MQTT_PASSWORD)
-        if (mqtt.connect(MQTT_DEVICE_ID, MQTT_USERNAME, MQTT_PASSWORD)) {
+    if (mqtt.connect(MQTT_DEVICE_ID, MQTT_USERNAME, MQTT_PASSWORD)) {
 #else
-        if (mqtt.connect(MQTT_DEVICE_ID)) {
+    if (mqtt.connect(MQTT_DEVICE_ID)) {
 #endif
-            Serial.println("Connected");
-            mqtt.subscribe("homeassistant/status");
-            mqttPublishHaConfig();
-        } else {
-            Serial.println("Failed try again in 5 seconds");
-            // Wait 5 seconds before retrying
-            delay(5000);
-        }
+        Serial.println("Connected");
+        mqtt.subscribe("homeassistant/status");
+        mqttPublishHaConfig();
+        return true;
     }
+
+    Serial.println("Failed try again in 5 seconds");
+    return false;
 }
 
-void wifiConnect()
+bool wifiConnect()
 {
-    Serial.print("Connecting to WiFi ");
-    Serial.print(WIFI_SSID);
-    Serial.print("...");
-
-    // Optional: Configure static network configuration with DHCP off
-//    if (!WiFi.config(staticIP, gateway, subnet, dns1, dns2)) {
-//        Serial.println("Configuration failed.");
-//    }
+    static bool started = false;
+    static bool connected = false;
 
-    // Connect to WiFi network
-    WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
-    while (WiFi.status() != WL_CONNECTED) {
-        delay(500);
+    if (WiFi.status() != WL_CONNECTED) {
+        connected = false;
+        if (!started) {
+            Serial.print("Connecting to WiFi ");
+            Serial.println(WIFI_SSID);
+
+            // Optional: Configure static network configuration with DHCP off
+//            if (!WiFi.config(staticIP, gateway, subnet, dns1, dns2)) {
+//                Serial.println("Configuration failed.");
+//            }
+
+            // Connect to WiFi network, reconnects automatically
+            WiFi.begin(WIFI_SSID, WIFI_PASSWORD);
+            started = true;
+        }
+        return false;
     }
+    if (connected) {
+        return true;
+    }
+    connected = true;
 
     // Optional: Update network configuration after WiFi connection
 //    if (!WiFi.config(WiFi.localIP(), WiFi.gatewayIP(), WiFi.subnetMask(), dns1, dns2)) {
@@ -316,6 +518,11 @@ void wifiConnect()
     wifiClient.setCertificate(client_cert);
     wifiClient.setPrivateKey(client_key);
 #endif
+
+    // Timestamps of stored readings
+    configTime(0, 0, NTP_SERVER);
+
+    return true;
 }
 
 void setup()
@@ -327,9 +534,18 @@ void setup()
     mqtt.begin(MQTT_HOST, MQTT_PORT, wifiClient);
     mqtt.onMessage(mqttReceive);
 
+    // Initialize sensor registry
+    OregonTHN128_RegistryInit(&registry, RX_CH_TIMETOUT_MS);
+
     // Initialize receiver
     OregonTHN128_RxBegin(RF_RX_PIN);
 
+    // Publish the repeated frame of each transmission only once
+    OregonTHN128_RxSetDedup(OREGON_THN128_DEDUP_WINDOW_MS);
+
+    // Initialize store-and-forward buffer
+    forwardBegin();
+
     // Initialize LED
     pinMode(LED_PIN, OUTPUT);
 }
@@ -338,26 +554,42 @@ void loop()
 {
     static unsigned long rxCount = 0;
     OregonTHN128Data_t data;
-    float temperature;
+    OregonTHN128Sensor_t *sensor;
+    char temperatureStr[10];
     char msg[80];
+    bool online;
 
-    // Connect to WiFi on disconnect
-    if (WiFi.status() != WL_CONNECTED) {
-        wifiConnect();
-    }
+    // Reconnect WiFi and MQTT on disconnect without blocking
+    online = wifiConnect() && mqttConnect();
+
+    if (online) {
+        // Process MQTT messages
+        mqtt.loop();
+
+        // Process Homeassistant online message
+        if (ha_online) {
+            mqttPublishHaConfig();
+            ha_online = false;
+        }
 
-    // Reconnect MQTT on disconnect
-    if (!mqtt.connected()) {
-        mqttConnect();
+        // Publish readings stored while disconnected
+        forwardDrain();
     }
 
-    // Process MQTT messages
-    mqtt.loop();
+    // Reset temperature when connection lost, one sensor per second
+    static unsigned long tRegistryTick = 0;
+    if ((millis() - tRegistryTick) >= 1000) {
+        tRegistryTick = millis();
+        if (OregonTHN128_RegistryTick(&registry, millis()) && online) {
+            mqttPublishStates();
+        }
+    }
 
-    // Process Homeassistant online message
-    if (ha_online) {
-        mqttPublishHaConfig();
-        ha_online = false;
+    // Publish receive statistics periodically
+    static unsigned long tRxStats = 0;
+    if (online && ((millis() - tRxStats) >= RX_STATS_INTERVAL_MS)) {
+        tRxStats = millis();
+        mqttPublishRxStats();
     }
 
     // Check temperature received
@@ -369,32 +601,33 @@ void loop()
         OregonTHN128_Read(&data);
     
         // Print received data
-        temperature = (float)data.temperature / 10.0;
+        OregonTHN128_TempToString(temperatureStr, sizeof(temperatureStr), data.temperature);
         snprintf_P(msg, sizeof(msg),
-                   PSTR("RX %lu: Rol: %d, Channel %d, Temp: %.1f, Low batt: %d (0x%08lx)"),
+                   PSTR("RX %lu: Rol: %d, Channel %d, Temp: %s, Low batt: %d (0x%08lx)"),
                    rxCount++,
                    data.rollingAddress, data.channel,
-                   temperature, data.lowBattery,
+                   temperatureStr, data.lowBattery,
                    (unsigned long)data.rawData);
         Serial.println(msg);
 
-        devices[data.channel-1].tlastupdate = millis();
-        devices[data.channel-1].temperature =  temperature <= -127 ? "unknown" : String(temperature, 1);
-        devices[data.channel-1].battery = data.lowBattery ? 0 : 100;
-
-        // Reset temperature when connection lost
-        for (int channel = 0; channel < 3; channel++) {
-            if ((millis() - devices[channel].tlastupdate) > RX_CH_TIMETOUT_MS) {
-                devices[channel].temperature = "unknown";
-                devices[channel].battery = "unknown";
-            }
+        // Update sensor registry
+        if (OregonTHN128_RegistryUpdate(&registry, &data, millis(), &sensor) ==
+            OregonTHN128SensorAddressChanged) {
+            snprintf_P(msg, sizeof(msg), PSTR("Channel %d: rolling address changed from %d to %d"),
+                       sensor->channel, sensor->previousRollingAddress, sensor->rollingAddress);
+            Serial.println(msg);
         }
 
-        // Publish temperatures
-        mqttPublishStates();
-
-        // Enable receive
-        OregonTHN128_RxEnable();
+        if (online && (!forwardReady || (OregonTHN128_ForwardPending(&forward) == 0))) {
+            // Publish temperatures
+            mqttPublishStates();
+        } else if (forwardReady) {
+            // Store in order after the pending readings, published by forwardDrain()
+            OregonTHN128_ForwardAppend(&forward, (uint32_t)time(NULL), data.rawData);
+            snprintf_P(msg, sizeof(msg), PSTR("Stored, pending: %lu"),
+                       (unsigned long)OregonTHN128_ForwardPending(&forward));
+            Serial.println(msg);
+        }
 
         digitalWrite(LED_PIN, LOW);
     }
@@ -0,0 +1,165 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \brief Measure CPU cycles of the Oregon THN128 codec functions on the target
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *  The division based temperature codec of library v1.1.1 is measured as reference.
+ *  Results are average CPU cycles per call, including the loop overhead.
+ *
+ *  Temperature formatting:
+ *  - Define BENCHMARK_SNPRINTF to also measure the snprintf() TempToString() of library v1.1.1.
+ *  - Flash: the difference of "Sketch uses ... bytes" of the build with and without
+ *    BENCHMARK_SNPRINTF is the vfprintf code which the formatter of this library does not need.
+ *    The sketch prints results without printf for this reason.
+ */
+
+#include <Arduino.h>
+#include <ErriezOregonTHN128.h>         // https://github.com/Erriez/ErriezOregonTHN128
+
+// Number of calls per measurement
+#define NUM_CALLS           1000
+
+// Measure the snprintf() reference formatter, increases flash
+// #define BENCHMARK_SNPRINTF
+
+// Reference codec v1.1.1
+#define REF_SET_TEMP(x)     ((((((uint32_t)(x) / 100) % 10)) << 16) | \
+                            ((((uint32_t)(x) / 10) % 10) << 12) | \
+                            (((x) % 10) << 8))
+#define REF_GET_TEMP(x)     (((((x) >> 16) & 0x0f) * 100) + \
+                            ((((x) >> 12) & 0x0f) * 10) + \
+                            (((x) >> 8) & 0x0f))
+
+// Prevent the compiler from removing benchmarked calls
+volatile uint32_t sink;
+volatile int16_t temperatureIn = 273;
+volatile uint32_t rawDataIn = 0x3d020758;
+
+
+#ifdef BENCHMARK_SNPRINTF
+// Reference TempToString() v1.1.1
+void refTempToString(char *temperatureStr, uint8_t temperatureStrLen, int16_t temperature)
+{
+    int tempAbs = (temperature < 0) ? -temperature : temperature;
+
+    snprintf(temperatureStr, temperatureStrLen, "%s%d.%d",
+             (temperature < 0) ? "-" : "", (tempAbs / 10), tempAbs % 10);
+}
+#endif
+
+void printResult(const __FlashStringHelper *name, unsigned long tStart, unsigned long tEnd)
+{
+    Serial.print(name);
+    Serial.print(((tEnd - tStart) * clockCyclesPerMicrosecond()) / NUM_CALLS);
+    Serial.println(F(" cycles"));
+}
+
+void benchmark()
+{
+    OregonTHN128Data_t data = {
+        .rawData = 0,
+        .rollingAddress = 5,
+        .channel = 1,
+        .temperature = temperatureIn,
+        .lowBattery = false,
+    };
+    unsigned long tStart;
+    char temperatureStr[10];
+
+    tStart = micros();
+    for (uint16_t i = 0; i < NUM_CALLS; i++) {
+        sink = OregonTHN128_CheckCRC(rawDataIn);
+    }
+    printResult(F("OregonTHN128_CheckCRC:      "), tStart, micros());
+
+    tStart = micros();
+    for (uint16_t i = 0; i < NUM_CALLS; i++) {
+        sink = OregonTHN128_DataToRaw(&data);
+    }
+    printResult(F("OregonTHN128_DataToRaw:     "), tStart, micros());
+
+    tStart = micros();
+    for (uint16_t i = 0; i < NUM_CALLS; i++) {
+        OregonTHN128_RawToData(rawDataIn, &data);
+        sink = data.temperature;
+    }
+    printResult(F("OregonTHN128_RawToData:     "), tStart, micros());
+
+    tStart = micros();
+    for (uint16_t i = 0; i < NUM_CALLS; i++) {
+        OregonTHN128_TempToString(temperatureStr, sizeof(temperatureStr), temperatureIn);
+        sink = temperatureStr[0];
+    }
+    printResult(F("OregonTHN128_TempToString:  "), tStart, micros());
+
+    tStart = micros();
+    for (uint16_t i = 0; i < NUM_CALLS; i++) {
+        sink = OregonTHN128_TempAppend(temperatureStr, sizeof(temperatureStr), temperatureIn);
+    }
+    printResult(F("OregonTHN128_TempAppend:    "), tStart, micros());
+
+    tStart = micros();
+    for (uint16_t i = 0; i < NUM_CALLS; i++) {
+        sink = OregonTHN128_TempAppendJson(temperatureStr, sizeof(temperatureStr), temperatureIn);
+    }
+    printResult(F("OregonTHN128_TempAppendJson:"), tStart, micros());
+
+#ifdef BENCHMARK_SNPRINTF
+    tStart = micros();
+    for (uint16_t i = 0; i < NUM_CALLS; i++) {
+        refTempToString(temperatureStr, sizeof(temperatureStr), temperatureIn);
+        sink = temperatureStr[0];
+    }
+    printResult(F("Reference TempToString:     "), tStart, micros());
+#endif
+
+    tStart = micros();
+    for (uint16_t i = 0; i < NUM_CALLS; i++) {
+        sink = REF_SET_TEMP(temperatureIn);
+    }
+    printResult(F("Reference SET_TEMP:         "), tStart, micros());
+
+    tStart = micros();
+    for (uint16_t i = 0; i < NUM_CALLS; i++) {
+        sink = REF_GET_TEMP(rawDataIn);
+    }
+    printResult(F("Reference GET_TEMP:         "), tStart, micros());
+}
+
+void setup()
+{
+    // Initialize serial port
+    Serial.begin(115200);
+    Serial.println(F("\nErriez Oregon THN128 codec benchmark"));
+
+    benchmark();
+}
+
+void loop()
+{
+}
@@ -102,8 +102,5 @@ void loop()
 
         // Turn LED off
         digitalWrite(LED_BUILTIN, LOW);
-
-        // Enable receive
-        OregonTHN128_RxEnable();
     }
 }
\ No newline at end of file
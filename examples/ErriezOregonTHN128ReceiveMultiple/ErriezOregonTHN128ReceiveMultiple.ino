@@ -0,0 +1,92 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \brief Receive with two 433MHz receivers on one microcontroller
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *  Two receivers with different antennas or placements increase the reception yield. Each
+ *  receiver has its own decoder context. Frames received by both receivers are printed twice.
+ */
+
+#include <Arduino.h>
+#include <ErriezOregonTHN128Receive.h>  // https://github.com/Erriez/ErriezOregonTHN128
+
+#if defined(ARDUINO_ARCH_AVR)
+#define RF_RX_PIN_A         2   // Arduino pin 2 (INT0)
+#define RF_RX_PIN_B         3   // Arduino pin 3 (INT1)
+#elif defined(ARDUINO_ARCH_ESP8266)
+#define RF_RX_PIN_A         14  // GPIO14 NodeMCU D5
+#define RF_RX_PIN_B         12  // GPIO12 NodeMCU D6
+#elif defined(ARDUINO_ARCH_ESP32)
+#define RF_RX_PIN_A         19  // GPIO19
+#define RF_RX_PIN_B         18  // GPIO18
+#else
+#error "May work, but not tested on this target"
+#endif
+
+// Receiver contexts
+OregonTHN128Rx_t rxA;
+OregonTHN128Rx_t rxB;
+
+
+void printReceivedData(char receiver, OregonTHN128Data_t *data)
+{
+    char temperatureStr[10];
+    char msg[80];
+
+    OregonTHN128_TempToString(temperatureStr, sizeof(temperatureStr), data->temperature);
+    snprintf_P(msg, sizeof(msg),
+               PSTR("RX %c: Rol: %d, Channel %d, Temp: %s, Low batt: %d (0x%08lx)"),
+               receiver,
+               data->rollingAddress, data->channel, temperatureStr, data->lowBattery,
+               (unsigned long)data->rawData);
+    Serial.println(msg);
+}
+
+void setup()
+{
+    // Initialize serial port
+    Serial.begin(115200);
+    Serial.println(F("\nErriez Oregon THN128 433MHz temperature receive multiple"));
+
+    // Initialize receivers
+    OregonTHN128Rx_Begin(&rxA, RF_RX_PIN_A);
+    OregonTHN128Rx_Begin(&rxB, RF_RX_PIN_B);
+}
+
+void loop()
+{
+    OregonTHN128Data_t data;
+
+    // Read all queued frames of both receivers
+    while (OregonTHN128Rx_Read(&rxA, &data)) {
+        printReceivedData('A', &data);
+    }
+    while (OregonTHN128Rx_Read(&rxB, &data)) {
+        printReceivedData('B', &data);
+    }
+}
@@ -303,7 +303,7 @@ void setup()
 void loop()
 {
     char line[10];
-    char tempStr[5];
+    uint8_t len;
     OregonTHN128Data_t data;
 
     // Check temperature received
@@ -318,20 +318,19 @@ void loop()
         printReceivedData(&data);
 
         // Display data
-        OregonTHN128_TempToString(tempStr, sizeof(tempStr), data.temperature);
         snprintf_P(line, sizeof(line), PSTR("CH %d"), data.channel);
         display.clearDisplay();
         display.setCursor(0, 20);
         display.println(line);
-        snprintf_P(line, sizeof(line), PSTR("%s`C"), tempStr);
+        len = OregonTHN128_TempAppend(line, sizeof(line) - 2, data.temperature);
+        line[len++] = '`';
+        line[len++] = 'C';
+        line[len] = '\0';
         display.setCursor(0, 50);
         display.println(line);
         display.display();
 
         // Turn LED off
         digitalWrite(LED_BUILTIN, LOW);
-
-        // Enable receive
-        OregonTHN128_RxEnable();
     }
 }
\ No newline at end of file
@@ -0,0 +1,134 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \brief Transmit random temperature in the background
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *  The frame and its repeat are transmitted by a timer interrupt, while the sketch blinks the
+ *  LED. AVR uses Timer1, which cannot be shared with libraries like Servo.
+ */
+
+#include <Arduino.h>
+#include <ErriezOregonTHN128Transmit.h> // https://github.com/Erriez/ErriezOregonTHN128
+
+#if defined(ARDUINO_ARCH_AVR)
+#define RF_TX_PIN           3   // Any DIGITAL pin
+#elif defined(ARDUINO_ARCH_ESP8266)
+#define RF_TX_PIN           4   // NodeMCU D2
+#elif defined(ARDUINO_ARCH_ESP32)
+#define RF_TX_PIN           22
+#else
+#error "May work, but not tested on this target"
+#endif
+
+OregonTHN128Data_t data = {
+    .rawData = 0,           // Raw data filled in by driver
+    .rollingAddress = 5,    // Rolling address 0..7
+    .channel = 1,           // Channel 1, 2 or 3
+    .temperature = 0,       // Temperature -99.9 .. 99.9 multiplied by 10
+    .lowBattery = false,
+};
+
+// Set by the transmit complete callback
+volatile bool txDone = false;
+
+
+static void txComplete(void *arg)
+{
+    (void)arg;
+
+    // Called from the timer interrupt: only set a flag
+    txDone = true;
+}
+
+static void printData()
+{
+    static unsigned long txCount = 0;
+    char temperatureStr[10];
+    char msg[80];
+
+    OregonTHN128_TempToString(temperatureStr, sizeof(temperatureStr), data.temperature);
+    snprintf_P(msg, sizeof(msg),
+               PSTR("TX %lu: Rol: %d, Channel %d, Temp: %s, Low batt: %d (0x%08lX)"),
+               txCount++,
+               data.rollingAddress, data.channel, temperatureStr, data.lowBattery, (unsigned long)data.rawData);
+    Serial.println(msg);
+}
+
+void setup()
+{
+    // Initialize serial
+    Serial.begin(115200);
+    Serial.println(F("\nErriez Oregon THN128 433MHz temperature transmit in the background"));
+
+    // Initialize built-in LED
+    pinMode(LED_BUILTIN, OUTPUT);
+    digitalWrite(LED_BUILTIN, LOW);
+
+    // Initialize random
+    randomSeed(analogRead(0));
+
+    // Initialize pins
+    OregonTHN128_TxBegin(RF_TX_PIN);
+}
+
+void loop()
+{
+    unsigned long tStart;
+    unsigned long blinks = 0;
+
+    // Set random temperature
+    data.temperature = (int16_t)random(-130, 400);
+
+    // Start transmitting the temperature twice with 100ms space between the frames
+    txDone = false;
+    tStart = millis();
+    if (!OregonTHN128_TransmitAsync(&data, txComplete, NULL)) {
+        Serial.println(F("Transmit busy"));
+        return;
+    }
+
+    // Print diagnostics during the transmission
+    printData();
+
+    // The CPU is available while transmitting
+    while (OregonTHN128_TxBusy()) {
+        digitalWrite(LED_BUILTIN, (millis() / 50) & 1);
+        blinks++;
+    }
+    digitalWrite(LED_BUILTIN, LOW);
+
+    Serial.print(F("Transmitted in "));
+    Serial.print(millis() - tStart);
+    Serial.print(F(" ms, loop iterations: "));
+    Serial.print(blinks);
+    Serial.print(F(", callback: "));
+    Serial.println(txDone ? F("yes") : F("no"));
+
+    // Wait ~30 seconds before sending next temperature
+    delay(30 * 1000);
+}
@@ -0,0 +1,351 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*!
+ * \file ErriezOregonTHN128BatchX86.c
+ * \brief Oregon THN128 SSE2 and AVX2 batch kernels for x86 hosts
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      The kernels process the frames in 32-bit lanes with the bit layout of
+ *      ErriezOregonTHN128.c. They are compiled with target attributes and selected at run time
+ *      with __builtin_cpu_supports(), so no -mavx2 is needed. Linking this file replaces the
+ *      weak OregonTHN128_BatchKernelSimd() of ErriezOregonTHN128Batch.c, without it the batch
+ *      functions use the scalar codec functions. Define OREGON_THN128_BATCH_NO_SIMD to use the
+ *      scalar path only.
+ *
+ *      Host only, like the SIMD kernels of ErriezOregonTHN128Demod.c: the Arduino build
+ *      compiles every file in src for every target.
+ *
+ *      Build on a Linux host from the repository root, together with the library files:
+ *
+ *      gcc -O2 -Isrc src/ErriezOregonTHN128.c src/ErriezOregonTHN128Batch.c \
+ *          extras/host/ErriezOregonTHN128BatchX86.c <application.c> -o <application>
+ */
+
+#include <stdbool.h>
+#include "ErriezOregonTHN128Batch.h"
+
+#if !defined(OREGON_THN128_BATCH_NO_SIMD) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+
+/*! Frames per AVX2 kernel iteration */
+#define AVX2_FRAMES             16
+
+/*! Frames per SSE2 kernel iteration */
+#define SSE2_FRAMES             8
+
+/*!
+ * \brief CPU supports AVX2
+ */
+static bool avx2Supported(void)
+{
+    __builtin_cpu_init();
+
+    return __builtin_cpu_supports("avx2");
+}
+
+/*!
+ * \brief Checksum of 8 frames
+ * \return
+ *      Lanes 0xffffffff: Success, 0: error
+ */
+__attribute__((target("avx2")))
+static inline __m256i crcOkAvx2(__m256i raw)
+{
+    const __m256i byteMask = _mm256_set1_epi32(0xff);
+    __m256i crc;
+
+    /* Add Bytes 0, 1 and 2, then add the most significant Byte of the sum */
+    crc = _mm256_add_epi32(_mm256_and_si256(raw, byteMask),
+                           _mm256_and_si256(_mm256_srli_epi32(raw, 8), byteMask));
+    crc = _mm256_add_epi32(crc, _mm256_and_si256(_mm256_srli_epi32(raw, 16), byteMask));
+    crc = _mm256_add_epi32(_mm256_srli_epi32(crc, 8), _mm256_and_si256(crc, byteMask));
+
+    return _mm256_cmpeq_epi32(_mm256_and_si256(crc, byteMask), _mm256_srli_epi32(raw, 24));
+}
+
+/*!
+ * \brief Signed temperature of 8 frames
+ */
+__attribute__((target("avx2")))
+static inline __m256i tempAvx2(__m256i raw)
+{
+    const __m256i digitMask = _mm256_set1_epi32(0x0f);
+    __m256i temp;
+    __m256i sign;
+
+    /* ((TH1 * 10) + TH2) * 10 + TH3, multiply by 10 with shift/add */
+    temp = _mm256_and_si256(_mm256_srli_epi32(raw, 16), digitMask);
+    temp = _mm256_add_epi32(_mm256_add_epi32(_mm256_slli_epi32(temp, 3), _mm256_slli_epi32(temp, 1)),
+                            _mm256_and_si256(_mm256_srli_epi32(raw, 12), digitMask));
+    temp = _mm256_add_epi32(_mm256_add_epi32(_mm256_slli_epi32(temp, 3), _mm256_slli_epi32(temp, 1)),
+                            _mm256_and_si256(_mm256_srli_epi32(raw, 8), digitMask));
+
+    /* Negate with the sign bit 21: (temp ^ -1) + 1 */
+    sign = _mm256_sub_epi32(_mm256_setzero_si256(),
+                            _mm256_and_si256(_mm256_srli_epi32(raw, 21), _mm256_set1_epi32(1)));
+
+    return _mm256_sub_epi32(_mm256_xor_si256(temp, sign), sign);
+}
+
+/*!
+ * \brief Pack 2 x 8 lanes with values -32768..32767 to 16 words in frame order
+ */
+__attribute__((target("avx2")))
+static inline __m256i packWordsAvx2(__m256i lo, __m256i hi)
+{
+    /* Pack works per 128-bit half, restore the frame order of the 64-bit blocks */
+    return _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+/*!
+ * \brief Pack 2 x 8 lanes with values -128..127 to 16 bytes in frame order
+ */
+__attribute__((target("avx2")))
+static inline __m128i packBytesAvx2(__m256i lo, __m256i hi)
+{
+    __m256i words = packWordsAvx2(lo, hi);
+
+    return _mm_packs_epi16(_mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1));
+}
+
+/*!
+ * \brief Check CRC of complete blocks of 16 frames
+ * \return
+ *      Number of frames processed
+ */
+__attribute__((target("avx2")))
+static size_t avx2CrcBatch(const uint32_t *rawData, size_t n, uint8_t *okMask, size_t *numOk)
+{
+    const __m128i one = _mm_set1_epi8(1);
+    size_t i;
+
+    for (i = 0; (i + AVX2_FRAMES) <= n; i += AVX2_FRAMES) {
+        __m256i raw0 = _mm256_loadu_si256((const __m256i *)&rawData[i]);
+        __m256i raw1 = _mm256_loadu_si256((const __m256i *)&rawData[i + 8]);
+        __m128i ok = packBytesAvx2(crcOkAvx2(raw0), crcOkAvx2(raw1));
+
+        _mm_storeu_si128((__m128i *)&okMask[i], _mm_and_si128(ok, one));
+        *numOk += __builtin_popcount(_mm_movemask_epi8(ok));
+    }
+
+    return i;
+}
+
+/*!
+ * \brief Decode complete blocks of 16 frames
+ * \return
+ *      Number of frames processed
+ */
+__attribute__((target("avx2")))
+static size_t avx2DecodeBatch(const uint32_t *rawData, size_t n, OregonTHN128Columns_t *columns,
+                              size_t *numOk)
+{
+    const __m128i one = _mm_set1_epi8(1);
+    const __m256i rolMask = _mm256_set1_epi32(0x07);
+    const __m256i channelMask = _mm256_set1_epi32(0x03);
+    const __m256i lowBatMask = _mm256_set1_epi32(0x01);
+    const __m256i channelOffset = _mm256_set1_epi32(1);
+    size_t i;
+
+    for (i = 0; (i + AVX2_FRAMES) <= n; i += AVX2_FRAMES) {
+        __m256i raw0 = _mm256_loadu_si256((const __m256i *)&rawData[i]);
+        __m256i raw1 = _mm256_loadu_si256((const __m256i *)&rawData[i + 8]);
+        __m128i ok = packBytesAvx2(crcOkAvx2(raw0), crcOkAvx2(raw1));
+
+        _mm_storeu_si128((__m128i *)&columns->rollingAddress[i],
+                         packBytesAvx2(_mm256_and_si256(raw0, rolMask),
+                                       _mm256_and_si256(raw1, rolMask)));
+        _mm_storeu_si128((__m128i *)&columns->channel[i],
+                         packBytesAvx2(_mm256_add_epi32(_mm256_and_si256(_mm256_srli_epi32(raw0, 6),
+                                                                         channelMask), channelOffset),
+                                       _mm256_add_epi32(_mm256_and_si256(_mm256_srli_epi32(raw1, 6),
+                                                                         channelMask), channelOffset)));
+        _mm256_storeu_si256((__m256i *)&columns->temperature[i],
+                            packWordsAvx2(tempAvx2(raw0), tempAvx2(raw1)));
+        _mm_storeu_si128((__m128i *)&columns->lowBattery[i],
+                         packBytesAvx2(_mm256_and_si256(_mm256_srli_epi32(raw0, 23), lowBatMask),
+                                       _mm256_and_si256(_mm256_srli_epi32(raw1, 23), lowBatMask)));
+        _mm_storeu_si128((__m128i *)&columns->crcOk[i], _mm_and_si128(ok, one));
+        *numOk += __builtin_popcount(_mm_movemask_epi8(ok));
+    }
+
+    return i;
+}
+
+/*!
+ * \brief CPU supports SSE2
+ */
+static bool sse2Supported(void)
+{
+    __builtin_cpu_init();
+
+    return __builtin_cpu_supports("sse2");
+}
+
+/*!
+ * \brief Checksum of 4 frames
+ * \return
+ *      Lanes 0xffffffff: Success, 0: error
+ */
+__attribute__((target("sse2")))
+static inline __m128i crcOkSse2(__m128i raw)
+{
+    const __m128i byteMask = _mm_set1_epi32(0xff);
+    __m128i crc;
+
+    /* Add Bytes 0, 1 and 2, then add the most significant Byte of the sum */
+    crc = _mm_add_epi32(_mm_and_si128(raw, byteMask),
+                        _mm_and_si128(_mm_srli_epi32(raw, 8), byteMask));
+    crc = _mm_add_epi32(crc, _mm_and_si128(_mm_srli_epi32(raw, 16), byteMask));
+    crc = _mm_add_epi32(_mm_srli_epi32(crc, 8), _mm_and_si128(crc, byteMask));
+
+    return _mm_cmpeq_epi32(_mm_and_si128(crc, byteMask), _mm_srli_epi32(raw, 24));
+}
+
+/*!
+ * \brief Signed temperature of 4 frames
+ */
+__attribute__((target("sse2")))
+static inline __m128i tempSse2(__m128i raw)
+{
+    const __m128i digitMask = _mm_set1_epi32(0x0f);
+    __m128i temp;
+    __m128i sign;
+
+    /* ((TH1 * 10) + TH2) * 10 + TH3, multiply by 10 with shift/add */
+    temp = _mm_and_si128(_mm_srli_epi32(raw, 16), digitMask);
+    temp = _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(temp, 3), _mm_slli_epi32(temp, 1)),
+                         _mm_and_si128(_mm_srli_epi32(raw, 12), digitMask));
+    temp = _mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(temp, 3), _mm_slli_epi32(temp, 1)),
+                         _mm_and_si128(_mm_srli_epi32(raw, 8), digitMask));
+
+    /* Negate with the sign bit 21: (temp ^ -1) + 1 */
+    sign = _mm_sub_epi32(_mm_setzero_si128(),
+                         _mm_and_si128(_mm_srli_epi32(raw, 21), _mm_set1_epi32(1)));
+
+    return _mm_sub_epi32(_mm_xor_si128(temp, sign), sign);
+}
+
+/*!
+ * \brief Pack 2 x 4 lanes with values -128..127 to 8 bytes in the lower half
+ */
+__attribute__((target("sse2")))
+static inline __m128i packBytesSse2(__m128i lo, __m128i hi)
+{
+    __m128i words = _mm_packs_epi32(lo, hi);
+
+    return _mm_packs_epi16(words, words);
+}
+
+/*!
+ * \brief Check CRC of complete blocks of 8 frames
+ * \return
+ *      Number of frames processed
+ */
+__attribute__((target("sse2")))
+static size_t sse2CrcBatch(const uint32_t *rawData, size_t n, uint8_t *okMask, size_t *numOk)
+{
+    const __m128i one = _mm_set1_epi8(1);
+    size_t i;
+
+    for (i = 0; (i + SSE2_FRAMES) <= n; i += SSE2_FRAMES) {
+        __m128i raw0 = _mm_loadu_si128((const __m128i *)&rawData[i]);
+        __m128i raw1 = _mm_loadu_si128((const __m128i *)&rawData[i + 4]);
+        __m128i ok = packBytesSse2(crcOkSse2(raw0), crcOkSse2(raw1));
+
+        _mm_storel_epi64((__m128i *)&okMask[i], _mm_and_si128(ok, one));
+        *numOk += __builtin_popcount(_mm_movemask_epi8(ok) & 0xff);
+    }
+
+    return i;
+}
+
+/*!
+ * \brief Decode complete blocks of 8 frames
+ * \return
+ *      Number of frames processed
+ */
+__attribute__((target("sse2")))
+static size_t sse2DecodeBatch(const uint32_t *rawData, size_t n, OregonTHN128Columns_t *columns,
+                              size_t *numOk)
+{
+    const __m128i one = _mm_set1_epi8(1);
+    const __m128i rolMask = _mm_set1_epi32(0x07);
+    const __m128i channelMask = _mm_set1_epi32(0x03);
+    const __m128i lowBatMask = _mm_set1_epi32(0x01);
+    const __m128i channelOffset = _mm_set1_epi32(1);
+    size_t i;
+
+    for (i = 0; (i + SSE2_FRAMES) <= n; i += SSE2_FRAMES) {
+        __m128i raw0 = _mm_loadu_si128((const __m128i *)&rawData[i]);
+        __m128i raw1 = _mm_loadu_si128((const __m128i *)&rawData[i + 4]);
+        __m128i ok = packBytesSse2(crcOkSse2(raw0), crcOkSse2(raw1));
+
+        _mm_storel_epi64((__m128i *)&columns->rollingAddress[i],
+                         packBytesSse2(_mm_and_si128(raw0, rolMask),
+                                       _mm_and_si128(raw1, rolMask)));
+        _mm_storel_epi64((__m128i *)&columns->channel[i],
+                         packBytesSse2(_mm_add_epi32(_mm_and_si128(_mm_srli_epi32(raw0, 6),
+                                                                   channelMask), channelOffset),
+                                       _mm_add_epi32(_mm_and_si128(_mm_srli_epi32(raw1, 6),
+                                                                   channelMask), channelOffset)));
+        _mm_storeu_si128((__m128i *)&columns->temperature[i],
+                         _mm_packs_epi32(tempSse2(raw0), tempSse2(raw1)));
+        _mm_storel_epi64((__m128i *)&columns->lowBattery[i],
+                         packBytesSse2(_mm_and_si128(_mm_srli_epi32(raw0, 23), lowBatMask),
+                                       _mm_and_si128(_mm_srli_epi32(raw1, 23), lowBatMask)));
+        _mm_storel_epi64((__m128i *)&columns->crcOk[i], _mm_and_si128(ok, one));
+        *numOk += __builtin_popcount(_mm_movemask_epi8(ok) & 0xff);
+    }
+
+    return i;
+}
+
+/*! Kernels, fastest first */
+static const OregonTHN128BatchKernel_t _kernels[] = {
+    { "avx2", avx2Supported, avx2CrcBatch, avx2DecodeBatch },
+    { "sse2", sse2Supported, sse2CrcBatch, sse2DecodeBatch },
+};
+
+/*!
+ * \brief Fastest SIMD kernel supported by the CPU
+ * \return
+ *      Kernel, NULL when the CPU supports none
+ */
+const OregonTHN128BatchKernel_t *OregonTHN128_BatchKernelSimd(void)
+{
+    for (size_t i = 0; i < (sizeof(_kernels) / sizeof(_kernels[0])); i++) {
+        if (_kernels[i].supported()) {
+            return &_kernels[i];
+        }
+    }
+
+    return NULL;
+}
+#endif
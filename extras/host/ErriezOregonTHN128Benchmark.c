@@ -0,0 +1,1141 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Benchmark.c
+ * \brief Oregon THN128 host benchmark
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      Measures ns/op and instructions/op of the codec and decoder functions over realistic
+ *      (plausible sensor readings) and random inputs, and the division based temperature codec of
+ *      v1.1.1 and snprintf() temperature formatting as reference. Results are written as JSON to stdout to
+ *      track them across releases. Instructions are counted with the Linux perf_event interface
+ *      and reported as null when not permitted (see /proc/sys/kernel/perf_event_paranoid).
+ *      The batch functions are measured against the scalar functions called per frame, the
+ *      batch kernel (avx2, sse2 or scalar) is written to the JSON output. The columnar reading
+ *      store is measured against an array of structs with the element layout of a
+ *      std::vector<OregonTHN128Data_t> plus timestamp, the memory per reading of both is written
+ *      to the JSON output.
+ *
+ *      Build and run on a Linux host from the repository root:
+ *
+ *      gcc -O2 -Isrc src/ErriezOregonTHN128.c src/ErriezOregonTHN128Decoder.c \
+ *          src/ErriezOregonTHN128Batch.c src/ErriezOregonTHN128Store.c \
+ *          src/ErriezOregonTHN128Dedup.c src/ErriezOregonTHN128Profile.c \
+ *          extras/host/ErriezOregonTHN128BatchX86.c extras/host/ErriezOregonTHN128Benchmark.c \
+ *          -o benchmark
+ *      ./benchmark > benchmark.json
+ *
+ *      The batch kernel is selected at run time, "batch_kernel" in the output shows which one.
+ *
+ *      The cycles of each OregonTHN128_DecodeEdge() call are profiled with the CPU time stamp
+ *      counter (nanoseconds on other CPUs) in the same way as the receive interrupt handler with
+ *      OREGON_THN128_RX_PROFILE. The load is the share of one CPU core needed to decode the edges
+ *      in real time.
+ */
+
+#include <linux/perf_event.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+/*! Cycle counter name */
+#define CYCLE_COUNTER       "tsc"
+#else
+/*! Cycle counter name */
+#define CYCLE_COUNTER       "ns"
+#endif
+#include "ErriezOregonTHN128.h"
+#include "ErriezOregonTHN128Batch.h"
+#include "ErriezOregonTHN128Decoder.h"
+#include "ErriezOregonTHN128Dedup.h"
+#include "ErriezOregonTHN128Profile.h"
+#include "ErriezOregonTHN128Store.h"
+
+/*! Number of inputs per codec benchmark */
+#define NUM_INPUTS          4096
+
+/*! Number of different frames in the edge buffer */
+#define NUM_FRAMES          1000
+
+/*! Maximum number of edges per frame: preamble, sync, 32 data bits and space */
+#define MAX_EDGES_FRAME     (24 + 2 + 64 + 1)
+
+/*! Number of readings in the reading store */
+#define NUM_READINGS        (1UL << 22)
+
+/*! Number of indices per StoreFilter() call */
+#define NUM_INDICES         1024
+
+/*! Transmit interval of a sensor in ms */
+#define T_INTERVAL_MS       30000
+
+/*! Minimum measurement time per benchmark in seconds */
+#define T_MEASURE_MIN_S     0.2
+
+/*!
+ * \brief Edge buffer
+ */
+typedef struct {
+    uint16_t durations[NUM_FRAMES * MAX_EDGES_FRAME];   /*!< Level durations in us */
+    uint8_t levels[NUM_FRAMES * MAX_EDGES_FRAME];       /*!< Level of each duration */
+    size_t n;                                           /*!< Number of edges */
+} Edges_t;
+
+/*!
+ * \brief Benchmark inputs
+ */
+typedef struct {
+    uint32_t rawData[NUM_INPUTS];               /*!< Raw frames */
+    OregonTHN128Data_t data[NUM_INPUTS];        /*!< Data structures */
+    Edges_t edges;                              /*!< Edge buffer */
+} Inputs_t;
+
+/*!
+ * \brief Reading in an array of structs, reference of the columnar reading store
+ */
+typedef struct {
+    uint32_t timestamp;                         /*!< Timestamp */
+    OregonTHN128Data_t data;                    /*!< Decoded frame */
+} AosReading_t;
+
+/*!
+ * \brief Benchmark function, processes all inputs once
+ * \return
+ *      Number of operations
+ */
+typedef size_t (*BenchmarkFunc_t)(const Inputs_t *inputs);
+
+/*! Result sink to prevent the compiler from removing benchmarked calls */
+static volatile uint32_t _sink;
+
+/*! perf_event file descriptor counting user space instructions, -1 when not available */
+static int _perfFd = -1;
+
+/*! Print comma before next JSON result */
+static bool _jsonNext;
+
+/*! Batch output buffers */
+static uint8_t _rollingAddress[NUM_INPUTS];
+static uint8_t _channel[NUM_INPUTS];
+static int16_t _temperature[NUM_INPUTS];
+static uint8_t _lowBattery[NUM_INPUTS];
+static uint8_t _crcOk[NUM_INPUTS];
+
+/*! Batch output columns */
+static OregonTHN128Columns_t _columns = {
+    _rollingAddress, _channel, _temperature, _lowBattery, _crcOk
+};
+
+/*! Reading store arrays */
+static uint32_t _storeTimestamp[NUM_READINGS];
+static uint8_t _storeSensor[NUM_READINGS];
+static int16_t _storeTemperature[NUM_READINGS];
+static uint8_t _storeFlags[NUM_READINGS];
+
+/*! Reading store */
+static OregonTHN128Store_t _store;
+
+/*! Reference array of structs with the same readings */
+static AosReading_t _aos[NUM_READINGS];
+
+/*! Filter output */
+static size_t _indices[NUM_INDICES];
+
+/*!
+ * \brief Return monotonic time in seconds
+ */
+static double timeNow(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + (ts.tv_nsec / 1e9);
+}
+
+/*!
+ * \brief Read cycle counter
+ */
+static inline uint64_t cycleCount(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + ts.tv_nsec;
+#endif
+}
+
+/*!
+ * \brief Measure cycle counter frequency
+ * \return
+ *      Counts per us
+ */
+static uint32_t cycleCountPerUs(void)
+{
+    double tStart = timeNow();
+    uint64_t cStart = cycleCount();
+    double tElapsed;
+
+    do {
+        tElapsed = timeNow() - tStart;
+    } while (tElapsed < 0.05);
+
+    return (uint32_t)(((cycleCount() - cStart) / (tElapsed * 1e6)) + 0.5);
+}
+
+/*!
+ * \brief Open instruction counter
+ */
+static void perfOpen(void)
+{
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    _perfFd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/*!
+ * \brief Read instruction counter
+ */
+static uint64_t perfRead(void)
+{
+    uint64_t count = 0;
+
+    if ((_perfFd < 0) || (read(_perfFd, &count, sizeof(count)) != sizeof(count))) {
+        return 0;
+    }
+
+    return count;
+}
+
+/*!
+ * \defgroup Reference codec
+ * \details
+ *      Division based temperature codec and snprintf() formatting of library v1.1.1, used to
+ *      verify that the current codec is bit-exact and to compare its speed.
+ * @{
+ */
+/*! Set temperature */
+#define REF_SET_TEMP(x)     ((((((uint32_t)(x) / 100) % 10)) << 16) | \
+                            ((((uint32_t)(x) / 10) % 10) << 12) | \
+                            (((x) % 10) << 8))
+/*! Get temperature */
+#define REF_GET_TEMP(x)     (((((x) >> 16) & 0x0f) * 100) + \
+                            ((((x) >> 12) & 0x0f) * 10) + \
+                            (((x) >> 8) & 0x0f))
+
+/*!
+ * \brief Reference OregonTHN128_DataToRaw()
+ */
+static __attribute__((noinline)) uint32_t refDataToRaw(const OregonTHN128Data_t *data)
+{
+    uint32_t rawData;
+    uint16_t crc;
+
+    rawData = (data->rollingAddress & 0x07) | (((data->channel - 1) & 0x03) << 6);
+    if (data->temperature < 0) {
+        rawData |= (1UL << 21);
+        rawData |= REF_SET_TEMP(data->temperature * -1);
+    } else {
+        rawData |= REF_SET_TEMP(data->temperature);
+    }
+    if (data->lowBattery) {
+        rawData |= (1UL << 23);
+    }
+
+    crc = ((rawData >> 16) & 0xff) + ((rawData >> 8) & 0xff) + (rawData & 0xff);
+    crc = (crc >> 8) + (crc & 0xff);
+
+    return rawData | ((uint32_t)(uint8_t)crc << 24);
+}
+
+/*!
+ * \brief Reference OregonTHN128_RawToData() temperature
+ */
+static __attribute__((noinline)) int16_t refRawToTemp(uint32_t rawData)
+{
+    int16_t temperature = REF_GET_TEMP(rawData);
+
+    if (rawData & (1UL << 21)) {
+        temperature *= -1;
+    }
+
+    return temperature;
+}
+
+/*!
+ * \brief Reference OregonTHN128_TempToString()
+ */
+static __attribute__((noinline)) void refTempToString(char *temperatureStr,
+                                                      uint8_t temperatureStrLen,
+                                                      int16_t temperature)
+{
+    int tempAbs = (temperature < 0) ? -temperature : temperature;
+
+    snprintf(temperatureStr, temperatureStrLen, "%s%d.%d",
+             (temperature < 0) ? "-" : "", (tempAbs / 10), tempAbs % 10);
+}
+
+/*! @} */
+
+/*!
+ * \brief Append level to edge buffer, merge with previous level when equal
+ */
+static void addLevel(Edges_t *edges, uint8_t level, uint16_t duration)
+{
+    if ((edges->n > 0) && (edges->levels[edges->n - 1] == level)) {
+        edges->durations[edges->n - 1] += duration;
+    } else {
+        edges->levels[edges->n] = level;
+        edges->durations[edges->n] = duration;
+        edges->n++;
+    }
+}
+
+/*!
+ * \brief Append transmitted frame waveform to edge buffer
+ */
+static void addFrame(Edges_t *edges, uint32_t rawData)
+{
+    /* Preamble 12x bit 1 and preamble space */
+    for (int i = 0; i < 12; i++) {
+        addLevel(edges, 1, T_BIT_US);
+        addLevel(edges, 0, T_BIT_US);
+    }
+    addLevel(edges, 0, T_PREAMBLE_SPACE_US);
+
+    /* Sync */
+    addLevel(edges, 1, T_SYNC_US);
+    addLevel(edges, 0, T_SYNC_US);
+
+    /* Data */
+    for (int i = 0; i < 32; i++) {
+        if (rawData & (1UL << i)) {
+            addLevel(edges, 1, T_BIT_US);
+            addLevel(edges, 0, T_BIT_US);
+        } else {
+            addLevel(edges, 0, T_BIT_US);
+            addLevel(edges, 1, T_BIT_US);
+        }
+    }
+
+    /* Space between frames, limited to the 16-bit duration */
+    addLevel(edges, 0, 60000);
+}
+
+/*!
+ * \brief Return 32-bit pseudo random number
+ */
+static uint32_t random32(void)
+{
+    static uint32_t x = 1;
+
+    /* xorshift32 */
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    return x;
+}
+
+/*!
+ * \brief Generate realistic inputs: plausible sensor readings with valid checksum
+ */
+static void generateRealistic(Inputs_t *inputs)
+{
+    for (int i = 0; i < NUM_INPUTS; i++) {
+        OregonTHN128Data_t *data = &inputs->data[i];
+
+        data->rollingAddress = random32() % 8;
+        data->channel = 1 + (random32() % 3);
+        data->temperature = (int16_t)((random32() % 600) - 200);
+        data->lowBattery = (random32() % 16) == 0;
+        data->rawData = OregonTHN128_DataToRaw(data);
+        inputs->rawData[i] = data->rawData;
+    }
+
+    inputs->edges.n = 0;
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        addFrame(&inputs->edges, inputs->rawData[i]);
+    }
+}
+
+/*!
+ * \brief Generate random inputs: random raw words and data structures
+ */
+static void generateRandom(Inputs_t *inputs)
+{
+    for (int i = 0; i < NUM_INPUTS; i++) {
+        OregonTHN128Data_t *data = &inputs->data[i];
+
+        inputs->rawData[i] = random32();
+        data->rawData = 0;
+        data->rollingAddress = random32() & 0xff;
+        data->channel = random32() & 0xff;
+        data->temperature = (int16_t)random32();
+        data->lowBattery = random32() & 1;
+    }
+
+    /* Random level durations between 0 and 2x sync length */
+    inputs->edges.n = NUM_FRAMES * MAX_EDGES_FRAME;
+    for (size_t i = 0; i < inputs->edges.n; i++) {
+        inputs->edges.durations[i] = random32() % (2 * T_SYNC_US);
+        inputs->edges.levels[i] = i & 1;
+    }
+}
+
+/*!
+ * \brief Benchmark OregonTHN128_CheckCRC()
+ */
+static size_t benchCheckCRC(const Inputs_t *inputs)
+{
+    uint32_t sum = 0;
+
+    for (int i = 0; i < NUM_INPUTS; i++) {
+        sum += OregonTHN128_CheckCRC(inputs->rawData[i]);
+    }
+    _sink += sum;
+
+    return NUM_INPUTS;
+}
+
+/*!
+ * \brief Benchmark OregonTHN128_RawToData()
+ */
+static size_t benchRawToData(const Inputs_t *inputs)
+{
+    OregonTHN128Data_t data;
+    uint32_t sum = 0;
+
+    for (int i = 0; i < NUM_INPUTS; i++) {
+        sum += OregonTHN128_RawToData(inputs->rawData[i], &data);
+        sum += data.temperature;
+    }
+    _sink += sum;
+
+    return NUM_INPUTS;
+}
+
+/*!
+ * \brief Benchmark OregonTHN128_CheckCRCBatch()
+ */
+static size_t benchCheckCRCBatch(const Inputs_t *inputs)
+{
+    _sink += OregonTHN128_CheckCRCBatch(inputs->rawData, NUM_INPUTS, _crcOk);
+
+    return NUM_INPUTS;
+}
+
+/*!
+ * \brief Benchmark OregonTHN128_RawToData() per frame into columns, scalar baseline of the batch
+ */
+static size_t benchRawToDataColumns(const Inputs_t *inputs)
+{
+    OregonTHN128Data_t data;
+    uint32_t sum = 0;
+
+    for (int i = 0; i < NUM_INPUTS; i++) {
+        _crcOk[i] = OregonTHN128_RawToData(inputs->rawData[i], &data);
+        _rollingAddress[i] = data.rollingAddress;
+        _channel[i] = data.channel;
+        _temperature[i] = data.temperature;
+        _lowBattery[i] = data.lowBattery;
+        sum += _crcOk[i];
+    }
+    _sink += sum;
+
+    return NUM_INPUTS;
+}
+
+/*!
+ * \brief Benchmark OregonTHN128_RawToDataBatch()
+ */
+static size_t benchRawToDataBatch(const Inputs_t *inputs)
+{
+    _sink += OregonTHN128_RawToDataBatch(inputs->rawData, NUM_INPUTS, &_columns);
+
+    return NUM_INPUTS;
+}
+
+/*!
+ * \brief Benchmark OregonTHN128_StoreAppend()
+ */
+static size_t benchStoreAppend(const Inputs_t *inputs)
+{
+    OregonTHN128_StoreInit(&_store, _storeTimestamp, _storeSensor, _storeTemperature, _storeFlags,
+                           NUM_READINGS);
+    for (uint32_t i = 0; i < NUM_READINGS; i++) {
+        OregonTHN128_StoreAppend(&_store, i * 16, &inputs->data[i % NUM_INPUTS]);
+    }
+
+    return NUM_READINGS;
+}
+
+/*!
+ * \brief Benchmark reference array of structs append
+ */
+static size_t benchAosAppend(const Inputs_t *inputs)
+{
+    for (uint32_t i = 0; i < NUM_READINGS; i++) {
+        _aos[i].timestamp = i * 16;
+        _aos[i].data = inputs->data[i % NUM_INPUTS];
+    }
+
+    return NUM_READINGS;
+}
+
+/*!
+ * \brief Benchmark OregonTHN128_StoreRange(), one query per 1024 readings
+ */
+static size_t benchStoreRange(const Inputs_t *inputs)
+{
+    size_t first;
+    size_t sum = 0;
+
+    (void)inputs;
+
+    for (uint32_t i = 0; i < NUM_READINGS; i += 1024) {
+        sum += OregonTHN128_StoreRange(&_store, i * 16, (i + 1024) * 16, &first);
+    }
+    _sink += (uint32_t)sum;
+
+    return NUM_READINGS / 1024;
+}
+
+/*!
+ * \brief Benchmark OregonTHN128_StoreFilter() of one sensor over all readings, ops are readings
+ */
+static size_t benchStoreFilter(const Inputs_t *inputs)
+{
+    uint8_t sensor = OREGON_THN128_SENSOR(inputs->data[0].channel, inputs->data[0].rollingAddress);
+    size_t first = 0;
+    size_t n;
+
+    while (first < _store.count) {
+        n = OregonTHN128_StoreFilter(&_store, first, _store.count - first, sensor,
+                                     _indices, NUM_INDICES);
+        if (n < NUM_INDICES) {
+            break;
+        }
+        first = _indices[n - 1] + 1;
+    }
+    _sink += (uint32_t)first;
+
+    return NUM_READINGS;
+}
+
+/*!
+ * \brief Benchmark reference array of structs filter of one sensor, ops are readings
+ */
+static size_t benchAosFilter(const Inputs_t *inputs)
+{
+    uint8_t channel = inputs->data[0].channel;
+    uint8_t rollingAddress = inputs->data[0].rollingAddress;
+    size_t n = 0;
+
+    for (size_t i = 0; i < NUM_READINGS; i++) {
+        if ((_aos[i].data.channel == channel) && (_aos[i].data.rollingAddress == rollingAddress)) {
+            _indices[n++ % NUM_INDICES] = i;
+        }
+    }
+    _sink += (uint32_t)n;
+
+    return NUM_READINGS;
+}
+
+/*!
+ * \brief Benchmark OregonTHN128_StoreStats() of one sensor over all readings, ops are readings
+ */
+static size_t benchStoreStats(const Inputs_t *inputs)
+{
+    uint8_t sensor = OREGON_THN128_SENSOR(inputs->data[0].channel, inputs->data[0].rollingAddress);
+    OregonTHN128StoreStats_t stats;
+
+    OregonTHN128_StoreStats(&_store, 0, _store.count, sensor, &stats);
+    _sink += (uint32_t)stats.sumTemperature;
+
+    return NUM_READINGS;
+}
+
+/*!
+ * \brief Benchmark reference array of structs statistics of one sensor, ops are readings
+ */
+static size_t benchAosStats(const Inputs_t *inputs)
+{
+    uint8_t channel = inputs->data[0].channel;
+    uint8_t rollingAddress = inputs->data[0].rollingAddress;
+    int16_t minTemperature = INT16_MAX;
+    int16_t maxTemperature = INT16_MIN;
+    int64_t sumTemperature = 0;
+
+    for (size_t i = 0; i < NUM_READINGS; i++) {
+        int16_t temperature = _aos[i].data.temperature;
+
+        if ((_aos[i].data.channel == channel) && (_aos[i].data.rollingAddress == rollingAddress)) {
+            if (temperature < minTemperature) {
+                minTemperature = temperature;
+            }
+            if (temperature > maxTemperature) {
+                maxTemperature = temperature;
+            }
+            sumTemperature += temperature;
+        }
+    }
+    _sink += (uint32_t)sumTemperature + minTemperature + maxTemperature;
+
+    return NUM_READINGS;
+}
+
+/*!
+ * \brief Benchmark OregonTHN128_DataToRaw()
+ */
+static size_t benchDataToRaw(const Inputs_t *inputs)
+{
+    OregonTHN128Data_t data;
+    uint32_t sum = 0;
+
+    for (int i = 0; i < NUM_INPUTS; i++) {
+        data = inputs->data[i];
+        sum += OregonTHN128_DataToRaw(&data);
+    }
+    _sink += sum;
+
+    return NUM_INPUTS;
+}
+
+/*!
+ * \brief Benchmark reference DataToRaw()
+ */
+static size_t benchRefDataToRaw(const Inputs_t *inputs)
+{
+    uint32_t sum = 0;
+
+    for (int i = 0; i < NUM_INPUTS; i++) {
+        sum += refDataToRaw(&inputs->data[i]);
+    }
+    _sink += sum;
+
+    return NUM_INPUTS;
+}
+
+/*!
+ * \brief Benchmark reference RawToData() temperature conversion
+ */
+static size_t benchRefRawToTemp(const Inputs_t *inputs)
+{
+    uint32_t sum = 0;
+
+    for (int i = 0; i < NUM_INPUTS; i++) {
+        sum += refRawToTemp(inputs->rawData[i]);
+    }
+    _sink += sum;
+
+    return NUM_INPUTS;
+}
+
+/*!
+ * \brief Benchmark OregonTHN128_TempToString()
+ */
+static size_t benchTempToString(const Inputs_t *inputs)
+{
+    char temperatureStr[10];
+    uint32_t sum = 0;
+
+    for (int i = 0; i < NUM_INPUTS; i++) {
+        OregonTHN128_TempToString(temperatureStr, sizeof(temperatureStr),
+                                  inputs->data[i].temperature);
+        sum += (uint8_t)temperatureStr[1];
+    }
+    _sink += sum;
+
+    return NUM_INPUTS;
+}
+
+/*!
+ * \brief Benchmark OregonTHN128_TempAppend()
+ */
+static size_t benchTempAppend(const Inputs_t *inputs)
+{
+    char msg[32];
+    uint32_t sum = 0;
+
+    for (int i = 0; i < NUM_INPUTS; i++) {
+        sum += OregonTHN128_TempAppend(msg, sizeof(msg), inputs->data[i].temperature);
+    }
+    _sink += sum;
+
+    return NUM_INPUTS;
+}
+
+/*!
+ * \brief Benchmark reference snprintf() TempToString()
+ */
+static size_t benchRefTempToString(const Inputs_t *inputs)
+{
+    char temperatureStr[10];
+    uint32_t sum = 0;
+
+    for (int i = 0; i < NUM_INPUTS; i++) {
+        refTempToString(temperatureStr, sizeof(temperatureStr), inputs->data[i].temperature);
+        sum += (uint8_t)temperatureStr[1];
+    }
+    _sink += sum;
+
+    return NUM_INPUTS;
+}
+
+/*!
+ * \brief Decode callback
+ */
+static void frameReceived(uint32_t rawData, void *arg)
+{
+    *(uint32_t *)arg += rawData;
+}
+
+/*!
+ * \brief Benchmark OregonTHN128_DecodePulses(), one operation per edge
+ */
+static size_t benchDecodePulses(const Inputs_t *inputs)
+{
+    uint32_t sum = 0;
+
+    OregonTHN128_DecodePulses(inputs->edges.durations, inputs->edges.levels, inputs->edges.n,
+                              frameReceived, &sum);
+    _sink += sum;
+
+    return inputs->edges.n;
+}
+
+/*!
+ * \brief Benchmark OregonTHN128_DedupFilter(), every frame and its repeat
+ */
+static size_t benchDedupFilter(const Inputs_t *inputs)
+{
+    static OregonTHN128Dedup_t dedup;
+    uint32_t tMs = 0;
+    uint32_t sum = 0;
+
+    OregonTHN128_DedupInit(&dedup, OREGON_THN128_DEDUP_WINDOW_MS);
+    for (int i = 0; i < NUM_INPUTS; i++) {
+        sum += OregonTHN128_DedupFilter(&dedup, inputs->rawData[i], tMs);
+        sum += OregonTHN128_DedupFilter(&dedup, inputs->rawData[i], tMs + T_SPACE_FRAMES_MS);
+        tMs += T_INTERVAL_MS;
+    }
+    _sink += sum;
+
+    return NUM_INPUTS * 2;
+}
+
+/*!
+ * \brief Profile each OregonTHN128_DecodeEdge() call like the receive interrupt handler
+ */
+static void profileDecodeEdge(const Inputs_t *inputs, OregonTHN128IsrProfile_t *profile)
+{
+    OregonTHN128Decoder_t decoder;
+    uint64_t tAir = 0;
+    uint64_t stamp;
+    uint32_t rawData;
+    uint8_t path;
+
+    OregonTHN128_DecoderInit(&decoder);
+    OregonTHN128_ProfileReset(profile);
+
+    for (size_t i = 0; i < inputs->edges.n; i++) {
+        stamp = cycleCount();
+        if (inputs->edges.durations[i] < T_RX_TOLERANCE_US) {
+            path = OregonTHN128IsrPathGlitch;
+        } else {
+            path = OREGON_THN128_DECODER_IDLE(&decoder) ? OregonTHN128IsrPathSearch :
+                                                          OregonTHN128IsrPathBit;
+            if (OregonTHN128_DecodeEdge(&decoder, inputs->edges.durations[i],
+                                        inputs->edges.levels[i] ? true : false, &rawData)) {
+                path = OregonTHN128IsrPathFrame;
+            }
+        }
+        OregonTHN128_ProfileAdd(profile, (uint32_t)(cycleCount() - stamp), path);
+        tAir += inputs->edges.durations[i];
+    }
+
+    OregonTHN128_ProfileLoad(profile, (uint32_t)tAir, cycleCountPerUs());
+}
+
+/*!
+ * \brief Print profile as JSON
+ */
+static void printProfile(const char *input, const OregonTHN128IsrProfile_t *profile, bool last)
+{
+    static const char * const pathNames[OregonTHN128IsrPaths] = {
+        "glitch", "search", "bit", "frame"
+    };
+
+    printf("    {\"input\": \"%s\", \"count\": %u, \"min\": %u, \"max\": %u, "
+           "\"mean\": %.1f, \"worst_path\": \"%s\",\n", input, profile->count,
+           profile->minCycles, profile->maxCycles,
+           (double)profile->totalCycles / profile->count, pathNames[profile->maxPath]);
+    printf("     \"path_max\": {");
+    for (int i = 0; i < OregonTHN128IsrPaths; i++) {
+        printf("%s\"%s\": %u", i ? ", " : "", pathNames[i], profile->pathMaxCycles[i]);
+    }
+    printf("},\n     \"histogram_log2\": [");
+    for (int i = 0; i < OREGON_THN128_PROFILE_BINS; i++) {
+        printf("%s%u", i ? ", " : "", profile->histogram[i]);
+    }
+    printf("], \"load_percent\": %.2f}%s\n", profile->load / 100.0, last ? "" : ",");
+}
+
+/*!
+ * \brief Run benchmark and print JSON result
+ */
+static void runBenchmark(const char *name, const char *input, BenchmarkFunc_t func,
+                         const Inputs_t *inputs)
+{
+    uint64_t instructions;
+    size_t numOps = 0;
+    double tStart;
+    double tElapsed;
+
+    /* Warm up caches */
+    func(inputs);
+
+    if (_perfFd >= 0) {
+        ioctl(_perfFd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(_perfFd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+    tStart = timeNow();
+    do {
+        numOps += func(inputs);
+        tElapsed = timeNow() - tStart;
+    } while (tElapsed < T_MEASURE_MIN_S);
+    if (_perfFd >= 0) {
+        ioctl(_perfFd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+    instructions = perfRead();
+
+    printf("%s    {\"name\": \"%s\", \"input\": \"%s\", \"ops\": %zu, \"ns_per_op\": %.3f, ",
+           _jsonNext ? ",\n" : "", name, input, numOps, (tElapsed * 1e9) / numOps);
+    if (instructions) {
+        printf("\"instructions_per_op\": %.1f}", (double)instructions / numOps);
+    } else {
+        printf("\"instructions_per_op\": null}");
+    }
+    _jsonNext = true;
+}
+
+/*!
+ * \brief Run all benchmarks for one input set
+ */
+static void runBenchmarks(const char *input, const Inputs_t *inputs)
+{
+    runBenchmark("OregonTHN128_CheckCRC", input, benchCheckCRC, inputs);
+    runBenchmark("OregonTHN128_CheckCRCBatch", input, benchCheckCRCBatch, inputs);
+    runBenchmark("OregonTHN128_RawToData", input, benchRawToData, inputs);
+    runBenchmark("reference_RawToDataColumns", input, benchRawToDataColumns, inputs);
+    runBenchmark("OregonTHN128_RawToDataBatch", input, benchRawToDataBatch, inputs);
+    runBenchmark("OregonTHN128_DataToRaw", input, benchDataToRaw, inputs);
+    runBenchmark("reference_DataToRaw", input, benchRefDataToRaw, inputs);
+    runBenchmark("reference_RawToTemp", input, benchRefRawToTemp, inputs);
+    runBenchmark("OregonTHN128_TempToString", input, benchTempToString, inputs);
+    runBenchmark("OregonTHN128_TempAppend", input, benchTempAppend, inputs);
+    runBenchmark("reference_TempToString", input, benchRefTempToString, inputs);
+    runBenchmark("OregonTHN128_DecodePulses", input, benchDecodePulses, inputs);
+    runBenchmark("OregonTHN128_DedupFilter", input, benchDedupFilter, inputs);
+}
+
+/*!
+ * \brief Verify that the codec is bit-exact with the reference codec
+ */
+static int verifyCodec(void)
+{
+    OregonTHN128Data_t data;
+
+    /* All temperatures with both low battery states */
+    memset(&data, 0, sizeof(data));
+    data.rollingAddress = 5;
+    data.channel = 2;
+    for (int32_t t = INT16_MIN; t <= INT16_MAX; t++) {
+        data.temperature = (int16_t)t;
+        for (int lowBattery = 0; lowBattery <= 1; lowBattery++) {
+            data.lowBattery = lowBattery;
+            if (OregonTHN128_DataToRaw(&data) != refDataToRaw(&data)) {
+                fprintf(stderr, "DataToRaw: temperature %d mismatch\n", (int)t);
+                return 1;
+            }
+        }
+    }
+
+    /* Temperature strings for all temperatures and buffer sizes */
+    for (int32_t t = INT16_MIN; t <= INT16_MAX; t++) {
+        for (uint8_t len = 1; len <= 10; len++) {
+            char str[10];
+            char refStr[10];
+
+            OregonTHN128_TempToString(str, len, (int16_t)t);
+            refTempToString(refStr, len, (int16_t)t);
+            if (strcmp(str, refStr) != 0) {
+                fprintf(stderr, "TempToString: %d \"%s\" != \"%s\"\n", (int)t, str, refStr);
+                return 1;
+            }
+        }
+    }
+
+    /* All combinations of the 24 data bits, checksum byte does not affect the data */
+    for (uint32_t rawData = 0; rawData < (1UL << 24); rawData++) {
+        OregonTHN128_RawToData(rawData, &data);
+        if (data.temperature != refRawToTemp(rawData)) {
+            fprintf(stderr, "RawToData: 0x%08x mismatch\n", rawData);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/*!
+ * \brief Run reading store benchmarks, the store is filled by the append benchmark
+ */
+static void runStoreBenchmarks(const char *input, const Inputs_t *inputs)
+{
+    runBenchmark("OregonTHN128_StoreAppend", input, benchStoreAppend, inputs);
+    runBenchmark("reference_AosAppend", input, benchAosAppend, inputs);
+    runBenchmark("OregonTHN128_StoreRange", input, benchStoreRange, inputs);
+    runBenchmark("OregonTHN128_StoreFilter", input, benchStoreFilter, inputs);
+    runBenchmark("reference_AosFilter", input, benchAosFilter, inputs);
+    runBenchmark("OregonTHN128_StoreStats", input, benchStoreStats, inputs);
+    runBenchmark("reference_AosStats", input, benchAosStats, inputs);
+}
+
+/*!
+ * \brief Verify that the reading store returns the same readings as the array of structs
+ */
+static int verifyStore(const Inputs_t *inputs)
+{
+    OregonTHN128StoreStats_t stats;
+    size_t numIndices;
+    size_t first;
+    size_t n;
+
+    benchStoreAppend(inputs);
+    benchAosAppend(inputs);
+
+    /* Timestamps 16 * index: 100 readings from index 10 */
+    n = OregonTHN128_StoreRange(&_store, 10 * 16 - 15, 110 * 16 - 15, &first);
+    if ((first != 10) || (n != 100)) {
+        fprintf(stderr, "StoreRange: %zu readings from %zu\n", n, first);
+        return 1;
+    }
+
+    for (int sensorIndex = 0; sensorIndex < 4; sensorIndex++) {
+        const OregonTHN128Data_t *data = &inputs->data[sensorIndex];
+        uint8_t sensor = OREGON_THN128_SENSOR(data->channel, data->rollingAddress);
+        int64_t sumTemperature = 0;
+        size_t count = 0;
+
+        OregonTHN128_StoreStats(&_store, 0, _store.count, sensor, &stats);
+        numIndices = 0;
+        first = 0;
+        for (size_t i = 0; i < NUM_READINGS; i++) {
+            if ((_aos[i].data.channel == data->channel) &&
+                (_aos[i].data.rollingAddress == data->rollingAddress)) {
+                if ((numIndices == 0) &&
+                    (OregonTHN128_StoreFilter(&_store, first, _store.count - first, sensor,
+                                              _indices, NUM_INDICES) != 0)) {
+                    numIndices = 1;
+                    if (_indices[0] != i) {
+                        fprintf(stderr, "StoreFilter: index %zu != %zu\n", _indices[0], i);
+                        return 1;
+                    }
+                }
+                sumTemperature += _aos[i].data.temperature;
+                count++;
+            }
+        }
+        if ((stats.count != count) || (stats.sumTemperature != sumTemperature)) {
+            fprintf(stderr, "StoreStats: %zu readings mismatch\n", stats.count);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/*!
+ * \brief Verify that the batch functions are identical to the scalar functions
+ * \details
+ *      All combinations of the 24 data bits, with a valid checksum and with a random checksum.
+ *      Batches have different lengths to cover the scalar processing of the remaining frames.
+ */
+static int verifyBatch(void)
+{
+    static uint32_t rawData[NUM_INPUTS];
+    static uint8_t okMask[NUM_INPUTS];
+    OregonTHN128Data_t data;
+
+    for (uint32_t first = 0; first < (1UL << 24); ) {
+        size_t n = NUM_INPUTS - (random32() % 32);
+        size_t numOk = 0;
+
+        if (n > ((1UL << 24) - first)) {
+            n = (1UL << 24) - first;
+        }
+        for (size_t i = 0; i < n; i++) {
+            uint32_t crc = ((first >> 16) & 0xff) + ((first >> 8) & 0xff) + (first & 0xff);
+
+            crc = ((crc >> 8) + crc) & 0xff;
+            rawData[i] = first++ | ((i & 1) ? (random32() << 24) : (crc << 24));
+        }
+
+        if (OregonTHN128_CheckCRCBatch(rawData, n, okMask) !=
+            OregonTHN128_RawToDataBatch(rawData, n, &_columns)) {
+            fprintf(stderr, "Batch: number of valid frames mismatch\n");
+            return 1;
+        }
+        for (size_t i = 0; i < n; i++) {
+            bool crcOk = OregonTHN128_RawToData(rawData[i], &data);
+
+            numOk += crcOk;
+            if ((okMask[i] != crcOk) || (_crcOk[i] != crcOk) ||
+                (_rollingAddress[i] != data.rollingAddress) || (_channel[i] != data.channel) ||
+                (_temperature[i] != data.temperature) || (_lowBattery[i] != data.lowBattery)) {
+                fprintf(stderr, "Batch: 0x%08x mismatch\n", rawData[i]);
+                return 1;
+            }
+        }
+        if (OregonTHN128_CheckCRCBatch(rawData, n, okMask) != numOk) {
+            fprintf(stderr, "Batch: %zu valid frames expected\n", numOk);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/*!
+ * \brief Verify that all generated frames are decoded
+ */
+static int verifyDecodePulses(const Inputs_t *inputs)
+{
+    uint32_t expectedSum = 0;
+    uint32_t sum = 0;
+    size_t numFrames;
+
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        expectedSum += inputs->rawData[i];
+    }
+
+    numFrames = OregonTHN128_DecodePulses(inputs->edges.durations, inputs->edges.levels,
+                                          inputs->edges.n, frameReceived, &sum);
+    if ((numFrames != NUM_FRAMES) || (sum != expectedSum)) {
+        fprintf(stderr, "DecodePulses: %zu of %d frames decoded\n", numFrames, NUM_FRAMES);
+        return 1;
+    }
+
+    return 0;
+}
+
+/*!
+ * \brief Verify that only the first copy of repeated frames is reported
+ */
+static int verifyDedup(const Inputs_t *inputs)
+{
+    OregonTHN128Dedup_t dedup;
+    OregonTHN128Data_t data;
+    uint32_t tMs = 0;
+    int reported = 0;
+
+    OregonTHN128_DedupInit(&dedup, OREGON_THN128_DEDUP_WINDOW_MS);
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        /* Frame, repeat and a late copy of the same frame after the window */
+        reported += (OregonTHN128_DedupFilter(&dedup, inputs->rawData[i], tMs) == 0);
+        reported += (OregonTHN128_DedupFilter(&dedup, inputs->rawData[i],
+                                              tMs + T_SPACE_FRAMES_MS) == 0);
+        OregonTHN128_RawToData(inputs->rawData[i], &data);
+        if (OregonTHN128_DedupRepeatCount(&dedup, &data) != 1) {
+            fprintf(stderr, "Dedup: frame %d repeat count\n", i);
+            return 1;
+        }
+        reported += (OregonTHN128_DedupFilter(&dedup, inputs->rawData[i],
+                                              tMs + T_SPACE_FRAMES_MS +
+                                              OREGON_THN128_DEDUP_WINDOW_MS + 1) == 0);
+        tMs += T_INTERVAL_MS;
+    }
+    if (reported != (NUM_FRAMES * 2)) {
+        fprintf(stderr, "Dedup: %d of %d frames reported\n", reported, NUM_FRAMES * 2);
+        return 1;
+    }
+
+    return 0;
+}
+
+int main(void)
+{
+    static Inputs_t inputs;
+    OregonTHN128IsrProfile_t profileRealistic;
+    OregonTHN128IsrProfile_t profileRandom;
+
+    perfOpen();
+
+    /* Check codec and decoder before measuring them */
+    generateRealistic(&inputs);
+    if (verifyCodec() || verifyBatch() || verifyStore(&inputs) || verifyDecodePulses(&inputs) ||
+        verifyDedup(&inputs)) {
+        return EXIT_FAILURE;
+    }
+
+    printf("{\n  \"batch_kernel\": \"%s\",\n", OregonTHN128_BatchKernel());
+    printf("  \"bytes_per_reading\": {\"store\": %zu, \"reference_aos\": %zu},\n",
+           sizeof(_storeTimestamp[0]) + sizeof(_storeSensor[0]) + sizeof(_storeTemperature[0]) +
+           sizeof(_storeFlags[0]), sizeof(AosReading_t));
+    printf("  \"benchmarks\": [\n");
+    runBenchmarks("realistic", &inputs);
+    runStoreBenchmarks("realistic", &inputs);
+    profileDecodeEdge(&inputs, &profileRealistic);
+    generateRandom(&inputs);
+    runBenchmarks("random", &inputs);
+    profileDecodeEdge(&inputs, &profileRandom);
+    printf("\n  ],\n");
+
+    printf("  \"decode_edge_profile\": {\"counter\": \"%s\", \"inputs\": [\n", CYCLE_COUNTER);
+    printProfile("realistic", &profileRealistic, false);
+    printProfile("random", &profileRandom, true);
+    printf("  ]}\n}\n");
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,640 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128ChannelSim.c
+ * \brief Oregon THN128 simulated RF channel and decoder sensitivity benchmark
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      Renders random readings with OregonTHN128_EncodeEdges(), passes them through a simulated
+ *      433MHz channel and decodes the result with the receive state machine. The channel adds:
+ *      - Clock deviation: all transmit timings are -c percent longer (or shorter when negative),
+ *        as with the RC oscillator of a cold sensor
+ *      - Timing jitter: Gaussian offset per edge, standard deviation swept from 0 to 200us
+ *      - Pulse stretching: each pulse is -s us longer, as with the AGC of OOK receivers
+ *      - Dropped edges: with probability -d per pulse, the pulse is missed or the space after the
+ *        pulse is missed (both edges of the pulse or of the space are lost)
+ *      - Noise bursts: high pulses of 1..-w us at random times, swept from 0 to 100 bursts per
+ *        second
+ *
+ *      The frame decode success rate is measured for each jitter and noise level with all cores.
+ *      The result shows the margin of the bit windows. With -r, the decoder runs as with frame
+ *      recovery enabled: soft bit windows, and frames with a checksum error are retried with
+ *      OregonTHN128_RecoverSoft() and counted separately: frames only received by the retry and
+ *      wrong retried frames. Results are written as JSON to stdout and do not depend on the
+ *      number of threads.
+ *
+ *      Before the sweep, every data level of a frame is lengthened and shortened to the edges of
+ *      the bit windows. Exits with 1 when the default windows are not +/-T_RX_TOLERANCE_US, or
+ *      when the soft windows do not accept levels just outside.
+ *
+ *      Build and run on a Linux host from the repository root:
+ *
+ *      gcc -O2 -pthread -Isrc src/ErriezOregonTHN128.c src/ErriezOregonTHN128Decoder.c \
+ *          src/ErriezOregonTHN128Encoder.c src/ErriezOregonTHN128Recover.c \
+ *          extras/host/ErriezOregonTHN128ChannelSim.c -o channelsim -lm
+ *      ./channelsim [-f frames per point] [-t threads] [-c clock deviation %] [-s stretch us]
+ *                   [-d drop rate] [-w max noise width us] [-r] > channelsim.json
+ *
+ *      Add -DOREGON_THN128_RX_ADAPTIVE_CLOCK=0 to measure the fixed receive windows.
+ */
+
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "ErriezOregonTHN128.h"
+#include "ErriezOregonTHN128Decoder.h"
+#include "ErriezOregonTHN128Encoder.h"
+#include "ErriezOregonTHN128Recover.h"
+
+/*! Idle time before and after a frame in us, receives noise as well */
+#define T_IDLE_US           20000
+
+/*! Frames per work item */
+#define CHUNK_FRAMES        5000
+
+/*! Maximum number of noise bursts per frame */
+#define MAX_NOISE           1024
+
+/*! Maximum number of pulses per frame */
+#define MAX_PULSES          (OREGON_THN128_FRAME_EDGES_MAX + MAX_NOISE)
+
+/*! Maximum number of levels per frame */
+#define MAX_LEVELS          (2 * MAX_PULSES + 1)
+
+/*!
+ * \brief High pulse from begin to end in us
+ */
+typedef struct {
+    int32_t begin;          /*!< Rising edge */
+    int32_t end;            /*!< Falling edge */
+} Pulse_t;
+
+/*!
+ * \brief Channel parameters
+ */
+typedef struct {
+    double clock;           /*!< Transmit clock deviation in percent */
+    double jitter;          /*!< Standard deviation of the edge times in us */
+    double noiseRate;       /*!< Noise bursts per second */
+    double stretch;         /*!< Pulse stretching in us */
+    double dropRate;        /*!< Probability per pulse of a missed pulse or space */
+    uint32_t noiseWidth;    /*!< Maximum noise burst width in us */
+    bool recover;           /*!< Decode as with frame recovery: soft windows and retry */
+} Channel_t;
+
+/*!
+ * \brief Result of one work item
+ */
+typedef struct {
+    uint32_t decoded;       /*!< Frames decoded correctly */
+    uint32_t falseFrames;   /*!< Frames decoded with different data and a valid checksum */
+    uint32_t softDecoded;   /*!< Frames only decoded correctly by the soft bit retry */
+    uint32_t softFalse;     /*!< Frames retried to different data */
+} Result_t;
+
+/*!
+ * \brief Frame decode state
+ */
+typedef struct {
+    uint32_t rawData;       /*!< Transmitted frame */
+    uint32_t decoded;       /*!< Number of times decoded correctly */
+    uint32_t falseFrames;   /*!< Number of wrong frames */
+    uint32_t softDecoded;   /*!< Number of times retried correctly */
+    uint32_t softFalse;     /*!< Number of wrong retried frames */
+} Decode_t;
+
+/*! Jitter sweep in us */
+static const double _jitters[] = { 0, 25, 50, 75, 100, 125, 150, 175, 200 };
+
+/*! Noise sweep in bursts per second */
+static const double _noiseRates[] = { 0, 3, 10, 30, 100 };
+
+/*! Number of sweep points */
+#define NUM_POINTS  ((sizeof(_jitters) / sizeof(_jitters[0])) * \
+                     (sizeof(_noiseRates) / sizeof(_noiseRates[0])))
+
+/*! Channel parameters of all sweep points */
+static Channel_t _points[NUM_POINTS];
+
+/*! Work items */
+static Result_t *_results;
+static size_t _numChunks;
+static atomic_size_t _nextItem;
+
+/*!
+ * \brief Pseudo random generator (xorshift64*)
+ */
+static uint64_t random64(uint64_t *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+
+    return *state * 0x2545f4914f6cdd1dULL;
+}
+
+/*!
+ * \brief Uniform random number in [0, 1)
+ */
+static double randomUniform(uint64_t *state)
+{
+    return (double)(random64(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/*!
+ * \brief Gaussian random number with standard deviation 1 (Box-Muller)
+ */
+static double randomGauss(uint64_t *state)
+{
+    double u1 = 1.0 - randomUniform(state);
+    double u2 = randomUniform(state);
+
+    return sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+}
+
+/*!
+ * \brief Random reading with a valid checksum
+ */
+static uint32_t randomFrame(uint64_t *state)
+{
+    OregonTHN128Data_t data;
+
+    data.rollingAddress = random64(state) % 8;
+    data.channel = 1 + (random64(state) % 3);
+    data.temperature = (int16_t)((random64(state) % 1999) - 999);
+    data.lowBattery = random64(state) & 1;
+
+    return OregonTHN128_DataToRaw(&data);
+}
+
+/*!
+ * \brief Render a frame as pulses and apply stretching, dropped edges and jitter
+ * \return
+ *      Number of pulses
+ */
+static size_t transmit(const Channel_t *channel, uint64_t *rng, uint32_t rawData,
+                       Pulse_t *pulses)
+{
+    uint16_t durations[OREGON_THN128_FRAME_EDGES_MAX];
+    uint8_t levels[OREGON_THN128_FRAME_EDGES_MAX];
+    double scale = 1.0 + (channel->clock / 100.0);
+    double t = T_IDLE_US;
+    size_t numPulses = 0;
+    size_t n;
+
+    n = OregonTHN128_EncodeEdges(rawData, durations, levels, OREGON_THN128_FRAME_EDGES_MAX);
+    for (size_t i = 0; i < n; i++) {
+        if (levels[i]) {
+            pulses[numPulses].begin = (int32_t)lround(t);
+            pulses[numPulses].end = (int32_t)lround(t + (durations[i] * scale));
+            numPulses++;
+        }
+        t += durations[i] * scale;
+    }
+
+    /* Missed pulses or spaces */
+    if (channel->dropRate > 0) {
+        size_t j = 0;
+
+        for (size_t i = 0; i < numPulses; i++) {
+            if (randomUniform(rng) >= channel->dropRate) {
+                pulses[j++] = pulses[i];
+            } else if ((random64(rng) & 1) && ((i + 1) < numPulses)) {
+                /* Missed space: merge with the next pulse */
+                pulses[i + 1].begin = pulses[i].begin;
+            }
+        }
+        numPulses = j;
+    }
+
+    /* Stretching and jitter */
+    for (size_t i = 0; i < numPulses; i++) {
+        double begin = pulses[i].begin;
+        double end = pulses[i].end + channel->stretch;
+
+        if (channel->jitter > 0) {
+            begin += channel->jitter * randomGauss(rng);
+            end += channel->jitter * randomGauss(rng);
+        }
+        pulses[i].begin = (int32_t)lround(begin);
+        pulses[i].end = (int32_t)lround(end);
+    }
+
+    return numPulses;
+}
+
+/*!
+ * \brief Add noise bursts at exponentially distributed intervals
+ * \return
+ *      Number of bursts
+ */
+static size_t addNoise(const Channel_t *channel, uint64_t *rng, int32_t tEnd, Pulse_t *noise)
+{
+    double t = 0;
+    size_t n = 0;
+
+    if (channel->noiseRate <= 0) {
+        return 0;
+    }
+
+    for (;;) {
+        t += -log(1.0 - randomUniform(rng)) * (1e6 / channel->noiseRate);
+        if ((t >= tEnd) || (n >= MAX_NOISE)) {
+            break;
+        }
+        noise[n].begin = (int32_t)t;
+        noise[n].end = noise[n].begin + 1 + (int32_t)(random64(rng) % channel->noiseWidth);
+        n++;
+    }
+
+    return n;
+}
+
+/*!
+ * \brief Compare pulses by rising edge
+ */
+static int comparePulses(const void *a, const void *b)
+{
+    const Pulse_t *pa = (const Pulse_t *)a;
+    const Pulse_t *pb = (const Pulse_t *)b;
+
+    return (pa->begin > pb->begin) - (pa->begin < pb->begin);
+}
+
+/*!
+ * \brief Convert overlapping pulses to level durations
+ * \return
+ *      Number of levels
+ */
+static size_t pulsesToLevels(Pulse_t *pulses, size_t numPulses, int32_t tEnd,
+                             uint16_t *durations, uint8_t *levels)
+{
+    int32_t t = 0;
+    size_t n = 0;
+
+    qsort(pulses, numPulses, sizeof(Pulse_t), comparePulses);
+
+    for (size_t i = 0; i < numPulses; ) {
+        int32_t begin = (pulses[i].begin < t) ? t : pulses[i].begin;
+        int32_t end = pulses[i].end;
+
+        /* Union of overlapping pulses */
+        for (i++; (i < numPulses) && (pulses[i].begin <= end); i++) {
+            if (pulses[i].end > end) {
+                end = pulses[i].end;
+            }
+        }
+        if (end <= begin) {
+            continue;
+        }
+        if (begin > t) {
+            levels[n] = 0;
+            durations[n++] = (uint16_t)(((begin - t) > 0xffff) ? 0xffff : (begin - t));
+        }
+        levels[n] = 1;
+        durations[n++] = (uint16_t)(((end - begin) > 0xffff) ? 0xffff : (end - begin));
+        t = end;
+    }
+
+    /* Idle until the end */
+    levels[n] = 0;
+    durations[n++] = (uint16_t)(((tEnd - t) > 0xffff) ? 0xffff : ((tEnd > t) ? (tEnd - t) : 1));
+
+    return n;
+}
+
+/*!
+ * \brief Count decoded frames
+ */
+static void frameReceived(uint32_t rawData, void *arg)
+{
+    Decode_t *decode = (Decode_t *)arg;
+
+    if (rawData == decode->rawData) {
+        decode->decoded++;
+    } else {
+        decode->falseFrames++;
+    }
+}
+
+/*!
+ * \brief Decode levels like OregonTHN128_DecodePulses() and retry frames with a checksum error
+ *        when recover is set
+ */
+static void decodeLevels(const uint16_t *durations, const uint8_t *levels, size_t n,
+                         bool recover, Decode_t *decode)
+{
+    OregonTHN128Decoder_t dec;
+    uint32_t tPulse = 0;
+    uint32_t rawData;
+
+    OregonTHN128_DecoderInit(&dec);
+#if OREGON_THN128_RX_SOFT_BITS
+    OregonTHN128_DecoderSetSoft(&dec, recover);
+#else
+    (void)recover;
+#endif
+
+    for (size_t i = 0; i < n; i++) {
+        tPulse += durations[i];
+        if (tPulse < T_RX_TOLERANCE_US) {
+            continue;
+        }
+
+        if (OregonTHN128_DecodeEdge(&dec, (tPulse > 0xffff) ? 0xffff : (uint16_t)tPulse,
+                                    levels[i] ? true : false, &rawData)) {
+            frameReceived(rawData, decode);
+        } else if (dec.crcError) {
+            dec.crcError = false;
+#if OREGON_THN128_RX_SOFT_BITS
+            if (recover &&
+                OregonTHN128_RecoverSoft(&OregonTHN128_ProtocolTHN128, dec.rxData, dec.softBits,
+                                         OREGON_THN128_RX_SOFT_BITS, &rawData)) {
+                if (rawData == decode->rawData) {
+                    decode->softDecoded++;
+                } else {
+                    decode->softFalse++;
+                }
+            }
+#endif
+        }
+        tPulse = 0;
+    }
+}
+
+/*!
+ * \brief Simulate frames of one work item
+ */
+static void simulateChunk(const Channel_t *channel, uint64_t seed, uint32_t numFrames,
+                          Result_t *result)
+{
+    static __thread Pulse_t pulses[MAX_PULSES];
+    static __thread uint16_t durations[MAX_LEVELS];
+    static __thread uint8_t levels[MAX_LEVELS];
+    uint64_t rng = seed;
+    Decode_t decode;
+
+    memset(result, 0, sizeof(*result));
+
+    for (uint32_t i = 0; i < numFrames; i++) {
+        size_t numPulses;
+        size_t numLevels;
+        int32_t tEnd;
+
+        decode.rawData = randomFrame(&rng);
+        decode.decoded = 0;
+        decode.falseFrames = 0;
+        decode.softDecoded = 0;
+        decode.softFalse = 0;
+
+        numPulses = transmit(channel, &rng, decode.rawData, pulses);
+        tEnd = ((numPulses > 0) ? pulses[numPulses - 1].end : T_IDLE_US) + T_IDLE_US;
+        numPulses += addNoise(channel, &rng, tEnd, &pulses[numPulses]);
+        numLevels = pulsesToLevels(pulses, numPulses, tEnd, durations, levels);
+
+        decodeLevels(durations, levels, numLevels, channel->recover, &decode);
+        result->decoded += (decode.decoded > 0);
+        result->falseFrames += decode.falseFrames;
+        result->softDecoded += ((decode.decoded == 0) && (decode.softDecoded > 0));
+        result->softFalse += decode.softFalse;
+    }
+}
+
+/*!
+ * \brief Decode a frame with one data level deviating from the nominal length
+ * \return
+ *      Number of data levels of which the frame is decoded
+ */
+static size_t decodeDeviation(int32_t deviation, bool recover, size_t *numLevels)
+{
+    const Channel_t ideal = { 0, 0, 0, 0, 0, 300, false };
+    Pulse_t pulses[OREGON_THN128_FRAME_EDGES_MAX];
+    uint16_t durations[MAX_LEVELS];
+    uint16_t nominal[MAX_LEVELS];
+    uint8_t levels[MAX_LEVELS];
+    uint64_t rng = 1;
+    Decode_t decode = { 0 };
+    size_t numPulses;
+    uint16_t tSync = 0;
+    size_t sync = 0;
+    size_t decoded = 0;
+    size_t n;
+
+    decode.rawData = randomFrame(&rng);
+    numPulses = transmit(&ideal, &rng, decode.rawData, pulses);
+    n = pulsesToLevels(pulses, numPulses, pulses[numPulses - 1].end + T_IDLE_US, nominal, levels);
+
+    /* The sync pulse is the longest pulse, data levels follow the space after it */
+    for (size_t i = 0; i < n; i++) {
+        if (levels[i] && (nominal[i] > tSync)) {
+            tSync = nominal[i];
+            sync = i;
+        }
+    }
+
+    /* All data levels except the idle level at the end */
+    *numLevels = 0;
+    for (size_t i = sync + 2; (i + 1) < n; i++) {
+        memcpy(durations, nominal, n * sizeof(uint16_t));
+        durations[i] = (uint16_t)(durations[i] + deviation);
+        decode.decoded = 0;
+        decodeLevels(durations, levels, n, recover, &decode);
+        decoded += (decode.decoded == 1);
+        (*numLevels)++;
+    }
+
+    return decoded;
+}
+
+/*!
+ * \brief Check the bit windows
+ * \details
+ *      Without recovery, levels within +/-T_RX_TOLERANCE_US are accepted and levels just outside
+ *      abort the frame. With recovery, the soft windows accept levels just outside as well.
+ * \return
+ *      true: Windows as expected
+ */
+static bool checkWindows(void)
+{
+    size_t numLevels;
+    bool ok = true;
+
+    for (int32_t sign = -1; sign <= 1; sign += 2) {
+        ok &= (decodeDeviation(sign * T_RX_TOLERANCE_US, false, &numLevels) == numLevels);
+        ok &= (decodeDeviation(sign * (T_RX_TOLERANCE_US + 1), false, &numLevels) == 0);
+#if OREGON_THN128_RX_SOFT_BITS
+        ok &= (decodeDeviation(sign * (T_RX_TOLERANCE_US + 1), true, &numLevels) == numLevels);
+#endif
+    }
+
+    return ok;
+}
+
+/*!
+ * \brief Worker thread: process work items until all are done
+ */
+static void *worker(void *arg)
+{
+    uint32_t framesPerPoint = *(const uint32_t *)arg;
+
+    for (;;) {
+        size_t item = atomic_fetch_add(&_nextItem, 1);
+        size_t point = item / _numChunks;
+        size_t chunk = item % _numChunks;
+        uint32_t numFrames;
+
+        if (point >= NUM_POINTS) {
+            break;
+        }
+
+        /* Seed per work item, so the results do not depend on the number of threads */
+        numFrames = framesPerPoint - (uint32_t)(chunk * CHUNK_FRAMES);
+        if (numFrames > CHUNK_FRAMES) {
+            numFrames = CHUNK_FRAMES;
+        }
+        simulateChunk(&_points[point], 0x9e3779b97f4a7c15ULL * (item + 1), numFrames,
+                      &_results[item]);
+    }
+
+    return NULL;
+}
+
+/*!
+ * \brief Get monotonic time in seconds
+ */
+static double timeNow(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + (ts.tv_nsec * 1e-9);
+}
+
+int main(int argc, char *argv[])
+{
+    Channel_t channel = { 0, 0, 0, 0, 0, 300, false };
+    uint32_t framesPerPoint = 100000;
+    long numThreads = sysconf(_SC_NPROCESSORS_ONLN);
+    pthread_t *threads;
+    double tStart;
+    double tElapsed;
+    size_t point = 0;
+    bool windowsOk;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "f:t:c:s:d:w:r")) != -1) {
+        switch (opt) {
+            case 'f': framesPerPoint = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 't': numThreads = strtol(optarg, NULL, 0); break;
+            case 'c': channel.clock = strtod(optarg, NULL); break;
+            case 's': channel.stretch = strtod(optarg, NULL); break;
+            case 'd': channel.dropRate = strtod(optarg, NULL); break;
+            case 'w': channel.noiseWidth = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'r': channel.recover = true; break;
+            default:
+                fprintf(stderr, "Usage: %s [-f frames per point] [-t threads] [-c clock deviation %%] "
+                        "[-s stretch us] [-d drop rate] [-w max noise width us] [-r]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if ((framesPerPoint == 0) || (numThreads < 1) || (channel.noiseWidth == 0)) {
+        fprintf(stderr, "Invalid argument\n");
+        return EXIT_FAILURE;
+    }
+
+    windowsOk = checkWindows();
+
+    /* Sweep points */
+    for (size_t j = 0; j < sizeof(_jitters) / sizeof(_jitters[0]); j++) {
+        for (size_t k = 0; k < sizeof(_noiseRates) / sizeof(_noiseRates[0]); k++) {
+            _points[point] = channel;
+            _points[point].jitter = _jitters[j];
+            _points[point].noiseRate = _noiseRates[k];
+            point++;
+        }
+    }
+
+    /* Work items */
+    _numChunks = (framesPerPoint + CHUNK_FRAMES - 1) / CHUNK_FRAMES;
+    _results = calloc(NUM_POINTS * _numChunks, sizeof(Result_t));
+    threads = calloc((size_t)numThreads, sizeof(pthread_t));
+    if ((_results == NULL) || (threads == NULL)) {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+
+    tStart = timeNow();
+    for (long i = 0; i < numThreads; i++) {
+        pthread_create(&threads[i], NULL, worker, &framesPerPoint);
+    }
+    for (long i = 0; i < numThreads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    tElapsed = timeNow() - tStart;
+
+    printf("{\n  \"tolerance_us\": %d,\n  \"soft_bits\": %d,\n  \"recover\": %s,\n"
+           "  \"windows_ok\": %s,\n  \"adaptive_clock\": %d,\n  \"clock_percent\": %.1f,\n"
+           "  \"stretch_us\": %.1f,\n  \"drop_rate\": %g,\n"
+           "  \"noise_width_max_us\": %u,\n  \"threads\": %ld,\n  \"frames\": %zu,\n"
+           "  \"frames_per_s\": %.0f,\n  \"points\": [\n",
+           T_RX_TOLERANCE_US, OREGON_THN128_RX_SOFT_BITS, channel.recover ? "true" : "false",
+           windowsOk ? "true" : "false", OREGON_THN128_RX_ADAPTIVE_CLOCK,
+           channel.clock, channel.stretch, channel.dropRate, channel.noiseWidth, numThreads,
+           (size_t)framesPerPoint * NUM_POINTS, ((double)framesPerPoint * NUM_POINTS) / tElapsed);
+    for (point = 0; point < NUM_POINTS; point++) {
+        uint64_t decoded = 0;
+        uint64_t falseFrames = 0;
+        uint64_t softDecoded = 0;
+        uint64_t softFalse = 0;
+
+        for (size_t chunk = 0; chunk < _numChunks; chunk++) {
+            decoded += _results[(point * _numChunks) + chunk].decoded;
+            falseFrames += _results[(point * _numChunks) + chunk].falseFrames;
+            softDecoded += _results[(point * _numChunks) + chunk].softDecoded;
+            softFalse += _results[(point * _numChunks) + chunk].softFalse;
+        }
+        printf("    {\"jitter_us\": %.0f, \"noise_per_s\": %.0f, \"decoded\": %llu, "
+               "\"success_rate\": %.6f, \"false_frames\": %llu, \"soft_decoded\": %llu, "
+               "\"soft_false\": %llu}%s\n",
+               _points[point].jitter, _points[point].noiseRate, (unsigned long long)decoded,
+               (double)decoded / framesPerPoint, (unsigned long long)falseFrames,
+               (unsigned long long)softDecoded, (unsigned long long)softFalse,
+               (point + 1 < NUM_POINTS) ? "," : "");
+    }
+    printf("  ]\n}\n");
+
+    free(threads);
+    free(_results);
+
+    return windowsOk ? EXIT_SUCCESS : EXIT_FAILURE;
+}
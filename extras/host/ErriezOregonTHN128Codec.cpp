@@ -0,0 +1,175 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Codec.cpp
+ * \brief Oregon THN128 constexpr codec verification
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      Proves at compile time that every reading with rolling address 0..7, channel 1..3,
+ *      temperature -999..999 and both low battery states round-trips through the constexpr codec
+ *      of ErriezOregonTHN128Codec.h. At run time, the constexpr functions are compared with the C
+ *      codec for all readings and for random raw words. The result is written as JSON to stdout.
+ *      Exits with 1 on a mismatch.
+ *
+ *      Build and run on a Linux host from the repository root:
+ *
+ *      gcc -O2 -c -Isrc src/ErriezOregonTHN128.c
+ *      g++ -O2 -std=c++11 -Isrc ErriezOregonTHN128.o extras/host/ErriezOregonTHN128Codec.cpp \
+ *          -o codec
+ *      ./codec > codec.json
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ErriezOregonTHN128.h"
+#include "ErriezOregonTHN128Codec.h"
+
+/*! Number of random raw words */
+#define NUM_WORDS           (1UL << 24)
+
+using namespace OregonTHN128;
+
+/*!
+ * \brief Decoded fields equal the encoded reading
+ */
+constexpr bool sameFields(const OregonTHN128Data_t &data, uint8_t rol, uint8_t ch, int16_t temp,
+                          bool lowBat)
+{
+    return (data.rollingAddress == rol) && (data.channel == ch) && (data.temperature == temp) &&
+           (data.lowBattery == lowBat) && checkCrc(data.rawData) && isPlausible(data.rawData);
+}
+
+/*!
+ * \brief Reading round-trips with a valid checksum and plausible fields
+ */
+constexpr bool roundTrip(uint8_t rol, uint8_t ch, int16_t temp, bool lowBat)
+{
+    return sameFields(rawToData(encode(rol, ch, temp, lowBat)), rol, ch, temp, lowBat);
+}
+
+/*!
+ * \brief All rolling addresses of a channel, temperature and low battery state
+ */
+constexpr bool roundTripSensors(uint8_t ch, int16_t temp, bool lowBat, uint8_t rol = 0)
+{
+    return (rol > 7) || (roundTrip(rol, ch, temp, lowBat) &&
+                         roundTripSensors(ch, temp, lowBat, (uint8_t)(rol + 1)));
+}
+
+/*!
+ * \brief All readings of temperatures lo..hi - 1, split in halves to limit the recursion depth
+ */
+constexpr bool roundTripRange(uint8_t ch, bool lowBat, int16_t lo, int16_t hi)
+{
+    return ((hi - lo) == 1) ? roundTripSensors(ch, lo, lowBat) :
+           (roundTripRange(ch, lowBat, lo, (int16_t)((lo + hi) / 2)) &&
+            roundTripRange(ch, lowBat, (int16_t)((lo + hi) / 2), hi));
+}
+
+/* One evaluation per channel and low battery state, within the compiler operation limit */
+static_assert(roundTripRange(1, false, -999, 1000), "Constexpr codec round-trip channel 1");
+static_assert(roundTripRange(2, false, -999, 1000), "Constexpr codec round-trip channel 2");
+static_assert(roundTripRange(3, false, -999, 1000), "Constexpr codec round-trip channel 3");
+static_assert(roundTripRange(1, true, -999, 1000), "Constexpr codec round-trip channel 1 low bat");
+static_assert(roundTripRange(2, true, -999, 1000), "Constexpr codec round-trip channel 2 low bat");
+static_assert(roundTripRange(3, true, -999, 1000), "Constexpr codec round-trip channel 3 low bat");
+
+/*!
+ * \brief Pseudo random generator (xorshift32)
+ */
+static uint32_t random32(uint32_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+
+    return *state;
+}
+
+/*!
+ * \brief Compare constexpr and C conversion of raw data
+ * \return
+ *      true: equal
+ */
+static bool sameRawToData(uint32_t rawData)
+{
+    OregonTHN128Data_t c;
+    OregonTHN128Data_t cpp = rawToData(rawData);
+    bool crc = OregonTHN128_RawToData(rawData, &c);
+
+    return (crc == checkCrc(rawData)) && (crc == OregonTHN128_CheckCRC(rawData)) &&
+           (isPlausible(rawData) == OregonTHN128_IsPlausible(rawData)) &&
+           (c.rawData == cpp.rawData) && (c.rollingAddress == cpp.rollingAddress) &&
+           (c.channel == cpp.channel) && (c.temperature == cpp.temperature) &&
+           (c.lowBattery == cpp.lowBattery);
+}
+
+int main(void)
+{
+    OregonTHN128Data_t data;
+    uint32_t readings = 0;
+    uint32_t mismatches = 0;
+    uint32_t state = 0x12345678;
+    uint32_t rawData;
+
+    /* All readings: constexpr encode equals OregonTHN128_DataToRaw() */
+    for (int16_t temp = -999; temp <= 999; temp++) {
+        for (uint8_t ch = 1; ch <= 3; ch++) {
+            for (uint8_t rol = 0; rol <= 7; rol++) {
+                for (uint8_t lowBat = 0; lowBat <= 1; lowBat++) {
+                    data.rawData = 0;
+                    data.rollingAddress = rol;
+                    data.channel = ch;
+                    data.temperature = temp;
+                    data.lowBattery = lowBat;
+                    rawData = OregonTHN128_DataToRaw(&data);
+                    if ((rawData != dataToRaw(data)) || !sameRawToData(rawData)) {
+                        if (mismatches++ == 0) {
+                            fprintf(stderr, "Encode mismatch: 0x%08x\n", rawData);
+                        }
+                    }
+                    readings++;
+                }
+            }
+        }
+    }
+
+    /* Random raw words, including invalid checksums and non-BCD digits */
+    for (uint32_t i = 0; i < NUM_WORDS; i++) {
+        rawData = random32(&state);
+        if (!sameRawToData(rawData) || !sameRawToData(withChecksum(rawData & 0xffffff))) {
+            if (mismatches++ == 0) {
+                fprintf(stderr, "Decode mismatch: 0x%08x\n", rawData);
+            }
+        }
+    }
+
+    printf("{\n  \"readings\": %u,\n  \"random_words\": %lu,\n  \"mismatches\": %u\n}\n",
+           readings, NUM_WORDS * 2, mismatches);
+
+    return (mismatches == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
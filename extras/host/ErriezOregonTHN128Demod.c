@@ -0,0 +1,828 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Demod.c
+ * \brief Oregon THN128 OOK demodulator for SDR magnitude samples
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      Slices a stream of unsigned 8 or 16-bit magnitude samples from an SDR receiver into edges
+ *      for the library decoder, instead of the digital output of a 433MHz receiver module.
+ *      8-bit samples are scaled to 16-bit.
+ *
+ *      Samples are processed in blocks of 64. The high and low envelope follow the block maximum
+ *      and minimum immediately and decay towards each other with time constants of
+ *      DEMOD_HIGH_DECAY_MS and DEMOD_LOW_DECAY_MS. The slicer switches to high above the middle
+ *      plus 1/8 of the envelope span and to low below the middle minus 1/8. The noise is estimated
+ *      from the smallest recent block span, blocks without an edge. The output stays low while
+ *      the envelope span is below the squelch level (-m) or 3 times the noise, for example between
+ *      transmissions: above 8/3 times the noise, noise cannot cross the hysteresis.
+ *
+ *      The kernels calculate the block minimum and maximum and a bit mask of samples above and
+ *      below the thresholds with SSE2 or AVX2, selected at run time. The hysteresis is applied by
+ *      scanning the bit masks, which costs one bit scan per edge instead of a compare per sample.
+ *
+ *      Output: one JSON line per reading, repeated frames removed. With -e the edges are written
+ *      to stdout in the bin format of ErriezOregonTHN128Gateway.c instead:
+ *      ./demod -e samples.u8 | ./gateway -
+ *
+ *      Benchmark (-g transmissions): generates transmissions with fading and noise at the sample
+ *      rate, then demodulates and decodes them with each kernel. Reports samples per second, the
+ *      headroom over the sample rate and the decoded frames. With -w file the samples are written
+ *      instead.
+ *
+ *      Build and run on a Linux host from the repository root:
+ *
+ *      gcc -O2 -Isrc src/ErriezOregonTHN128.c src/ErriezOregonTHN128Decoder.c \
+ *          src/ErriezOregonTHN128Encoder.c src/ErriezOregonTHN128Dedup.c \
+ *          extras/host/ErriezOregonTHN128Demod.c -o demod -lm
+ *      ./demod [-b 8|16] [-r sample rate] [-m squelch] [-e] <file|->
+ *      ./demod -g transmissions [-b 8|16] [-r sample rate] [-n noise] [-w file]
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "ErriezOregonTHN128.h"
+#include "ErriezOregonTHN128Decoder.h"
+#include "ErriezOregonTHN128Dedup.h"
+#include "ErriezOregonTHN128Encoder.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+/*! SSE2 and AVX2 kernels available */
+#define DEMOD_X86           1
+#else
+#define DEMOD_X86           0
+#endif
+
+/*! Samples per block */
+#define BLOCK               64
+
+/*! Samples per read */
+#define READ_SAMPLES        (BLOCK * 1024)
+
+/*! High envelope decay time constant in ms */
+#define DEMOD_HIGH_DECAY_MS 10
+
+/*! Low envelope decay time constant in ms */
+#define DEMOD_LOW_DECAY_MS  50
+
+/*! Default squelch: minimum envelope span */
+#define DEMOD_SQUELCH       0x1000
+
+/*! Benchmark idle time before, between and after transmissions in us */
+#define T_IDLE_US           200000
+
+/*! Minimum benchmark time per kernel in s */
+#define T_MEASURE_MIN_S     0.5
+
+/*!
+ * \brief Slicer kernel
+ */
+typedef struct {
+    const char *name;                                       /*!< Kernel name */
+    bool (*supported)(void);                                /*!< CPU supports the kernel */
+    void (*minMax)(const uint16_t *s, uint16_t *min, uint16_t *max); /*!< Block min and max */
+    void (*masks)(const uint16_t *s, uint16_t thHigh, uint16_t thLow,
+                  uint64_t *above, uint64_t *below);        /*!< Samples > thHigh and < thLow */
+} Kernel_t;
+
+/*!
+ * \brief Edge output function
+ */
+typedef void (*EdgeOut_t)(void *arg, uint8_t level, uint32_t durationUs, uint64_t sample);
+
+/*!
+ * \brief Demodulator state
+ */
+typedef struct {
+    const Kernel_t *kernel;     /*!< Slicer kernel */
+    uint32_t rate;              /*!< Sample rate in Hz */
+    uint16_t squelch;           /*!< Minimum envelope span */
+    uint8_t highShift;          /*!< High envelope decay per block: span >> highShift */
+    uint8_t lowShift;           /*!< Low envelope decay per block: span >> lowShift */
+    uint16_t high;              /*!< High envelope */
+    uint16_t low;               /*!< Low envelope */
+    uint16_t noise;             /*!< Noise estimate: smallest recent block span */
+    uint8_t level;              /*!< Sliced level */
+    uint64_t sample;            /*!< Index of the next block */
+    uint64_t lastEdge;          /*!< Sample index of the last edge */
+    EdgeOut_t edgeOut;          /*!< Edge output */
+    void *arg;                  /*!< Edge output argument */
+} Demod_t;
+
+/*!
+ * \brief Decode state of the edge output
+ */
+typedef struct {
+    OregonTHN128Decoder_t dec;  /*!< Decoder */
+    OregonTHN128Dedup_t dedup;  /*!< Repeated frame filter */
+    uint32_t tLevel;            /*!< Level duration including ignored glitches in us */
+    uint32_t rate;              /*!< Sample rate in Hz */
+    bool print;                 /*!< Write JSON lines */
+    uint64_t edges;             /*!< Edges */
+    uint64_t frames;            /*!< Frames with a valid checksum */
+    uint64_t readings;          /*!< Frames after the repeated frame filter */
+    uint64_t hash;              /*!< Hash of all edges to compare kernels */
+} Decode_t;
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                          Kernels                                               */
+/*------------------------------------------------------------------------------------------------*/
+static bool scalarSupported(void)
+{
+    return true;
+}
+
+static void scalarMinMax(const uint16_t *s, uint16_t *min, uint16_t *max)
+{
+    uint16_t lo = 0xffff;
+    uint16_t hi = 0;
+
+    for (int i = 0; i < BLOCK; i++) {
+        lo = (s[i] < lo) ? s[i] : lo;
+        hi = (s[i] > hi) ? s[i] : hi;
+    }
+    *min = lo;
+    *max = hi;
+}
+
+static void scalarMasks(const uint16_t *s, uint16_t thHigh, uint16_t thLow, uint64_t *above,
+                        uint64_t *below)
+{
+    uint64_t a = 0;
+    uint64_t b = 0;
+
+    for (int i = 0; i < BLOCK; i++) {
+        a |= (uint64_t)(s[i] > thHigh) << i;
+        b |= (uint64_t)(s[i] < thLow) << i;
+    }
+    *above = a;
+    *below = b;
+}
+
+#if DEMOD_X86
+/*
+ * SSE2 and AVX2 have signed 16-bit compares only: samples and thresholds are biased by 0x8000.
+ */
+static bool sse2Supported(void)
+{
+    return __builtin_cpu_supports("sse2");
+}
+
+/*!
+ * \brief Horizontal min and max of 8 biased samples
+ */
+__attribute__((target("sse2")))
+static void sse2Reduce(__m128i lo, __m128i hi, uint16_t *min, uint16_t *max)
+{
+    lo = _mm_min_epi16(lo, _mm_srli_si128(lo, 8));
+    hi = _mm_max_epi16(hi, _mm_srli_si128(hi, 8));
+    lo = _mm_min_epi16(lo, _mm_srli_si128(lo, 4));
+    hi = _mm_max_epi16(hi, _mm_srli_si128(hi, 4));
+    lo = _mm_min_epi16(lo, _mm_srli_si128(lo, 2));
+    hi = _mm_max_epi16(hi, _mm_srli_si128(hi, 2));
+    *min = (uint16_t)(_mm_cvtsi128_si32(lo) ^ 0x8000);
+    *max = (uint16_t)(_mm_cvtsi128_si32(hi) ^ 0x8000);
+}
+
+__attribute__((target("sse2")))
+static void sse2MinMax(const uint16_t *s, uint16_t *min, uint16_t *max)
+{
+    const __m128i bias = _mm_set1_epi16((short)0x8000);
+    __m128i lo = _mm_set1_epi16(0x7fff);
+    __m128i hi = _mm_set1_epi16((short)0x8000);
+    __m128i v;
+
+    for (int i = 0; i < BLOCK; i += 8) {
+        v = _mm_xor_si128(_mm_loadu_si128((const __m128i *)&s[i]), bias);
+        lo = _mm_min_epi16(lo, v);
+        hi = _mm_max_epi16(hi, v);
+    }
+
+    sse2Reduce(lo, hi, min, max);
+}
+
+__attribute__((target("sse2")))
+static void sse2Masks(const uint16_t *s, uint16_t thHigh, uint16_t thLow, uint64_t *above,
+                      uint64_t *below)
+{
+    const __m128i bias = _mm_set1_epi16((short)0x8000);
+    const __m128i h = _mm_set1_epi16((short)(thHigh ^ 0x8000));
+    const __m128i l = _mm_set1_epi16((short)(thLow ^ 0x8000));
+    uint64_t a = 0;
+    uint64_t b = 0;
+    __m128i v0;
+    __m128i v1;
+
+    for (int i = 0; i < BLOCK; i += 16) {
+        v0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)&s[i]), bias);
+        v1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)&s[i + 8]), bias);
+
+        /* Pack two compare results to one bit per sample */
+        a |= (uint64_t)(uint16_t)_mm_movemask_epi8(
+                 _mm_packs_epi16(_mm_cmpgt_epi16(v0, h), _mm_cmpgt_epi16(v1, h))) << i;
+        b |= (uint64_t)(uint16_t)_mm_movemask_epi8(
+                 _mm_packs_epi16(_mm_cmplt_epi16(v0, l), _mm_cmplt_epi16(v1, l))) << i;
+    }
+    *above = a;
+    *below = b;
+}
+
+static bool avx2Supported(void)
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+__attribute__((target("avx2")))
+static void avx2MinMax(const uint16_t *s, uint16_t *min, uint16_t *max)
+{
+    const __m256i bias = _mm256_set1_epi16((short)0x8000);
+    __m256i lo = _mm256_set1_epi16(0x7fff);
+    __m256i hi = _mm256_set1_epi16((short)0x8000);
+    __m256i v;
+
+    for (int i = 0; i < BLOCK; i += 16) {
+        v = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)&s[i]), bias);
+        lo = _mm256_min_epi16(lo, v);
+        hi = _mm256_max_epi16(hi, v);
+    }
+
+    sse2Reduce(_mm_min_epi16(_mm256_castsi256_si128(lo), _mm256_extracti128_si256(lo, 1)),
+               _mm_max_epi16(_mm256_castsi256_si128(hi), _mm256_extracti128_si256(hi, 1)),
+               min, max);
+}
+
+__attribute__((target("avx2")))
+static void avx2Masks(const uint16_t *s, uint16_t thHigh, uint16_t thLow, uint64_t *above,
+                      uint64_t *below)
+{
+    const __m256i bias = _mm256_set1_epi16((short)0x8000);
+    const __m256i h = _mm256_set1_epi16((short)(thHigh ^ 0x8000));
+    const __m256i l = _mm256_set1_epi16((short)(thLow ^ 0x8000));
+    uint64_t a = 0;
+    uint64_t b = 0;
+    __m256i v0;
+    __m256i v1;
+
+    for (int i = 0; i < BLOCK; i += 32) {
+        v0 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)&s[i]), bias);
+        v1 = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)&s[i + 16]), bias);
+
+        /* Pack interleaves the 128-bit lanes: restore sample order before the bit mask */
+        a |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_permute4x64_epi64(
+                 _mm256_packs_epi16(_mm256_cmpgt_epi16(v0, h), _mm256_cmpgt_epi16(v1, h)),
+                 0xd8)) << i;
+        b |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_permute4x64_epi64(
+                 _mm256_packs_epi16(_mm256_cmpgt_epi16(l, v0), _mm256_cmpgt_epi16(l, v1)),
+                 0xd8)) << i;
+    }
+    *above = a;
+    *below = b;
+}
+#endif
+
+/*! Kernels, fastest last */
+static const Kernel_t _kernels[] = {
+    { "scalar", scalarSupported, scalarMinMax, scalarMasks },
+#if DEMOD_X86
+    { "sse2", sse2Supported, sse2MinMax, sse2Masks },
+    { "avx2", avx2Supported, avx2MinMax, avx2Masks },
+#endif
+};
+
+/*! Number of kernels */
+#define NUM_KERNELS         (sizeof(_kernels) / sizeof(_kernels[0]))
+
+/*!
+ * \brief Fastest kernel supported by the CPU
+ */
+static const Kernel_t *bestKernel(void)
+{
+    const Kernel_t *kernel = &_kernels[0];
+
+    for (size_t i = 1; i < NUM_KERNELS; i++) {
+        if (_kernels[i].supported()) {
+            kernel = &_kernels[i];
+        }
+    }
+
+    return kernel;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                        Demodulator                                             */
+/*------------------------------------------------------------------------------------------------*/
+/*!
+ * \brief Envelope decay shift for a time constant
+ */
+static uint8_t decayShift(uint32_t rate, uint32_t tMs)
+{
+    double blocks = (double)rate * tMs / 1000.0 / BLOCK;
+    uint8_t shift = 1;
+
+    while ((shift < 15) && ((double)(1UL << (shift + 1)) <= blocks)) {
+        shift++;
+    }
+
+    return shift;
+}
+
+/*!
+ * \brief Initialize demodulator
+ */
+static void demodInit(Demod_t *demod, const Kernel_t *kernel, uint32_t rate, uint16_t squelch,
+                      EdgeOut_t edgeOut, void *arg)
+{
+    memset(demod, 0, sizeof(Demod_t));
+    demod->kernel = kernel;
+    demod->rate = rate;
+    demod->squelch = squelch;
+    demod->highShift = decayShift(rate, DEMOD_HIGH_DECAY_MS);
+    demod->lowShift = decayShift(rate, DEMOD_LOW_DECAY_MS);
+    demod->low = 0xffff;
+    demod->noise = 0xffff;
+    demod->edgeOut = edgeOut;
+    demod->arg = arg;
+}
+
+/*!
+ * \brief Output an edge at a sample index
+ */
+static void demodEdge(Demod_t *demod, uint64_t sample)
+{
+    uint64_t durationUs = ((sample - demod->lastEdge) * 1000000ULL) / demod->rate;
+
+    demod->edgeOut(demod->arg, demod->level,
+                   (durationUs > 0xffffffffULL) ? 0xffffffffUL : (uint32_t)durationUs, sample);
+    demod->lastEdge = sample;
+    demod->level ^= 1;
+}
+
+/*!
+ * \brief Demodulate blocks of samples
+ * \param s
+ *      Samples
+ * \param numBlocks
+ *      Number of blocks of BLOCK samples
+ */
+static void demodBlocks(Demod_t *demod, const uint16_t *s, size_t numBlocks)
+{
+    uint16_t min;
+    uint16_t max;
+    uint16_t span;
+    uint16_t thHigh;
+    uint16_t thLow;
+    uint64_t above;
+    uint64_t below;
+    uint64_t pending;
+    int pos;
+
+    for (size_t n = 0; n < numBlocks; n++, s += BLOCK, demod->sample += BLOCK) {
+        /* Envelope: immediate attack, exponential decay */
+        demod->kernel->minMax(s, &min, &max);
+        if (max > demod->high) {
+            demod->high = max;
+        }
+        if (min < demod->low) {
+            demod->low = min;
+        }
+        span = demod->high - demod->low;
+        demod->high -= span >> demod->highShift;
+        demod->low += span >> demod->lowShift;
+
+        /* Noise: blocks without edge have the span of the noise, slowly forget smaller spans */
+        if ((uint16_t)(max - min) < demod->noise) {
+            demod->noise = max - min;
+        } else if (demod->noise < 0x8000) {
+            demod->noise += (demod->noise >> 4) + 1;
+        }
+
+        if ((span < demod->squelch) || (span < (2UL * demod->noise))) {
+            /* Squelch: all samples below the low threshold */
+            thHigh = 0xffff;
+            thLow = 0xffff;
+        } else {
+            thHigh = demod->low + (span / 2) + (span / 8);
+            thLow = demod->low + (span / 2) - (span / 8);
+        }
+        demod->kernel->masks(s, thHigh, thLow, &above, &below);
+
+        /* Hysteresis: next sample above the high threshold when low, below the low when high */
+        pos = 0;
+        for (;;) {
+            pending = (demod->level ? below : above) & (~0ULL << pos);
+            if (pending == 0) {
+                break;
+            }
+            pos = __builtin_ctzll(pending);
+            demodEdge(demod, demod->sample + (uint64_t)pos);
+            if (pos == (BLOCK - 1)) {
+                break;
+            }
+            pos++;
+        }
+    }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                        Edge outputs                                            */
+/*------------------------------------------------------------------------------------------------*/
+/*!
+ * \brief Decode edge with the same glitch filter as the interrupt handler
+ */
+static void decodeEdge(void *arg, uint8_t level, uint32_t durationUs, uint64_t sample)
+{
+    Decode_t *d = (Decode_t *)arg;
+    OregonTHN128Data_t data;
+    uint32_t tMs = (uint32_t)((sample * 1000ULL) / d->rate);
+    char temperature[8];
+    uint32_t rawData;
+
+    d->edges++;
+    d->hash = (d->hash ^ sample) * 0x100000001b3ULL;
+
+    /* Ignore short pulses and add them to the next level */
+    d->tLevel += durationUs;
+    if (d->tLevel < T_RX_TOLERANCE_US) {
+        return;
+    }
+
+    if (OregonTHN128_DecodeEdge(&d->dec, (d->tLevel > 0xffff) ? 0xffff : (uint16_t)d->tLevel,
+                                level, &rawData)) {
+        d->frames++;
+        if (!OregonTHN128_DedupFilter(&d->dedup, rawData, tMs)) {
+            d->readings++;
+            if (d->print) {
+                OregonTHN128_RawToData(rawData, &data);
+                OregonTHN128_TempAppendJson(temperature, sizeof(temperature), data.temperature);
+                printf("{\"time_ms\": %lu, \"raw\": \"0x%08lx\", \"rolling_address\": %u, "
+                       "\"channel\": %u, \"temperature\": %s, \"low_battery\": %s}\n",
+                       (unsigned long)tMs, (unsigned long)rawData, data.rollingAddress,
+                       data.channel, temperature, data.lowBattery ? "true" : "false");
+            }
+        }
+    }
+    d->dec.crcError = false;
+    d->tLevel = 0;
+}
+
+/*!
+ * \brief Write edge in ErriezOregonTHN128Gateway.c bin format
+ */
+static void writeEdge(void *arg, uint8_t level, uint32_t durationUs, uint64_t sample)
+{
+    uint32_t *tEdge = (uint32_t *)arg;
+    uint32_t word;
+
+    (void)sample;
+
+    /* Edge time and level after the edge */
+    *tEdge += durationUs;
+    word = (*tEdge & 0x7fffffffUL) | ((uint32_t)(level ? 0 : 1) << 31);
+    fwrite(&word, sizeof(word), 1, stdout);
+}
+
+/*!
+ * \brief Initialize decode state
+ */
+static void decodeInit(Decode_t *d, uint32_t rate, bool print)
+{
+    memset(d, 0, sizeof(Decode_t));
+    OregonTHN128_DecoderInit(&d->dec);
+    OregonTHN128_DedupInit(&d->dedup, OREGON_THN128_DEDUP_WINDOW_MS);
+    d->rate = rate;
+    d->print = print;
+    d->hash = 0xcbf29ce484222325ULL;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                           Input                                                */
+/*------------------------------------------------------------------------------------------------*/
+/*!
+ * \brief Demodulate a sample file or stdin
+ */
+static bool demodFile(Demod_t *demod, FILE *file, uint8_t bits)
+{
+    static uint8_t raw[READ_SAMPLES * 2];
+    static uint16_t samples[READ_SAMPLES];
+    size_t sampleSize = bits / 8;
+    size_t bytes = 0;
+    size_t numSamples;
+    size_t n;
+
+    for (;;) {
+        n = fread(raw + bytes, 1, sizeof(raw) - bytes, file);
+        bytes += n;
+        numSamples = bytes / sampleSize;
+
+        /* Pad the last block with the last sample */
+        if ((n == 0) && (numSamples % BLOCK)) {
+            for (size_t i = numSamples; i % BLOCK; i++) {
+                memcpy(raw + (i * sampleSize), raw + ((numSamples - 1) * sampleSize), sampleSize);
+            }
+            numSamples += BLOCK - (numSamples % BLOCK);
+        }
+        numSamples -= numSamples % BLOCK;
+
+        /* 8-bit samples scaled to 16-bit, 16-bit samples little endian */
+        for (size_t i = 0; i < numSamples; i++) {
+            samples[i] = (bits == 8) ? (uint16_t)(raw[i] << 8) :
+                                       (uint16_t)(raw[2 * i] | (raw[(2 * i) + 1] << 8));
+        }
+        demodBlocks(demod, samples, numSamples / BLOCK);
+
+        bytes -= numSamples * sampleSize;
+        memmove(raw, raw + (numSamples * sampleSize), bytes);
+        if (n == 0) {
+            break;
+        }
+    }
+
+    return !ferror(file);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                         Benchmark                                              */
+/*------------------------------------------------------------------------------------------------*/
+/*!
+ * \brief Pseudo random generator (xorshift64*)
+ */
+static uint64_t random64(uint64_t *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+
+    return *state * 0x2545f4914f6cdd1dULL;
+}
+
+/*!
+ * \brief Gaussian noise with standard deviation 1: sum of 4 uniform numbers
+ */
+static double noise(uint64_t *rng)
+{
+    double sum = 0;
+
+    for (int i = 0; i < 4; i++) {
+        sum += (double)(random64(rng) >> 11) / 9007199254740992.0;
+    }
+
+    return (sum - 2.0) * 1.7320508;
+}
+
+/*!
+ * \brief Append samples of a level
+ */
+static void generateLevel(uint16_t *samples, size_t *n, double *tFrac, uint8_t level,
+                          uint32_t durationUs, uint32_t rate, double amplitude, double sigma,
+                          uint64_t *rng)
+{
+    double exact = ((double)durationUs * rate / 1e6) + *tFrac;
+    size_t count = (size_t)exact;
+    double value;
+
+    *tFrac = exact - (double)count;
+    for (size_t i = 0; i < count; i++) {
+        value = 0x1000 + (level ? amplitude : 0) + (noise(rng) * sigma);
+        samples[(*n)++] = (value < 0) ? 0 : (value > 0xffff) ? 0xffff : (uint16_t)value;
+    }
+}
+
+/*!
+ * \brief Generate transmissions of two copies with fading between 25% and 75% full scale
+ * \return
+ *      Number of samples, a multiple of BLOCK
+ */
+static size_t generate(uint16_t **samples, uint32_t transmissions, uint32_t rate, double sigma,
+                       uint8_t bits)
+{
+    OregonTHN128Encoder_t enc;
+    OregonTHN128Data_t data = { 0, 7, 1, 207, 0 };
+    uint64_t rng = 0x9e3779b97f4a7c15ULL;
+    double tFrac = 0;
+    double amplitude;
+    size_t maxSamples;
+    size_t n = 0;
+    uint32_t duration;
+    uint8_t level;
+
+    /* Transmission of two frames is below 400 ms */
+    maxSamples = (size_t)(((double)transmissions * 0.4 + ((transmissions + 1) * T_IDLE_US * 1e-6)) *
+                          rate) + BLOCK;
+    *samples = malloc(maxSamples * sizeof(uint16_t));
+    if (*samples == NULL) {
+        return 0;
+    }
+
+    generateLevel(*samples, &n, &tFrac, 0, T_IDLE_US, rate, 0, sigma, &rng);
+    for (uint32_t t = 0; t < transmissions; t++) {
+        amplitude = (0.5 + (0.25 * sin(t * 0.7))) * 0xc000;
+        data.temperature = (int16_t)((t % 400) - 100);
+        data.channel = (uint8_t)((t % 3) + 1);
+        OregonTHN128_EncoderInit(&enc, OregonTHN128_DataToRaw(&data), 2);
+        while (OregonTHN128_EncoderNext(&enc, &level, &duration)) {
+            generateLevel(*samples, &n, &tFrac, level, duration, rate, amplitude, sigma, &rng);
+        }
+        generateLevel(*samples, &n, &tFrac, 0, T_IDLE_US, rate, 0, sigma, &rng);
+    }
+
+    /* Quantize 8-bit samples */
+    for (size_t i = 0; (bits == 8) && (i < n); i++) {
+        (*samples)[i] &= 0xff00;
+    }
+
+    return n - (n % BLOCK);
+}
+
+/*!
+ * \brief Get monotonic time in seconds
+ */
+static double timeNow(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + (ts.tv_nsec * 1e-9);
+}
+
+/*!
+ * \brief Demodulate and decode the generated samples with each kernel
+ */
+static bool benchmark(const uint16_t *samples, size_t numSamples, uint32_t transmissions,
+                      uint32_t rate, uint16_t squelch, uint8_t bits, double sigma)
+{
+    Demod_t demod;
+    Decode_t d;
+    Decode_t ref;
+    double tStart;
+    double tElapsed;
+    double sps;
+    uint32_t runs;
+    bool pass = true;
+
+    printf("{\n  \"sample_rate\": %lu,\n  \"bits\": %u,\n  \"noise\": %.0f,\n"
+           "  \"samples\": %zu,\n  \"transmissions\": %lu,\n  \"kernels\": [\n",
+           (unsigned long)rate, bits, sigma, numSamples, (unsigned long)transmissions);
+
+    for (size_t k = 0; k < NUM_KERNELS; k++) {
+        if (!_kernels[k].supported()) {
+            continue;
+        }
+
+        runs = 0;
+        tStart = timeNow();
+        do {
+            decodeInit(&d, rate, false);
+            demodInit(&demod, &_kernels[k], rate, squelch, decodeEdge, &d);
+            demodBlocks(&demod, samples, numSamples / BLOCK);
+            runs++;
+            tElapsed = timeNow() - tStart;
+        } while (tElapsed < T_MEASURE_MIN_S);
+        sps = (double)numSamples * runs / tElapsed;
+
+        /* All kernels must find the same edges */
+        if (k == 0) {
+            ref = d;
+        }
+        pass = pass && (d.hash == ref.hash) && (d.readings == transmissions);
+
+        printf("    {\"kernel\": \"%s\", \"msps\": %.1f, \"headroom\": %.1f, \"edges\": %llu, "
+               "\"frames\": %llu, \"readings\": %llu, \"same_edges\": %s}%s\n",
+               _kernels[k].name, sps * 1e-6, sps / rate, (unsigned long long)d.edges,
+               (unsigned long long)d.frames, (unsigned long long)d.readings,
+               (d.hash == ref.hash) ? "true" : "false",
+               ((k + 1 < NUM_KERNELS) && _kernels[k + 1].supported()) ? "," : "");
+    }
+    printf("  ],\n  \"pass\": %s\n}\n", pass ? "true" : "false");
+
+    return pass;
+}
+
+int main(int argc, char *argv[])
+{
+    uint16_t *samples;
+    size_t numSamples;
+    uint32_t rate = 1000000;
+    uint16_t squelch = DEMOD_SQUELCH;
+    uint32_t transmissions = 0;
+    uint32_t tEdge = 0;
+    double sigma = 0x0400;
+    const char *writeFile = NULL;
+    bool writeEdges = false;
+    uint8_t bits = 8;
+    Demod_t demod;
+    Decode_t d;
+    FILE *file;
+    bool ok;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:r:m:eg:n:w:")) != -1) {
+        switch (opt) {
+            case 'b': bits = (uint8_t)strtoul(optarg, NULL, 0); break;
+            case 'r': rate = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'm': squelch = (uint16_t)strtoul(optarg, NULL, 0); break;
+            case 'e': writeEdges = true; break;
+            case 'g': transmissions = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'n': sigma = strtod(optarg, NULL); break;
+            case 'w': writeFile = optarg; break;
+            default:
+                fprintf(stderr, "Usage: %s [-b 8|16] [-r sample rate] [-m squelch] [-e] <file|->\n"
+                        "       %s -g transmissions [-b 8|16] [-r sample rate] [-n noise] "
+                        "[-w file]\n", argv[0], argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (((bits != 8) && (bits != 16)) || (rate < 10000) ||
+        (!transmissions && (optind >= argc))) {
+        fprintf(stderr, "Invalid argument\n");
+        return EXIT_FAILURE;
+    }
+
+    if (transmissions) {
+        numSamples = generate(&samples, transmissions, rate, sigma, bits);
+        if (numSamples == 0) {
+            fprintf(stderr, "Out of memory\n");
+            return EXIT_FAILURE;
+        }
+
+        if (writeFile) {
+            file = fopen(writeFile, "wb");
+            if (file == NULL) {
+                perror(writeFile);
+                return EXIT_FAILURE;
+            }
+            for (size_t i = 0; i < numSamples; i++) {
+                if (bits == 8) {
+                    fputc(samples[i] >> 8, file);
+                } else {
+                    fputc(samples[i] & 0xff, file);
+                    fputc(samples[i] >> 8, file);
+                }
+            }
+            fclose(file);
+            ok = true;
+        } else {
+            ok = benchmark(samples, numSamples, transmissions, rate, squelch, bits, sigma);
+        }
+        free(samples);
+
+        return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if (strcmp(argv[optind], "-") == 0) {
+        file = stdin;
+    } else {
+        file = fopen(argv[optind], "rb");
+        if (file == NULL) {
+            perror(argv[optind]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    decodeInit(&d, rate, true);
+    if (writeEdges) {
+        demodInit(&demod, bestKernel(), rate, squelch, writeEdge, &tEdge);
+    } else {
+        demodInit(&demod, bestKernel(), rate, squelch, decodeEdge, &d);
+    }
+    ok = demodFile(&demod, file, bits);
+    fclose(file);
+
+    if (!writeEdges) {
+        fprintf(stderr, "{\"kernel\": \"%s\", \"samples\": %llu, \"edges\": %llu, "
+                "\"frames\": %llu, \"readings\": %llu}\n", demod.kernel->name,
+                (unsigned long long)demod.sample, (unsigned long long)d.edges,
+                (unsigned long long)d.frames, (unsigned long long)d.readings);
+    }
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
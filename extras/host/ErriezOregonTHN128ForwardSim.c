@@ -0,0 +1,676 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128ForwardSim.c
+ * \brief Oregon THN128 store-and-forward buffer simulation
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      Simulates a gateway with ErriezOregonTHN128Forward.c for days of sensor readings every
+ *      30 seconds:
+ *      - Network outages with a mean uptime of 8 hours and a mean downtime of 2 hours, and
+ *        optionally one long outage from day 2
+ *      - Readings are published directly while the network is up and the buffer is empty, and
+ *        appended otherwise (-a: all readings are appended)
+ *      - The buffer is drained in batches of 10 records while the network is up, 1% of the
+ *        publishes fail
+ *      - Reboots with a mean interval of 2 days. The clock counts from 0 after a reboot until
+ *        the network is up.
+ *      - Power loss during a random write or erase, which programs only a part of the Bytes
+ *        and is followed by a reboot
+ *
+ *      The storage is RAM or a file (-f) with flash semantics: a write clears bits, an erase
+ *      sets a sector to 0xff. The default geometry is the 1408 kB forward partition of the
+ *      ESP32 MQTT example partitions.csv.
+ *
+ *      Every delivered record is compared with the appended records. Records appended during a
+ *      power loss are lost. Records consumed during a power loss may be delivered twice.
+ *      The summary is written as JSON to stdout. Exits with 1 when a record is delivered out of
+ *      order or corrupted, when the number of missing records is not the number of dropped
+ *      records (less records delivered before a power loss), or when a write would set a bit.
+ *
+ *      Build and run on a Linux host from the repository root:
+ *
+ *      gcc -O2 -Isrc src/ErriezOregonTHN128.c src/ErriezOregonTHN128Forward.c \
+ *          extras/host/ErriezOregonTHN128ForwardSim.c -o forwardsim -lm
+ *      ./forwardsim [-d days] [-n sensors] [-N sectors] [-L outage days] [-a] [-f file]
+ */
+
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "ErriezOregonTHN128.h"
+#include "ErriezOregonTHN128Forward.h"
+
+/*! Transmit interval of the sensors in seconds */
+#define T_INTERVAL_S        30
+
+/*! Simulation start time: 2026-01-01 00:00:00 UTC */
+#define T_START             1767225600UL
+
+/*! Seconds per day */
+#define T_DAY_S             86400UL
+
+/*! Mean network uptime and downtime in seconds */
+#define T_UP_MEAN_S         (8 * 3600.0)
+#define T_DOWN_MEAN_S       (2 * 3600.0)
+
+/*! Mean time between reboots in seconds */
+#define T_REBOOT_MEAN_S     (2 * 86400.0)
+
+/*! Mean number of writes and erases between power losses */
+#define POWER_LOSS_MEAN     5000
+
+/*! Records per publish */
+#define BATCH_SIZE          10
+
+/*! Maximum publishes per second */
+#define BATCHES_PER_S       10
+
+/*! Maximum number of sensors */
+#define SENSORS_MAX         OREGON_THN128_SENSOR_KEYS
+
+/*!
+ * \brief File storage backend
+ */
+typedef struct {
+    int fd;                     /*!< File */
+    uint32_t sectorSize;        /*!< Sector size in Bytes */
+    uint32_t violations;        /*!< Writes which would set a bit */
+} FileStorage_t;
+
+/*!
+ * \brief Storage wrapper with power loss
+ */
+typedef struct {
+    const OregonTHN128Storage_t *backend; /*!< Storage */
+    uint64_t rng;               /*!< Random state */
+    uint32_t countdown;         /*!< Operations until the next power loss, 0: none */
+    bool powerLoss;             /*!< Power lost, operations fail until reboot */
+    uint64_t reads;             /*!< Reads */
+    uint64_t writes;            /*!< Writes */
+    uint64_t erases;            /*!< Erases */
+    uint32_t powerLosses;       /*!< Number of power losses */
+} PowerLoss_t;
+
+/*!
+ * \brief Appended record
+ */
+typedef struct {
+    uint32_t timestamp;         /*!< Timestamp */
+    uint32_t rawData;           /*!< Raw data */
+} Record_t;
+
+/*!
+ * \brief Delivered record verification
+ */
+typedef struct {
+    Record_t *appended;         /*!< Appended records */
+    size_t count;               /*!< Number of appended records */
+    size_t capacity;            /*!< Array size */
+    size_t next;                /*!< Next expected record */
+    size_t dupBegin;            /*!< First record which may be delivered again */
+    size_t dupEnd;              /*!< Record after the last which may be delivered again */
+    uint64_t delivered;         /*!< Records delivered from the buffer */
+    uint64_t missing;           /*!< Appended records never delivered */
+    uint64_t duplicates;        /*!< Records delivered again */
+    uint64_t errors;            /*!< Records out of order or corrupted */
+} Verify_t;
+
+/*!
+ * \brief Get monotonic time in seconds
+ */
+static double timeNow(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + (ts.tv_nsec * 1e-9);
+}
+
+/*!
+ * \brief Pseudo random generator (xorshift64*)
+ */
+static uint64_t random64(uint64_t *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+
+    return *state * 0x2545f4914f6cdd1dULL;
+}
+
+/*!
+ * \brief Exponentially distributed random number
+ */
+static double randomExp(uint64_t *state, double mean)
+{
+    return -log(((double)(random64(state) >> 11) + 1.0) / 9007199254740993.0) * mean;
+}
+
+/*!
+ * \brief Read file storage
+ */
+static bool fileRead(void *ctx, uint32_t addr, void *buf, size_t len)
+{
+    return pread(((FileStorage_t *)ctx)->fd, buf, len, addr) == (ssize_t)len;
+}
+
+/*!
+ * \brief Program file storage: bits can only be cleared
+ */
+static bool fileWrite(void *ctx, uint32_t addr, const void *buf, size_t len)
+{
+    FileStorage_t *file = (FileStorage_t *)ctx;
+    const uint8_t *data = (const uint8_t *)buf;
+    uint8_t old[256];
+    size_t i;
+
+    if ((len > sizeof(old)) || (pread(file->fd, old, len, addr) != (ssize_t)len)) {
+        return false;
+    }
+    for (i = 0; i < len; i++) {
+        if (data[i] & (uint8_t)~old[i]) {
+            file->violations++;
+        }
+        old[i] &= data[i];
+    }
+
+    return pwrite(file->fd, old, len, addr) == (ssize_t)len;
+}
+
+/*!
+ * \brief Erase a sector of file storage
+ */
+static bool fileErase(void *ctx, uint32_t addr)
+{
+    FileStorage_t *file = (FileStorage_t *)ctx;
+    uint8_t erased[4096];
+    uint32_t done;
+    uint32_t len;
+
+    memset(erased, 0xff, sizeof(erased));
+    for (done = 0; done < file->sectorSize; done += len) {
+        len = file->sectorSize - done;
+        if (len > sizeof(erased)) {
+            len = sizeof(erased);
+        }
+        if (pwrite(file->fd, erased, len, addr + done) != (ssize_t)len) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Open file storage, a new file is erased
+ */
+static bool fileOpen(OregonTHN128Storage_t *storage, FileStorage_t *file, const char *fileName,
+                     uint32_t sectorSize, uint16_t numSectors)
+{
+    off_t size = (off_t)sectorSize * numSectors;
+    uint16_t sector;
+
+    file->fd = open(fileName, O_RDWR | O_CREAT, 0644);
+    file->sectorSize = sectorSize;
+    file->violations = 0;
+    if (file->fd < 0) {
+        return false;
+    }
+
+    storage->sectorSize = sectorSize;
+    storage->numSectors = numSectors;
+    storage->read = fileRead;
+    storage->write = fileWrite;
+    storage->erase = fileErase;
+    storage->ctx = file;
+
+    if (lseek(file->fd, 0, SEEK_END) != size) {
+        if (ftruncate(file->fd, 0) != 0) {
+            return false;
+        }
+        for (sector = 0; sector < numSectors; sector++) {
+            if (!fileErase(file, (uint32_t)sector * sectorSize)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Schedule the next power loss
+ */
+static void powerLossSchedule(PowerLoss_t *p, bool enable)
+{
+    p->powerLoss = false;
+    p->countdown = enable ? (uint32_t)randomExp(&p->rng, POWER_LOSS_MEAN) + 1 : 0;
+}
+
+/*!
+ * \brief Check for a power loss before an operation
+ */
+static bool powerLossNow(PowerLoss_t *p)
+{
+    if (p->countdown && (--p->countdown == 0)) {
+        p->powerLoss = true;
+        p->powerLosses++;
+        return true;
+    }
+
+    return false;
+}
+
+/*!
+ * \brief Read through the power loss wrapper
+ */
+static bool powerLossRead(void *ctx, uint32_t addr, void *buf, size_t len)
+{
+    PowerLoss_t *p = (PowerLoss_t *)ctx;
+
+    p->reads++;
+
+    return p->backend->read(p->backend->ctx, addr, buf, len);
+}
+
+/*!
+ * \brief Write through the power loss wrapper: a power loss programs a part of the Bytes
+ */
+static bool powerLossWrite(void *ctx, uint32_t addr, const void *buf, size_t len)
+{
+    PowerLoss_t *p = (PowerLoss_t *)ctx;
+
+    if (p->powerLoss) {
+        return false;
+    }
+    p->writes++;
+    if (powerLossNow(p)) {
+        len = (size_t)(random64(&p->rng) % len);
+        if (len) {
+            p->backend->write(p->backend->ctx, addr, buf, len);
+        }
+        return false;
+    }
+
+    return p->backend->write(p->backend->ctx, addr, buf, len);
+}
+
+/*!
+ * \brief Erase through the power loss wrapper: a power loss does not erase
+ */
+static bool powerLossErase(void *ctx, uint32_t addr)
+{
+    PowerLoss_t *p = (PowerLoss_t *)ctx;
+
+    if (p->powerLoss || powerLossNow(p)) {
+        return false;
+    }
+    p->erases++;
+
+    return p->backend->erase(p->backend->ctx, addr);
+}
+
+/*!
+ * \brief Remember an appended record
+ */
+static void verifyAppended(Verify_t *v, uint32_t timestamp, uint32_t rawData)
+{
+    if (v->count == v->capacity) {
+        v->capacity = v->capacity ? (v->capacity * 2) : 65536;
+        v->appended = (Record_t *)realloc(v->appended, v->capacity * sizeof(Record_t));
+        if (v->appended == NULL) {
+            fprintf(stderr, "Out of memory\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    v->appended[v->count].timestamp = timestamp;
+    v->appended[v->count].rawData = rawData;
+    v->count++;
+}
+
+/*!
+ * \brief Check if a delivered record is an appended record
+ */
+static bool recordEqual(const Record_t *a, const OregonTHN128ForwardRecord_t *b)
+{
+    return (a->timestamp == b->timestamp) && (a->rawData == b->rawData);
+}
+
+/*!
+ * \brief Verify a delivered record
+ * \details
+ *      The record must be the next appended record or a later one when records were dropped,
+ *      or a record of a batch consumed during a power loss.
+ * \return
+ *      Index of the appended record, v->count on error
+ */
+static size_t verifyDelivered(Verify_t *v, const OregonTHN128ForwardRecord_t *record)
+{
+    size_t i;
+
+    for (i = v->dupBegin; i < v->dupEnd; i++) {
+        if (recordEqual(&v->appended[i], record)) {
+            v->duplicates++;
+            v->dupBegin = i + 1;
+            return i;
+        }
+    }
+    v->dupBegin = v->dupEnd = 0;
+
+    for (i = v->next; i < v->count; i++) {
+        if (recordEqual(&v->appended[i], record)) {
+            v->missing += i - v->next;
+            v->next = i + 1;
+            v->delivered++;
+            return i;
+        }
+    }
+    v->errors++;
+
+    return v->count;
+}
+
+/*!
+ * \brief Drain the buffer in batches
+ * \return
+ *      false: power loss
+ */
+static bool drain(OregonTHN128Forward_t *fwd, Verify_t *v, uint64_t *rng, uint64_t *publishes)
+{
+    OregonTHN128ForwardRecord_t records[BATCH_SIZE];
+    size_t first;
+    size_t index;
+    size_t n;
+    size_t i;
+    int batch;
+
+    for (batch = 0; (batch < BATCHES_PER_S) && OregonTHN128_ForwardPending(fwd); batch++) {
+        n = OregonTHN128_ForwardPeek(fwd, records, BATCH_SIZE);
+        if ((n == 0) || ((random64(rng) % 100) == 0)) {
+            /* Publish failed */
+            break;
+        }
+        (*publishes)++;
+
+        first = v->next;
+        for (i = 0; i < n; i++) {
+            index = verifyDelivered(v, &records[i]);
+            if (index < first) {
+                first = index;
+            }
+        }
+        if (!OregonTHN128_ForwardConsume(fwd, n)) {
+            /* Records of this batch may be delivered again after the reboot */
+            v->dupBegin = first;
+            v->dupEnd = v->next;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    OregonTHN128Storage_t backend;
+    OregonTHN128Storage_t storage;
+    OregonTHN128RamStorage_t ram;
+    FileStorage_t file;
+    PowerLoss_t powerLoss;
+    OregonTHN128Forward_t fwd;
+    OregonTHN128ForwardStats_t stats;
+    OregonTHN128Data_t data;
+    Verify_t verify;
+    uint8_t *memory = NULL;
+    const char *fileName = NULL;
+    uint32_t sectorSize = 4096;
+    uint16_t numSectors = 352;
+    uint32_t days = 30;
+    uint32_t numSensors = 3;
+    uint32_t longOutageDays = 0;
+    bool appendAll = false;
+    bool powerLossEnable = true;
+    uint64_t rng = 1;
+    uint32_t sensorNext[SENSORS_MAX];
+    uint8_t sensorAddress[SENSORS_MAX];
+    uint32_t t;
+    uint32_t tEnd;
+    uint32_t tBoot;
+    uint32_t tNetwork;
+    uint32_t tReboot;
+    uint32_t timestamp;
+    uint32_t s;
+    bool networkUp = true;
+    bool clockValid = true;
+    bool rebootNow;
+    uint64_t readings = 0;
+    uint64_t direct = 0;
+    uint64_t stored = 0;
+    uint64_t lost = 0;
+    uint64_t dropped = 0;
+    uint64_t publishes = 0;
+    uint64_t reboots = 0;
+    uint64_t maxPending = 0;
+    double tRun;
+    int opt;
+    int ok;
+
+    while ((opt = getopt(argc, argv, "d:n:S:N:L:af:ps:")) != -1) {
+        switch (opt) {
+            case 'd': days = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'n': numSensors = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'S': sectorSize = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'N': numSectors = (uint16_t)strtoul(optarg, NULL, 0); break;
+            case 'L': longOutageDays = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'a': appendAll = true; break;
+            case 'f': fileName = optarg; break;
+            case 'p': powerLossEnable = false; break;
+            case 's': rng = (strtoull(optarg, NULL, 0) << 1) | 1; break;
+            default:
+                fprintf(stderr, "Usage: %s [-d days] [-n sensors] [-S sector size] [-N sectors] "
+                        "[-L outage days] [-a] [-f file] [-p] [-s seed]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if ((days == 0) || (days > 3650) || (numSensors == 0) || (numSensors > SENSORS_MAX)) {
+        fprintf(stderr, "Invalid argument\n");
+        return EXIT_FAILURE;
+    }
+
+    if (fileName) {
+        if (!fileOpen(&backend, &file, fileName, sectorSize, numSectors)) {
+            perror(fileName);
+            return EXIT_FAILURE;
+        }
+    } else {
+        memory = (uint8_t *)malloc((size_t)sectorSize * numSectors);
+        if (memory == NULL) {
+            fprintf(stderr, "Out of memory\n");
+            return EXIT_FAILURE;
+        }
+        OregonTHN128_StorageRamInit(&backend, &ram, memory, sectorSize, numSectors);
+    }
+
+    memset(&powerLoss, 0, sizeof(powerLoss));
+    powerLoss.backend = &backend;
+    powerLoss.rng = rng ^ 0x5555;
+    powerLossSchedule(&powerLoss, powerLossEnable);
+    storage = backend;
+    storage.read = powerLossRead;
+    storage.write = powerLossWrite;
+    storage.erase = powerLossErase;
+    storage.ctx = &powerLoss;
+
+    memset(&verify, 0, sizeof(verify));
+    if (!OregonTHN128_ForwardBegin(&fwd, &storage)) {
+        fprintf(stderr, "Invalid storage geometry\n");
+        return EXIT_FAILURE;
+    }
+
+    for (s = 0; s < numSensors; s++) {
+        sensorNext[s] = T_START + (uint32_t)(random64(&rng) % T_INTERVAL_S);
+        sensorAddress[s] = (uint8_t)(random64(&rng) & 0x07);
+    }
+
+    tRun = timeNow();
+    tEnd = T_START + days * T_DAY_S;
+    tBoot = T_START;
+    tNetwork = T_START + (uint32_t)randomExp(&rng, T_UP_MEAN_S);
+    tReboot = T_START + (uint32_t)randomExp(&rng, T_REBOOT_MEAN_S);
+
+    for (t = T_START; t < tEnd; t++) {
+        /* Network outages */
+        if (t >= tNetwork) {
+            networkUp = !networkUp;
+            tNetwork = t + 1 + (uint32_t)randomExp(&rng, networkUp ? T_UP_MEAN_S : T_DOWN_MEAN_S);
+        }
+        if (longOutageDays && (t == T_START + 2 * T_DAY_S)) {
+            networkUp = false;
+            tNetwork = t + longOutageDays * T_DAY_S;
+        }
+        if (networkUp) {
+            clockValid = true;
+        }
+        rebootNow = (t >= tReboot);
+
+        /* Readings */
+        for (s = 0; s < numSensors; s++) {
+            if (t < sensorNext[s]) {
+                continue;
+            }
+            sensorNext[s] += T_INTERVAL_S + (uint32_t)(random64(&rng) % 3) - 1;
+
+            data.rollingAddress = sensorAddress[s];
+            data.channel = (uint8_t)((s % 3) + 1);
+            data.temperature = (int16_t)((int)(random64(&rng) % 700) - 200);
+            data.lowBattery = (random64(&rng) % 100) == 0;
+            data.rawData = OregonTHN128_DataToRaw(&data);
+            readings++;
+
+            if (networkUp && !appendAll && (OregonTHN128_ForwardPending(&fwd) == 0)) {
+                direct++;
+                continue;
+            }
+
+            timestamp = clockValid ? t : (t - tBoot);
+            if (OregonTHN128_ForwardAppend(&fwd, timestamp, data.rawData)) {
+                verifyAppended(&verify, timestamp, data.rawData);
+                stored++;
+            } else {
+                lost++;
+                rebootNow = true;
+            }
+        }
+        if (OregonTHN128_ForwardPending(&fwd) > maxPending) {
+            maxPending = OregonTHN128_ForwardPending(&fwd);
+        }
+
+        if (networkUp && !rebootNow && !drain(&fwd, &verify, &rng, &publishes)) {
+            rebootNow = true;
+        }
+
+        /* Reboot: mount the buffer again, the clock is invalid until the network is up */
+        if (rebootNow || powerLoss.powerLoss) {
+            OregonTHN128_ForwardGetStats(&fwd, &stats);
+            dropped += stats.dropped;
+            powerLossSchedule(&powerLoss, powerLossEnable);
+            if (!OregonTHN128_ForwardBegin(&fwd, &storage)) {
+                fprintf(stderr, "Mount failed\n");
+                return EXIT_FAILURE;
+            }
+            reboots++;
+            tBoot = t;
+            clockValid = false;
+            if (t >= tReboot) {
+                tReboot = t + 1 + (uint32_t)randomExp(&rng, T_REBOOT_MEAN_S);
+            }
+        }
+    }
+
+    /* Drain the remaining records without power loss */
+    powerLossSchedule(&powerLoss, false);
+    while (OregonTHN128_ForwardPending(&fwd)) {
+        drain(&fwd, &verify, &rng, &publishes);
+    }
+    tRun = timeNow() - tRun;
+
+    OregonTHN128_ForwardGetStats(&fwd, &stats);
+    dropped += stats.dropped;
+    verify.missing += verify.count - verify.next;
+
+    /* Records delivered before a power loss can be dropped after the reboot */
+    ok = (verify.errors == 0) && (verify.missing <= dropped) &&
+         ((dropped - verify.missing) <= (uint64_t)powerLoss.powerLosses * BATCH_SIZE) &&
+         ((fileName ? file.violations : ram.violations) == 0);
+
+    printf("{\n");
+    printf("  \"storage\": \"%s\",\n", fileName ? "file" : "ram");
+    printf("  \"sector_size\": %u,\n", sectorSize);
+    printf("  \"sectors\": %u,\n", numSectors);
+    printf("  \"bytes_per_record\": %.2f,\n", (double)sectorSize * numSectors / stats.capacity);
+    printf("  \"capacity_records\": %u,\n", stats.capacity);
+    printf("  \"capacity_days\": %.1f,\n",
+           (double)stats.capacity * T_INTERVAL_S / ((double)T_DAY_S * numSensors));
+    printf("  \"days\": %u,\n", days);
+    printf("  \"sensors\": %u,\n", numSensors);
+    printf("  \"readings\": %llu,\n", (unsigned long long)readings);
+    printf("  \"published_direct\": %llu,\n", (unsigned long long)direct);
+    printf("  \"appended\": %llu,\n", (unsigned long long)stored);
+    printf("  \"max_pending\": %llu,\n", (unsigned long long)maxPending);
+    printf("  \"delivered\": %llu,\n", (unsigned long long)verify.delivered);
+    printf("  \"publishes\": %llu,\n", (unsigned long long)publishes);
+    printf("  \"dropped\": %llu,\n", (unsigned long long)dropped);
+    printf("  \"missing\": %llu,\n", (unsigned long long)verify.missing);
+    printf("  \"duplicates\": %llu,\n", (unsigned long long)verify.duplicates);
+    printf("  \"errors\": %llu,\n", (unsigned long long)verify.errors);
+    printf("  \"reboots\": %llu,\n", (unsigned long long)reboots);
+    printf("  \"power_losses\": %u,\n", powerLoss.powerLosses);
+    printf("  \"lost_at_power_loss\": %llu,\n", (unsigned long long)lost);
+    printf("  \"reads\": %llu,\n", (unsigned long long)powerLoss.reads);
+    printf("  \"writes\": %llu,\n", (unsigned long long)powerLoss.writes);
+    printf("  \"erases\": %llu,\n", (unsigned long long)powerLoss.erases);
+    printf("  \"erase_count_min\": %u,\n", stats.minEraseCount);
+    printf("  \"erase_count_max\": %u,\n", stats.maxEraseCount);
+    printf("  \"violations\": %u,\n", fileName ? file.violations : ram.violations);
+    printf("  \"run_s\": %.2f,\n", tRun);
+    printf("  \"pass\": %s\n", ok ? "true" : "false");
+    printf("}\n");
+
+    if (fileName) {
+        close(file.fd);
+    }
+    free(memory);
+    free(verify.appended);
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
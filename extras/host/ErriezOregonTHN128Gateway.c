@@ -0,0 +1,1088 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Gateway.c
+ * \brief Oregon THN128 Linux gateway: decodes streamed edge data to JSON lines
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      Runs the receive pipeline of ErriezOregonTHN128Receive.c on a Linux host: the decoder state
+ *      machine with the same glitch filter as the interrupt handler, recovery of frames with
+ *      checksum errors and the repeated frame filter. Each stage runs in its own thread:
+ *
+ *      reader -> decoder -> recover/de-dup -> JSON lines on stdout
+ *
+ *      The stages are connected by bounded single producer, single consumer lock-free queues. The
+ *      decoder never waits for a later stage: frames are dropped and counted as overruns when the
+ *      frame queue is full, like the receive queue of the interrupt handler.
+ *
+ *      Input from a file, a pipe (-: stdin) or a Unix stream socket (-u path, one client at a
+ *      time until SIGINT or SIGTERM) in one of the formats:
+ *      - bin: little endian 32-bit words, one per edge. Bits 0..30: edge time in us, wrapping.
+ *        Bit 31: level after the edge.
+ *      - ook: rtl_433 OOK pulse data text (rtl_433 -w file.ook): ";pulse data" blocks with
+ *        "<pulse> <gap>" lines in ";timescale" units, ended by ";end".
+ *
+ *      The synthetic generator (-g transmissions) replaces the reader: sensors on channel 1..3
+ *      transmit two copies every 30 seconds of stream time with edge jitter. Unpaced it measures
+ *      the sustained edge rate, paced (-r edges/s) the end-to-end latency from the time an edge
+ *      is available until its reading is written. With -w file the generated edges are written
+ *      in bin format instead of decoded.
+ *
+ *      Statistics are written as JSON to stderr at exit.
+ *
+ *      Build and run on a Linux host from the repository root:
+ *
+ *      gcc -O2 -pthread -Isrc src/ErriezOregonTHN128.c src/ErriezOregonTHN128Decoder.c \
+ *          src/ErriezOregonTHN128Encoder.c src/ErriezOregonTHN128Recover.c \
+ *          src/ErriezOregonTHN128Dedup.c extras/host/ErriezOregonTHN128Gateway.c -o gateway
+ *      ./gateway [-f bin|ook] [-d dedup ms] [-n] [-q] <file|-|-u socket>
+ *      ./gateway -g transmissions [-s sensors] [-j jitter us] [-r edges/s] [-w file] [-q]
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+#include "ErriezOregonTHN128.h"
+#include "ErriezOregonTHN128Decoder.h"
+#include "ErriezOregonTHN128Dedup.h"
+#include "ErriezOregonTHN128Encoder.h"
+#include "ErriezOregonTHN128Recover.h"
+
+/*! Edge queue size, power of 2 */
+#define EDGE_QUEUE_SIZE     65536
+
+/*! Frame queue size, power of 2 */
+#define FRAME_QUEUE_SIZE    4096
+
+/*! Reading queue size, power of 2 */
+#define READING_QUEUE_SIZE  1024
+
+/*! Items moved per queue operation */
+#define BATCH               256
+
+/*! Read buffer size */
+#define READ_BUFFER_SIZE    65536
+
+/*! Maximum rtl_433 text line length */
+#define MAX_LINE            256
+
+/*! Idle level inserted after a rtl_433 pulse data block in us */
+#define T_IDLE_US           20000
+
+/*! Transmit interval of a sensor in us */
+#define T_INTERVAL_US       30000000UL
+
+/*! Latency histogram size in us */
+#define LATENCY_BUCKETS     100000
+
+/*!
+ * \brief Bounded single producer, single consumer lock-free queue
+ */
+typedef struct {
+    uint8_t *buf;                               /*!< Items */
+    size_t itemSize;                            /*!< Item size in Bytes */
+    size_t mask;                                /*!< Number of items - 1 */
+    _Alignas(64) atomic_size_t head;            /*!< Written by the producer */
+    _Alignas(64) atomic_size_t tail;            /*!< Written by the consumer */
+    atomic_bool closed;                         /*!< Producer finished */
+} Queue_t;
+
+/*!
+ * \brief Level which ended at an edge
+ */
+typedef struct {
+    uint32_t duration;          /*!< Level duration in us */
+    uint8_t level;              /*!< 1: pulse (high), 0: space (low) */
+    uint64_t tAvailable;        /*!< Time the edge was read in ns */
+} Edge_t;
+
+/*!
+ * \brief Frame from the decoder
+ */
+typedef struct {
+    uint32_t rawData;           /*!< Raw data */
+    bool crcError;              /*!< Checksum error, to be recovered */
+#if OREGON_THN128_RX_SOFT_BITS
+    uint8_t softBits[OREGON_THN128_RX_SOFT_BITS]; /*!< Least confident bits of a failed frame */
+#endif
+    uint32_t tMs;               /*!< Stream time in ms */
+    uint64_t tAvailable;        /*!< Time the last edge was read in ns */
+} Frame_t;
+
+/*!
+ * \brief Reading to output
+ */
+typedef struct {
+    uint32_t rawData;           /*!< Raw data with valid checksum */
+    bool recovered;             /*!< Recovered from checksum errors */
+    uint32_t tMs;               /*!< Stream time in ms */
+    uint64_t tAvailable;        /*!< Time the last edge was read in ns */
+} Reading_t;
+
+/*!
+ * \brief Input formats
+ */
+typedef enum {
+    FormatBin = 0,              /*!< 32-bit edge times */
+    FormatOok = 1               /*!< rtl_433 OOK pulse data */
+} Format_t;
+
+/*!
+ * \brief Gateway options and input
+ */
+typedef struct {
+    Format_t format;            /*!< Input format */
+    const char *input;          /*!< File name, "-" for stdin */
+    const char *socketPath;     /*!< Unix socket path or NULL */
+    uint16_t dedupMs;           /*!< Repeated frame window in ms, 0: disabled */
+    bool recover;               /*!< Recover frames with checksum errors */
+    bool quiet;                 /*!< Don't write JSON lines */
+    uint32_t transmissions;     /*!< Generator transmissions, 0: read input */
+    uint8_t sensors;            /*!< Generator sensors */
+    uint32_t jitterUs;          /*!< Generator edge jitter in us */
+    double edgeRate;            /*!< Generator edges per second, 0: unpaced */
+    const char *writeFile;      /*!< Write generated edges to file */
+} Options_t;
+
+/*!
+ * \brief Pipeline counters, each written by one stage
+ */
+typedef struct {
+    uint64_t edges;             /*!< Edges read */
+    uint64_t glitches;          /*!< Edges shorter than T_RX_TOLERANCE_US ignored */
+    uint64_t frames;            /*!< Frames with a valid checksum */
+    uint64_t crcErrors;         /*!< Frames with a checksum error */
+    uint64_t overruns;          /*!< Frames dropped on a full frame queue */
+    uint64_t recovered;         /*!< Frames recovered */
+    uint64_t repeats;           /*!< Repeated frames removed */
+    uint64_t readings;          /*!< Readings written */
+    uint64_t generated;         /*!< Transmissions generated */
+    uint64_t latency[LATENCY_BUCKETS + 1]; /*!< Latency histogram in us */
+} Counters_t;
+
+static Options_t _options;
+static Counters_t _counters;
+static Queue_t _edgeQueue;
+static Queue_t _frameQueue;
+static Queue_t _readingQueue;
+static volatile sig_atomic_t _stop;
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                           Queue                                                */
+/*------------------------------------------------------------------------------------------------*/
+/*!
+ * \brief Initialize queue
+ */
+static bool queueInit(Queue_t *q, size_t itemSize, size_t size)
+{
+    q->buf = malloc(itemSize * size);
+    q->itemSize = itemSize;
+    q->mask = size - 1;
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+    atomic_init(&q->closed, false);
+
+    return q->buf != NULL;
+}
+
+/*!
+ * \brief Copy items into the queue, called by the producer only
+ * \return
+ *      Number of items copied, less than n when the queue is full
+ */
+static size_t queuePush(Queue_t *q, const void *items, size_t n)
+{
+    size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+    size_t index = head & q->mask;
+    size_t space = q->mask + 1 - (head - tail);
+    size_t first;
+
+    if (n > space) {
+        n = space;
+    }
+    first = q->mask + 1 - index;
+    if (first > n) {
+        first = n;
+    }
+    memcpy(q->buf + (index * q->itemSize), items, first * q->itemSize);
+    memcpy(q->buf, (const uint8_t *)items + (first * q->itemSize), (n - first) * q->itemSize);
+    atomic_store_explicit(&q->head, head + n, memory_order_release);
+
+    return n;
+}
+
+/*!
+ * \brief Copy items out of the queue, called by the consumer only
+ * \return
+ *      Number of items copied, 0 when the queue is empty
+ */
+static size_t queuePop(Queue_t *q, void *items, size_t max)
+{
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&q->head, memory_order_acquire);
+    size_t index = tail & q->mask;
+    size_t n = head - tail;
+    size_t first;
+
+    if (n > max) {
+        n = max;
+    }
+    first = q->mask + 1 - index;
+    if (first > n) {
+        first = n;
+    }
+    memcpy(items, q->buf + (index * q->itemSize), first * q->itemSize);
+    memcpy((uint8_t *)items + (first * q->itemSize), q->buf, (n - first) * q->itemSize);
+    atomic_store_explicit(&q->tail, tail + n, memory_order_release);
+
+    return n;
+}
+
+/*!
+ * \brief Mark queue as finished, called by the producer
+ */
+static void queueClose(Queue_t *q)
+{
+    atomic_store_explicit(&q->closed, true, memory_order_release);
+}
+
+/*!
+ * \brief Check if the queue is closed and empty, called by the consumer
+ */
+static bool queueDone(Queue_t *q)
+{
+    return atomic_load_explicit(&q->closed, memory_order_acquire) &&
+           (atomic_load_explicit(&q->head, memory_order_acquire) ==
+            atomic_load_explicit(&q->tail, memory_order_relaxed));
+}
+
+/*!
+ * \brief Wait for a queue with back-off: spin, yield, then sleep 100us when idle
+ */
+static void queueWait(uint32_t *idle)
+{
+    struct timespec ts = { 0, 100000 };
+
+    if (++(*idle) < 64) {
+        __asm__ __volatile__("" ::: "memory");
+    } else if (*idle < 1024) {
+        sched_yield();
+    } else {
+        nanosleep(&ts, NULL);
+    }
+}
+
+/*!
+ * \brief Push all items, waiting while the queue is full
+ */
+static void queuePushAll(Queue_t *q, const void *items, size_t n)
+{
+    uint32_t idle = 0;
+    size_t pushed;
+
+    while (n) {
+        pushed = queuePush(q, items, n);
+        if (pushed) {
+            items = (const uint8_t *)items + (pushed * q->itemSize);
+            n -= pushed;
+            idle = 0;
+        } else {
+            queueWait(&idle);
+        }
+    }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                           Reader                                               */
+/*------------------------------------------------------------------------------------------------*/
+/*!
+ * \brief Get monotonic time in ns
+ */
+static uint64_t timeNowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+/*!
+ * \brief Edge batch of the reader or generator
+ */
+typedef struct {
+    Edge_t edges[BATCH];        /*!< Edges */
+    size_t n;                   /*!< Number of edges */
+    uint64_t tAvailable;        /*!< Time stamp of the edges in ns */
+} EdgeBatch_t;
+
+/*!
+ * \brief Add a level to the batch, push a full batch to the decoder
+ */
+static void addEdge(EdgeBatch_t *batch, uint8_t level, uint32_t duration)
+{
+    batch->edges[batch->n].duration = duration;
+    batch->edges[batch->n].level = level;
+    batch->edges[batch->n].tAvailable = batch->tAvailable;
+    if (++batch->n == BATCH) {
+        queuePushAll(&_edgeQueue, batch->edges, batch->n);
+        _counters.edges += batch->n;
+        batch->n = 0;
+    }
+}
+
+/*!
+ * \brief Push remaining edges of a batch to the decoder
+ */
+static void flushEdges(EdgeBatch_t *batch)
+{
+    queuePushAll(&_edgeQueue, batch->edges, batch->n);
+    _counters.edges += batch->n;
+    batch->n = 0;
+}
+
+/*!
+ * \brief bin format parser state
+ */
+typedef struct {
+    uint8_t word[4];            /*!< Partial word */
+    uint8_t len;                /*!< Bytes in word[] */
+    bool valid;                 /*!< Previous edge received */
+    uint32_t tPrev;             /*!< Previous edge time in us */
+    uint8_t levelPrev;          /*!< Level after the previous edge */
+} BinParser_t;
+
+/*!
+ * \brief Parse bin format: each edge ends the level after the previous edge
+ */
+static void parseBin(BinParser_t *p, EdgeBatch_t *batch, const uint8_t *buf, size_t n)
+{
+    uint32_t word;
+
+    for (size_t i = 0; i < n; i++) {
+        p->word[p->len++] = buf[i];
+        if (p->len < 4) {
+            continue;
+        }
+        p->len = 0;
+
+        word = (uint32_t)p->word[0] | ((uint32_t)p->word[1] << 8) |
+               ((uint32_t)p->word[2] << 16) | ((uint32_t)p->word[3] << 24);
+        if (p->valid) {
+            addEdge(batch, p->levelPrev, (word - p->tPrev) & 0x7fffffffUL);
+        }
+        p->valid = true;
+        p->tPrev = word;
+        p->levelPrev = (uint8_t)(word >> 31);
+    }
+}
+
+/*!
+ * \brief rtl_433 OOK pulse data parser state
+ */
+typedef struct {
+    char line[MAX_LINE];        /*!< Partial line */
+    size_t len;                 /*!< Characters in line[] */
+    uint32_t timescale;         /*!< Pulse data unit in us */
+    bool error;                 /*!< Unsupported input */
+} OokParser_t;
+
+/*!
+ * \brief Parse one rtl_433 OOK pulse data line
+ */
+static void parseOokLine(OokParser_t *p, EdgeBatch_t *batch)
+{
+    unsigned long pulse;
+    unsigned long gap;
+    unsigned long timescale;
+    char unit[8];
+
+    if (p->line[0] == ';') {
+        if (strncmp(p->line, ";timescale", 10) == 0) {
+            if ((sscanf(p->line + 10, "%lu%7s", &timescale, unit) != 2) ||
+                (strcmp(unit, "us") != 0) || (timescale == 0)) {
+                fprintf(stderr, "Unsupported %s\n", p->line);
+                p->error = true;
+                return;
+            }
+            p->timescale = (uint32_t)timescale;
+        } else if (strncmp(p->line, ";end", 4) == 0) {
+            /* Blocks are not contiguous: separate by an idle level */
+            addEdge(batch, 0, T_IDLE_US);
+        }
+    } else if (sscanf(p->line, "%lu %lu", &pulse, &gap) == 2) {
+        addEdge(batch, 1, (uint32_t)(pulse * p->timescale));
+        addEdge(batch, 0, (uint32_t)(gap * p->timescale));
+    }
+}
+
+/*!
+ * \brief Parse rtl_433 OOK pulse data text
+ */
+static void parseOok(OokParser_t *p, EdgeBatch_t *batch, const uint8_t *buf, size_t n)
+{
+    for (size_t i = 0; (i < n) && !p->error; i++) {
+        if ((buf[i] == '\n') || (buf[i] == '\r')) {
+            p->line[p->len] = '\0';
+            if (p->len) {
+                parseOokLine(p, batch);
+            }
+            p->len = 0;
+        } else if (p->len < (MAX_LINE - 1)) {
+            p->line[p->len++] = (char)buf[i];
+        }
+    }
+}
+
+/*!
+ * \brief Read one input stream until end of file
+ * \retval false
+ *      Input error
+ */
+static bool readStream(int fd)
+{
+    static uint8_t buf[READ_BUFFER_SIZE];
+    static EdgeBatch_t batch;
+    BinParser_t bin = { { 0 }, 0, false, 0, 0 };
+    OokParser_t ook = { "", 0, 1, false };
+    ssize_t n;
+
+    while (!_stop && !ook.error) {
+        n = read(fd, buf, sizeof(buf));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("read");
+            return false;
+        }
+        if (n == 0) {
+            break;
+        }
+
+        batch.tAvailable = timeNowNs();
+        if (_options.format == FormatBin) {
+            parseBin(&bin, &batch, buf, (size_t)n);
+        } else {
+            parseOok(&ook, &batch, buf, (size_t)n);
+        }
+        flushEdges(&batch);
+    }
+
+    return !ook.error;
+}
+
+/*!
+ * \brief Serve Unix socket clients one at a time until stopped
+ */
+static bool readSocket(const char *path)
+{
+    struct sockaddr_un addr;
+    int server;
+    int client;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "Socket path too long\n");
+        return false;
+    }
+    strcpy(addr.sun_path, path);
+
+    server = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(path);
+    if ((server < 0) || (bind(server, (struct sockaddr *)&addr, sizeof(addr)) < 0) ||
+        (listen(server, 1) < 0)) {
+        perror(path);
+        return false;
+    }
+
+    while (!_stop) {
+        client = accept(server, NULL, NULL);
+        if (client < 0) {
+            if (errno != EINTR) {
+                perror("accept");
+            }
+            continue;
+        }
+        readStream(client);
+        close(client);
+    }
+
+    close(server);
+    unlink(path);
+
+    return true;
+}
+
+/*!
+ * \brief Block or unblock SIGINT and SIGTERM in the calling thread
+ */
+static void stopSignals(int how)
+{
+    sigset_t set;
+
+    sigemptyset(&set);
+    sigaddset(&set, SIGINT);
+    sigaddset(&set, SIGTERM);
+    pthread_sigmask(how, &set, NULL);
+}
+
+/*!
+ * \brief Reader thread
+ */
+static void *reader(void *arg)
+{
+    bool *ok = (bool *)arg;
+    int fd;
+
+    stopSignals(SIG_UNBLOCK);
+
+    if (_options.socketPath) {
+        *ok = readSocket(_options.socketPath);
+    } else if (strcmp(_options.input, "-") == 0) {
+        *ok = readStream(STDIN_FILENO);
+    } else {
+        fd = open(_options.input, O_RDONLY);
+        if (fd < 0) {
+            perror(_options.input);
+            *ok = false;
+        } else {
+            *ok = readStream(fd);
+            close(fd);
+        }
+    }
+    queueClose(&_edgeQueue);
+
+    return NULL;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                          Generator                                             */
+/*------------------------------------------------------------------------------------------------*/
+/*!
+ * \brief Pseudo random generator (xorshift64*)
+ */
+static uint64_t random64(uint64_t *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+
+    return *state * 0x2545f4914f6cdd1dULL;
+}
+
+/*!
+ * \brief Generated edge stream: merges equal levels and applies jitter to each edge
+ */
+typedef struct {
+    EdgeBatch_t batch;          /*!< Edges to the decoder */
+    FILE *file;                 /*!< bin output or NULL */
+    uint64_t rng;               /*!< Random state */
+    uint8_t level;              /*!< Level being generated */
+    uint64_t tLevel;            /*!< Duration of the level being generated in us */
+    uint64_t tEdge;             /*!< Time of the last edge in us */
+    int32_t jitterPrev;         /*!< Jitter of the last edge in us */
+    uint64_t numEdges;          /*!< Edges generated */
+    uint64_t tStart;            /*!< Pacing start in ns */
+} Generator_t;
+
+/*!
+ * \brief End the current level with a jittered edge
+ */
+static void generateEdge(Generator_t *gen)
+{
+    int32_t jitter = 0;
+    uint32_t duration;
+    uint32_t word;
+    uint64_t tTarget;
+
+    if (_options.jitterUs) {
+        jitter = (int32_t)(random64(&gen->rng) % (2 * _options.jitterUs + 1)) -
+                 (int32_t)_options.jitterUs;
+    }
+    duration = (uint32_t)((int64_t)gen->tLevel + jitter - gen->jitterPrev);
+    gen->jitterPrev = jitter;
+
+    if (gen->file) {
+        /* Edge time and level after the edge */
+        gen->tEdge += duration;
+        word = ((uint32_t)gen->tEdge & 0x7fffffffUL) | ((uint32_t)(gen->level ? 0 : 1) << 31);
+        fwrite(&word, sizeof(word), 1, gen->file);
+    } else {
+        if (_options.edgeRate && ((gen->numEdges % 64) == 0)) {
+            /* Release edges at the requested rate */
+            tTarget = gen->tStart + (uint64_t)(gen->numEdges * 1e9 / _options.edgeRate);
+            while (timeNowNs() < tTarget) {
+                struct timespec ts = { 0, 20000 };
+                nanosleep(&ts, NULL);
+            }
+            gen->batch.tAvailable = timeNowNs();
+        } else if ((gen->numEdges % BATCH) == 0) {
+            gen->batch.tAvailable = timeNowNs();
+        }
+        addEdge(&gen->batch, gen->level, duration);
+    }
+    gen->numEdges++;
+}
+
+/*!
+ * \brief Add a level to the generated stream
+ */
+static void generateLevel(Generator_t *gen, uint8_t level, uint32_t duration)
+{
+    if (level != gen->level) {
+        generateEdge(gen);
+        gen->level = level;
+        gen->tLevel = 0;
+    }
+    gen->tLevel += duration;
+}
+
+/*!
+ * \brief Generator thread: round robin transmissions of all sensors
+ */
+static void *generator(void *arg)
+{
+    static Generator_t gen;
+    OregonTHN128Encoder_t enc;
+    OregonTHN128Data_t data[OREGON_THN128_DEDUP_SLOTS];
+    uint32_t interval = T_INTERVAL_US / _options.sensors;
+    uint64_t tTransmission = 0;
+    uint8_t level;
+    uint32_t duration;
+    bool *ok = (bool *)arg;
+
+    stopSignals(SIG_UNBLOCK);
+    gen.rng = 0x9e3779b97f4a7c15ULL;
+    gen.tStart = timeNowNs();
+    if (_options.writeFile) {
+        gen.file = fopen(_options.writeFile, "wb");
+        if (gen.file == NULL) {
+            perror(_options.writeFile);
+            *ok = false;
+            queueClose(&_edgeQueue);
+            return NULL;
+        }
+    }
+
+    for (uint8_t i = 0; i < _options.sensors; i++) {
+        data[i].rollingAddress = (uint8_t)(random64(&gen.rng) & 0x07);
+        data[i].channel = (uint8_t)((i % 3) + 1);
+        data[i].temperature = (int16_t)(random64(&gen.rng) % 400);
+        data[i].lowBattery = 0;
+    }
+
+    /* Idle before the first transmission */
+    generateLevel(&gen, 0, T_IDLE_US);
+
+    for (uint32_t n = 0; (n < _options.transmissions) && !_stop; n++) {
+        OregonTHN128Data_t *sensor = &data[n % _options.sensors];
+
+        /* Random walk of the temperature */
+        sensor->temperature += (int16_t)(random64(&gen.rng) % 7) - 3;
+        if ((sensor->temperature < -999) || (sensor->temperature > 999)) {
+            sensor->temperature = 0;
+        }
+
+        /* Two copies */
+        OregonTHN128_EncoderInit(&enc, OregonTHN128_DataToRaw(sensor), 2);
+        duration = 0;
+        while (OregonTHN128_EncoderNext(&enc, &level, &duration)) {
+            generateLevel(&gen, level, duration);
+            tTransmission += duration;
+        }
+
+        /* Idle until the next transmission */
+        generateLevel(&gen, 0, (tTransmission < interval) ? (uint32_t)(interval - tTransmission) :
+                                                            T_IDLE_US);
+        tTransmission = 0;
+        _counters.generated++;
+    }
+    generateLevel(&gen, 1, 0);
+
+    if (gen.file) {
+        fclose(gen.file);
+    } else {
+        flushEdges(&gen.batch);
+    }
+    queueClose(&_edgeQueue);
+
+    return NULL;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                           Decoder                                              */
+/*------------------------------------------------------------------------------------------------*/
+/*!
+ * \brief Push a frame, drop it when the frame queue is full
+ */
+static void pushFrame(const Frame_t *frame)
+{
+    if (queuePush(&_frameQueue, frame, 1) == 0) {
+        _counters.overruns++;
+    }
+}
+
+/*!
+ * \brief Decoder thread: same glitch filter and frame handling as the interrupt handler
+ */
+static void *decoder(void *arg)
+{
+    static Edge_t edges[BATCH];
+    OregonTHN128Decoder_t dec;
+    Frame_t frame;
+    uint64_t tStream = 0;
+    uint32_t tLevel = 0;
+    uint32_t idle = 0;
+    size_t n;
+
+    (void)arg;
+    OregonTHN128_DecoderInit(&dec);
+#if OREGON_THN128_RX_SOFT_BITS
+    /* Soft windows only with recovery, as OregonTHN128_RxSetRecover() */
+    OregonTHN128_DecoderSetSoft(&dec, _options.recover);
+#endif
+    memset(&frame, 0, sizeof(frame));
+
+    while (!queueDone(&_edgeQueue)) {
+        n = queuePop(&_edgeQueue, edges, BATCH);
+        if (n == 0) {
+            queueWait(&idle);
+            continue;
+        }
+        idle = 0;
+
+        for (size_t i = 0; i < n; i++) {
+            tStream += edges[i].duration;
+
+            /* Ignore short pulses and add them to the next level */
+            tLevel += edges[i].duration;
+            if (tLevel < T_RX_TOLERANCE_US) {
+                _counters.glitches++;
+                continue;
+            }
+
+            if (OregonTHN128_DecodeEdge(&dec, (tLevel > 0xffff) ? 0xffff : (uint16_t)tLevel,
+                                        edges[i].level, &frame.rawData)) {
+                frame.crcError = false;
+                _counters.frames++;
+            } else if (dec.crcError) {
+                dec.crcError = false;
+                _counters.crcErrors++;
+                if (!_options.recover) {
+                    tLevel = 0;
+                    continue;
+                }
+                frame.rawData = dec.rxData;
+                frame.crcError = true;
+#if OREGON_THN128_RX_SOFT_BITS
+                memcpy(frame.softBits, dec.softBits, sizeof(frame.softBits));
+#endif
+            } else {
+                tLevel = 0;
+                continue;
+            }
+            tLevel = 0;
+
+            frame.tMs = (uint32_t)(tStream / 1000);
+            frame.tAvailable = edges[i].tAvailable;
+            pushFrame(&frame);
+        }
+    }
+    queueClose(&_frameQueue);
+
+    return NULL;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                       Recover / de-dup                                         */
+/*------------------------------------------------------------------------------------------------*/
+/*!
+ * \brief Filter thread: recovers failed frames and removes repeats, as the receive queue filter
+ */
+static void *filter(void *arg)
+{
+    static Frame_t frames[BATCH];
+    OregonTHN128Recover_t recover;
+    OregonTHN128Dedup_t dedup;
+    Reading_t reading;
+    uint32_t idle = 0;
+    size_t n;
+
+    (void)arg;
+    OregonTHN128_RecoverInit(&recover);
+    OregonTHN128_DedupInit(&dedup, _options.dedupMs);
+
+    while (!queueDone(&_frameQueue)) {
+        n = queuePop(&_frameQueue, frames, BATCH);
+        if (n == 0) {
+            queueWait(&idle);
+            continue;
+        }
+        idle = 0;
+
+        for (size_t i = 0; i < n; i++) {
+            reading.rawData = frames[i].rawData;
+            reading.recovered = frames[i].crcError;
+
+            if (frames[i].crcError) {
+#if OREGON_THN128_RX_SOFT_BITS
+                if (!OregonTHN128_RecoverFrame(&recover, frames[i].rawData, frames[i].softBits,
+                                               OREGON_THN128_RX_SOFT_BITS, frames[i].tMs,
+                                               &reading.rawData)) {
+#else
+                if (!OregonTHN128_RecoverFrame(&recover, frames[i].rawData, NULL, 0,
+                                               frames[i].tMs, &reading.rawData)) {
+#endif
+                    continue;
+                }
+                _counters.recovered++;
+            }
+
+            if (dedup.windowMs && OregonTHN128_DedupFilter(&dedup, reading.rawData,
+                                                           frames[i].tMs)) {
+                _counters.repeats++;
+                continue;
+            }
+
+            reading.tMs = frames[i].tMs;
+            reading.tAvailable = frames[i].tAvailable;
+            queuePushAll(&_readingQueue, &reading, 1);
+        }
+    }
+    queueClose(&_readingQueue);
+
+    return NULL;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                            Output                                              */
+/*------------------------------------------------------------------------------------------------*/
+/*!
+ * \brief Write a reading as JSON line
+ */
+static void writeReading(const Reading_t *reading)
+{
+    OregonTHN128Data_t data;
+    char temperature[8];
+
+    OregonTHN128_RawToData(reading->rawData, &data);
+    OregonTHN128_TempAppendJson(temperature, sizeof(temperature), data.temperature);
+
+    printf("{\"time_ms\": %lu, \"raw\": \"0x%08lx\", \"rolling_address\": %u, \"channel\": %u, "
+           "\"temperature\": %s, \"low_battery\": %s, \"recovered\": %s}\n",
+           (unsigned long)reading->tMs, (unsigned long)reading->rawData,
+           data.rollingAddress, data.channel, temperature, data.lowBattery ? "true" : "false",
+           reading->recovered ? "true" : "false");
+}
+
+/*!
+ * \brief Output thread: JSON lines on stdout, flushed when no readings are pending
+ */
+static void *output(void *arg)
+{
+    static Reading_t readings[BATCH];
+    uint64_t latency;
+    uint32_t idle = 0;
+    size_t n;
+
+    (void)arg;
+
+    while (!queueDone(&_readingQueue)) {
+        n = queuePop(&_readingQueue, readings, BATCH);
+        if (n == 0) {
+            if (idle == 0) {
+                fflush(stdout);
+            }
+            queueWait(&idle);
+            continue;
+        }
+        idle = 0;
+
+        for (size_t i = 0; i < n; i++) {
+            if (!_options.quiet) {
+                writeReading(&readings[i]);
+            }
+
+            latency = (timeNowNs() - readings[i].tAvailable) / 1000;
+            _counters.latency[(latency < LATENCY_BUCKETS) ? latency : LATENCY_BUCKETS]++;
+            _counters.readings++;
+        }
+    }
+    fflush(stdout);
+
+    return NULL;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                             Main                                               */
+/*------------------------------------------------------------------------------------------------*/
+/*!
+ * \brief Latency percentile in us, LATENCY_BUCKETS when above the histogram
+ */
+static uint32_t latencyPercentile(double percentile)
+{
+    uint64_t target = (uint64_t)(_counters.readings * percentile / 100.0);
+    uint64_t sum = 0;
+
+    for (uint32_t i = 0; i < LATENCY_BUCKETS; i++) {
+        sum += _counters.latency[i];
+        if (sum > target) {
+            return i;
+        }
+    }
+
+    return LATENCY_BUCKETS;
+}
+
+/*!
+ * \brief Stop on SIGINT or SIGTERM
+ */
+static void signalHandler(int sig)
+{
+    (void)sig;
+    _stop = 1;
+}
+
+int main(int argc, char *argv[])
+{
+    struct sigaction sa;
+    pthread_t threads[4];
+    uint64_t tStart;
+    double tElapsed;
+    uint32_t maxLatency = 0;
+    bool inputOk = true;
+    int opt;
+
+    _options.dedupMs = OREGON_THN128_DEDUP_WINDOW_MS;
+    _options.recover = true;
+    _options.sensors = 3;
+    _options.jitterUs = 50;
+
+    while ((opt = getopt(argc, argv, "f:d:nqu:g:s:j:r:w:")) != -1) {
+        switch (opt) {
+            case 'f':
+                if (strcmp(optarg, "ook") == 0) {
+                    _options.format = FormatOok;
+                } else if (strcmp(optarg, "bin") != 0) {
+                    fprintf(stderr, "Unknown format %s\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'd': _options.dedupMs = (uint16_t)strtoul(optarg, NULL, 0); break;
+            case 'n': _options.recover = false; break;
+            case 'q': _options.quiet = true; break;
+            case 'u': _options.socketPath = optarg; break;
+            case 'g': _options.transmissions = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 's': _options.sensors = (uint8_t)strtoul(optarg, NULL, 0); break;
+            case 'j': _options.jitterUs = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'r': _options.edgeRate = strtod(optarg, NULL); break;
+            case 'w': _options.writeFile = optarg; break;
+            default:
+                fprintf(stderr, "Usage: %s [-f bin|ook] [-d dedup ms] [-n] [-q] <file|-|-u socket>\n"
+                        "       %s -g transmissions [-s sensors] [-j jitter us] [-r edges/s] "
+                        "[-w file] [-q]\n", argv[0], argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (optind < argc) {
+        _options.input = argv[optind];
+    }
+    if ((!_options.transmissions && !_options.input && !_options.socketPath) ||
+        (_options.sensors < 1) || (_options.sensors > OREGON_THN128_DEDUP_SLOTS) ||
+        (_options.jitterUs > (T_RX_TOLERANCE_US / 2)) || (_options.edgeRate < 0)) {
+        fprintf(stderr, "Invalid argument\n");
+        return EXIT_FAILURE;
+    }
+
+    if (_options.transmissions && _options.writeFile) {
+        generator(&inputOk);
+        return inputOk ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    if (!queueInit(&_edgeQueue, sizeof(Edge_t), EDGE_QUEUE_SIZE) ||
+        !queueInit(&_frameQueue, sizeof(Frame_t), FRAME_QUEUE_SIZE) ||
+        !queueInit(&_readingQueue, sizeof(Reading_t), READING_QUEUE_SIZE)) {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+
+    /* Interrupt blocking reads and accept on stop */
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = signalHandler;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    /* Only the input thread receives stop signals */
+    stopSignals(SIG_BLOCK);
+
+    tStart = timeNowNs();
+    pthread_create(&threads[0], NULL, output, NULL);
+    pthread_create(&threads[1], NULL, filter, NULL);
+    pthread_create(&threads[2], NULL, decoder, NULL);
+    pthread_create(&threads[3], NULL, _options.transmissions ? generator : reader, &inputOk);
+    for (int i = 3; i >= 0; i--) {
+        pthread_join(threads[i], NULL);
+    }
+    tElapsed = (double)(timeNowNs() - tStart) * 1e-9;
+
+    for (uint32_t i = 0; i <= LATENCY_BUCKETS; i++) {
+        if (_counters.latency[i]) {
+            maxLatency = i;
+        }
+    }
+
+    fprintf(stderr, "{\n  \"seconds\": %.3f,\n  \"edges\": %llu,\n  \"edges_per_s\": %.0f,\n"
+            "  \"glitches\": %llu,\n  \"frames\": %llu,\n  \"crc_errors\": %llu,\n"
+            "  \"recovered\": %llu,\n  \"repeats\": %llu,\n  \"overruns\": %llu,\n"
+            "  \"readings\": %llu,\n",
+            tElapsed, (unsigned long long)_counters.edges, _counters.edges / tElapsed,
+            (unsigned long long)_counters.glitches, (unsigned long long)_counters.frames,
+            (unsigned long long)_counters.crcErrors, (unsigned long long)_counters.recovered,
+            (unsigned long long)_counters.repeats, (unsigned long long)_counters.overruns,
+            (unsigned long long)_counters.readings);
+    if (_options.transmissions) {
+        fprintf(stderr, "  \"generated\": %llu,\n", (unsigned long long)_counters.generated);
+    }
+    fprintf(stderr, "  \"latency_us\": {\"p50\": %u, \"p99\": %u, \"max\": %u}\n}\n",
+            latencyPercentile(50), latencyPercentile(99), maxLatency);
+
+    return inputOk ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,610 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128LogTool.c
+ * \brief Oregon THN128 binary reading log tool and benchmark
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      Writes and queries logs of ErriezOregonTHN128Log.c. The log is mapped with mmap() and read
+ *      in place.
+ *
+ *      Append (-a): reads JSON lines of ErriezOregonTHN128Gateway.c from stdin and appends the
+ *      readings with the current time in seconds, sensor number OREGON_THN128_SENSOR():
+ *      ./gateway -u /tmp/oregon.sock | ./logtool -a readings.log
+ *
+ *      Query (-q): temperature statistics of a sensor in a time range as JSON, with -l also the
+ *      readings:
+ *      ./logtool -q readings.log -s sensor [-b begin] [-e end] [-l]
+ *
+ *      Benchmark (-B): writes a log with a year of readings every 30 seconds for hundreds of
+ *      sensors, verifies the readings and statistics of sampled sensors, and measures Bytes per
+ *      reading and query throughput for ranges of an hour up to a year.
+ *
+ *      Build and run on a Linux host from the repository root:
+ *
+ *      gcc -O2 -Isrc src/ErriezOregonTHN128.c src/ErriezOregonTHN128Log.c \
+ *          extras/host/ErriezOregonTHN128LogTool.c -o logtool -lm
+ *      ./logtool -B [-n sensors] [-d days] benchmark.log
+ */
+
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include "ErriezOregonTHN128.h"
+#include "ErriezOregonTHN128Log.h"
+
+/*! Transmit interval of the benchmark sensors in seconds */
+#define T_INTERVAL_S        30
+
+/*! Benchmark start time: 2026-01-01 00:00:00 UTC */
+#define T_START             1767225600UL
+
+/*! Seconds per day */
+#define T_DAY_S             86400UL
+
+/*! Sensors verified by the benchmark */
+#define VERIFY_SENSORS      8
+
+/*! Statistics queries verified per sensor */
+#define VERIFY_QUERIES      1000
+
+/*! Minimum benchmark time per query range in s */
+#define T_MEASURE_MIN_S     0.5
+
+/*!
+ * \brief Mapped log
+ */
+typedef struct {
+    const void *log;                        /*!< Mapped log */
+    size_t len;                             /*!< Log size in Bytes */
+    const OregonTHN128LogHeader_t **blocks; /*!< Block index */
+    uint32_t *first;                        /*!< First block per sensor */
+    OregonTHN128LogReader_t reader;         /*!< Reader */
+} Mapped_t;
+
+/*!
+ * \brief Synthetic sensor
+ */
+typedef struct {
+    uint64_t rng;               /*!< Random state */
+    uint32_t timestamp;         /*!< Next timestamp */
+    double base;                /*!< Mean temperature in 0.1 degree */
+    double amplitude;           /*!< Day/night amplitude in 0.1 degree */
+    double phase;               /*!< Day/night phase */
+    double drift;               /*!< Random walk in 0.1 degree */
+} Sensor_t;
+
+/*!
+ * \brief Readings of one sensor for verification
+ */
+typedef struct {
+    uint32_t *timestamp;        /*!< Timestamps */
+    int16_t *temperature;       /*!< Temperatures */
+    uint8_t *flags;             /*!< Flags */
+    size_t count;               /*!< Number of readings */
+    size_t capacity;            /*!< Array size */
+    size_t mismatches;          /*!< Readings different from the log */
+} Readings_t;
+
+/*!
+ * \brief Get monotonic time in seconds
+ */
+static double timeNow(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + (ts.tv_nsec * 1e-9);
+}
+
+/*!
+ * \brief Pseudo random generator (xorshift64*)
+ */
+static uint64_t random64(uint64_t *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+
+    return *state * 0x2545f4914f6cdd1dULL;
+}
+
+/*!
+ * \brief Write function of the log writer
+ */
+static bool writeFile(const void *data, size_t len, void *arg)
+{
+    return fwrite(data, 1, len, (FILE *)arg) == len;
+}
+
+/*!
+ * \brief Map and index a log
+ */
+static bool mapLog(Mapped_t *m, const char *fileName, uint16_t numSensors)
+{
+    struct stat st;
+    size_t numBlocks;
+    int fd;
+
+    fd = open(fileName, O_RDONLY);
+    if ((fd < 0) || (fstat(fd, &st) < 0)) {
+        perror(fileName);
+        return false;
+    }
+    m->len = (size_t)st.st_size;
+    m->log = (m->len > 0) ? mmap(NULL, m->len, PROT_READ, MAP_SHARED, fd, 0) : NULL;
+    close(fd);
+    if (m->log == MAP_FAILED) {
+        perror("mmap");
+        return false;
+    }
+
+    numBlocks = OregonTHN128_LogCountBlocks(m->log, m->len, NULL);
+    m->blocks = malloc((numBlocks + 1) * sizeof(OregonTHN128LogHeader_t *));
+    m->first = malloc((numSensors + 1UL) * sizeof(uint32_t));
+    if ((m->blocks == NULL) || (m->first == NULL) ||
+        !OregonTHN128_LogReaderInit(&m->reader, m->log, m->len, m->blocks, numBlocks, m->first,
+                                    numSensors)) {
+        fprintf(stderr, "Cannot index log\n");
+        return false;
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Unmap a log
+ */
+static void unmapLog(Mapped_t *m)
+{
+    if (m->log) {
+        munmap((void *)m->log, m->len);
+    }
+    free(m->blocks);
+    free(m->first);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                        Append / query                                          */
+/*------------------------------------------------------------------------------------------------*/
+/*!
+ * \brief Append gateway JSON lines from stdin
+ */
+static int appendLog(const char *fileName)
+{
+    static OregonTHN128LogStream_t streams[OREGON_THN128_SENSOR_KEYS];
+    OregonTHN128LogWriter_t writer;
+    OregonTHN128Data_t data;
+    unsigned long rawData;
+    char line[512];
+    const char *raw;
+    size_t appended = 0;
+    FILE *file;
+    bool ok = true;
+
+    file = fopen(fileName, "ab");
+    if (file == NULL) {
+        perror(fileName);
+        return EXIT_FAILURE;
+    }
+    OregonTHN128_LogWriterInit(&writer, streams, OREGON_THN128_SENSOR_KEYS, writeFile, file);
+
+    while (ok && fgets(line, sizeof(line), stdin)) {
+        raw = strstr(line, "\"raw\": \"");
+        if ((raw == NULL) || (sscanf(raw + 8, "%lx", &rawData) != 1) ||
+            !OregonTHN128_RawToData((uint32_t)rawData, &data)) {
+            continue;
+        }
+        ok = OregonTHN128_LogAppend(&writer,
+                                    OREGON_THN128_SENSOR(data.channel, data.rollingAddress),
+                                    (uint32_t)time(NULL), &data);
+        appended += ok;
+    }
+
+    /* Partial blocks are written at the end of the input */
+    ok = OregonTHN128_LogFlush(&writer) && ok;
+    ok = (fclose(file) == 0) && ok;
+    fprintf(stderr, "%zu readings appended, %lu blocks\n", appended, (unsigned long)writer.blocks);
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*!
+ * \brief Print a reading as JSON line
+ */
+static void printReading(uint32_t timestamp, int16_t temperature, uint8_t flags, void *arg)
+{
+    char temperatureStr[8];
+
+    (void)arg;
+    OregonTHN128_TempAppendJson(temperatureStr, sizeof(temperatureStr), temperature);
+    printf("{\"time\": %lu, \"temperature\": %s, \"low_battery\": %s}\n",
+           (unsigned long)timestamp, temperatureStr,
+           (flags & OREGON_THN128_FLAG_LOW_BATTERY) ? "true" : "false");
+}
+
+/*!
+ * \brief Query statistics and readings of a sensor
+ */
+static int queryLog(const char *fileName, uint16_t sensor, uint32_t tBegin, uint32_t tEnd,
+                    bool list)
+{
+    OregonTHN128StoreStats_t stats;
+    Mapped_t m = { 0 };
+    char minStr[8];
+    char maxStr[8];
+
+    if (!mapLog(&m, fileName, OREGON_THN128_SENSOR_KEYS)) {
+        return EXIT_FAILURE;
+    }
+
+    if (list) {
+        OregonTHN128_LogRead(&m.reader, sensor, tBegin, tEnd, printReading, NULL);
+    }
+    OregonTHN128_LogStats(&m.reader, sensor, tBegin, tEnd, &stats);
+    OregonTHN128_TempAppendJson(minStr, sizeof(minStr), stats.count ? stats.minTemperature : 0);
+    OregonTHN128_TempAppendJson(maxStr, sizeof(maxStr), stats.count ? stats.maxTemperature : 0);
+    printf("{\"sensor\": %u, \"count\": %zu, \"min\": %s, \"max\": %s, \"avg\": ",
+           sensor, stats.count, stats.count ? minStr : "null", stats.count ? maxStr : "null");
+    if (stats.count) {
+        printf("%.2f}\n", (double)stats.sumTemperature / (double)stats.count / 10.0);
+    } else {
+        printf("null}\n");
+    }
+
+    unmapLog(&m);
+
+    return EXIT_SUCCESS;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                          Benchmark                                             */
+/*------------------------------------------------------------------------------------------------*/
+/*!
+ * \brief Initialize synthetic sensor, independent of the other sensors
+ */
+static void sensorInit(Sensor_t *sensor, uint16_t number)
+{
+    sensor->rng = 0x9e3779b97f4a7c15ULL * (number + 1);
+    sensor->timestamp = T_START + (uint32_t)(random64(&sensor->rng) % T_INTERVAL_S);
+    sensor->base = (double)(random64(&sensor->rng) % 300) - 50;
+    sensor->amplitude = (double)(random64(&sensor->rng) % 80);
+    sensor->phase = (double)(random64(&sensor->rng) % 1000) * 0.00628;
+    sensor->drift = 0;
+}
+
+/*!
+ * \brief Next reading of a synthetic sensor
+ * \details
+ *      Day/night cycle with a random walk, receive time jitter of 1 second, 2% missed readings
+ *      and a low battery after 300 days.
+ */
+static void sensorNext(Sensor_t *sensor, uint32_t *timestamp, OregonTHN128Data_t *data)
+{
+    uint64_t r = random64(&sensor->rng);
+    uint32_t tDay = sensor->timestamp - T_START;
+    double temperature;
+
+    if ((r % 50) == 0) {
+        sensor->timestamp += T_INTERVAL_S;
+    }
+    sensor->drift += (double)((int)((r >> 8) % 3) - 1) * 0.2;
+    sensor->drift *= 0.999;
+
+    temperature = sensor->base + sensor->drift +
+                  sensor->amplitude * sin((tDay * (6.2831853 / T_DAY_S)) + sensor->phase);
+    data->temperature = (int16_t)lround(temperature);
+    data->lowBattery = (tDay > (300 * T_DAY_S)) ? 1 : 0;
+
+    *timestamp = sensor->timestamp + (uint32_t)((r >> 16) % 3);
+    sensor->timestamp += T_INTERVAL_S;
+}
+
+/*!
+ * \brief Compare a reading with the expected readings
+ */
+static void verifyReading(uint32_t timestamp, int16_t temperature, uint8_t flags, void *arg)
+{
+    Readings_t *readings = (Readings_t *)arg;
+    size_t i = readings->count++;
+
+    if ((i >= readings->capacity) || (readings->timestamp[i] != timestamp) ||
+        (readings->temperature[i] != temperature) || (readings->flags[i] != flags)) {
+        readings->mismatches++;
+    }
+}
+
+/*!
+ * \brief Count decoded readings
+ */
+static void countReading(uint32_t timestamp, int16_t temperature, uint8_t flags, void *arg)
+{
+    (void)timestamp;
+    (void)flags;
+    *(int64_t *)arg += temperature;
+}
+
+/*!
+ * \brief Verify readings and statistics of a sensor against the regenerated readings
+ * \return
+ *      Number of errors
+ */
+static size_t verifySensor(const OregonTHN128LogReader_t *reader, uint16_t number, uint32_t days,
+                           uint64_t *rng)
+{
+    size_t capacity = (size_t)days * (T_DAY_S / T_INTERVAL_S);
+    Readings_t readings = { 0 };
+    OregonTHN128StoreStats_t stats;
+    OregonTHN128Data_t data;
+    Sensor_t sensor;
+    uint32_t tBegin;
+    uint32_t tEnd;
+    size_t errors = 0;
+
+    readings.timestamp = malloc(capacity * sizeof(uint32_t));
+    readings.temperature = malloc(capacity * sizeof(int16_t));
+    readings.flags = malloc(capacity);
+    if (!readings.timestamp || !readings.temperature || !readings.flags) {
+        return 1;
+    }
+
+    sensorInit(&sensor, number);
+    while (readings.count < capacity) {
+        sensorNext(&sensor, &readings.timestamp[readings.count], &data);
+        if (readings.timestamp[readings.count] >= (T_START + (days * T_DAY_S))) {
+            break;
+        }
+        readings.temperature[readings.count] = data.temperature;
+        readings.flags[readings.count] = data.lowBattery ? OREGON_THN128_FLAG_LOW_BATTERY : 0;
+        readings.count++;
+    }
+    readings.capacity = readings.count;
+
+    /* All readings */
+    readings.count = 0;
+    OregonTHN128_LogRead(reader, number, 0, UINT32_MAX, verifyReading, &readings);
+    errors += readings.mismatches + (readings.count != readings.capacity);
+
+    /* Statistics of random ranges */
+    for (int q = 0; q < VERIFY_QUERIES; q++) {
+        size_t a = (size_t)(random64(rng) % readings.capacity);
+        size_t b = a + (size_t)(random64(rng) % (readings.capacity - a));
+        int16_t minTemperature = INT16_MAX;
+        int16_t maxTemperature = INT16_MIN;
+        int64_t sum = 0;
+        size_t n = 0;
+
+        tBegin = readings.timestamp[a];
+        tEnd = readings.timestamp[b];
+        for (size_t i = a; (i < readings.capacity) && (readings.timestamp[i] < tEnd); i++) {
+            if (readings.timestamp[i] >= tBegin) {
+                minTemperature = (readings.temperature[i] < minTemperature) ?
+                                 readings.temperature[i] : minTemperature;
+                maxTemperature = (readings.temperature[i] > maxTemperature) ?
+                                 readings.temperature[i] : maxTemperature;
+                sum += readings.temperature[i];
+                n++;
+            }
+        }
+
+        OregonTHN128_LogStats(reader, number, tBegin, tEnd, &stats);
+        errors += (stats.count != n) || (stats.sumTemperature != sum) ||
+                  (n && ((stats.minTemperature != minTemperature) ||
+                         (stats.maxTemperature != maxTemperature)));
+    }
+
+    free(readings.timestamp);
+    free(readings.temperature);
+    free(readings.flags);
+
+    return errors;
+}
+
+/*!
+ * \brief Write, verify and query a synthetic log
+ */
+static int benchmark(const char *fileName, uint16_t numSensors, uint32_t days)
+{
+    static const struct {
+        const char *name;
+        uint32_t seconds;
+    } ranges[] = {
+        { "hour", 3600 }, { "day", T_DAY_S }, { "week", 7 * T_DAY_S }, { "month", 30 * T_DAY_S },
+        { "year", 365 * T_DAY_S }
+    };
+    OregonTHN128LogStream_t *streams;
+    OregonTHN128LogWriter_t writer;
+    OregonTHN128StoreStats_t stats;
+    OregonTHN128Data_t data = { 0, 0, 1, 0, 0 };
+    Sensor_t *sensors;
+    Mapped_t m = { 0 };
+    uint64_t rng = 0x2545f4914f6cdd1dULL;
+    uint64_t readings = 0;
+    uint64_t covered;
+    uint32_t tEnd = T_START + (days * T_DAY_S);
+    uint32_t timestamp;
+    uint32_t queries;
+    int64_t sum = 0;
+    size_t errors = 0;
+    double tStart;
+    double tWrite;
+    double tIndex;
+    double tDecode;
+    FILE *file;
+    bool ok = true;
+
+    streams = calloc(numSensors, sizeof(OregonTHN128LogStream_t));
+    sensors = calloc(numSensors, sizeof(Sensor_t));
+    file = fopen(fileName, "wb");
+    if (!streams || !sensors || !file) {
+        fprintf(stderr, "Cannot create %s\n", fileName);
+        return EXIT_FAILURE;
+    }
+    setvbuf(file, NULL, _IOFBF, 1 << 20);
+
+    /* Write: readings of all sensors interleaved in time steps */
+    tStart = timeNow();
+    OregonTHN128_LogWriterInit(&writer, streams, numSensors, writeFile, file);
+    for (uint16_t s = 0; s < numSensors; s++) {
+        sensorInit(&sensors[s], s);
+    }
+    for (uint32_t t = T_START; (t < tEnd) && ok; t += T_INTERVAL_S) {
+        for (uint16_t s = 0; (s < numSensors) && ok; s++) {
+            while ((sensors[s].timestamp < (t + T_INTERVAL_S)) && (sensors[s].timestamp < tEnd)) {
+                sensorNext(&sensors[s], &timestamp, &data);
+                if (timestamp >= tEnd) {
+                    break;
+                }
+                ok = OregonTHN128_LogAppend(&writer, s, timestamp, &data);
+                readings++;
+            }
+        }
+    }
+    ok = OregonTHN128_LogFlush(&writer) && ok;
+    ok = (fclose(file) == 0) && ok;
+    tWrite = timeNow() - tStart;
+    if (!ok) {
+        fprintf(stderr, "Write error\n");
+        return EXIT_FAILURE;
+    }
+
+    /* Map and index */
+    tStart = timeNow();
+    if (!mapLog(&m, fileName, numSensors)) {
+        return EXIT_FAILURE;
+    }
+    tIndex = timeNow() - tStart;
+
+    /* Verify sampled sensors */
+    for (uint16_t i = 0; i < VERIFY_SENSORS; i++) {
+        errors += verifySensor(&m.reader, (uint16_t)((i * 7919UL) % numSensors), days, &rng);
+    }
+
+    /* Decode all readings */
+    tStart = timeNow();
+    covered = 0;
+    for (uint16_t s = 0; s < numSensors; s++) {
+        covered += OregonTHN128_LogRead(&m.reader, s, 0, UINT32_MAX, countReading, &sum);
+    }
+    tDecode = timeNow() - tStart;
+    errors += (covered != readings);
+
+    printf("{\n  \"sensors\": %u,\n  \"days\": %lu,\n  \"readings\": %llu,\n  \"bytes\": %zu,\n"
+           "  \"blocks\": %zu,\n  \"bytes_per_reading\": %.3f,\n  \"bits_per_reading\": %.2f,\n"
+           "  \"append_per_s\": %.0f,\n  \"index_ms\": %.1f,\n  \"decode_per_s\": %.0f,\n"
+           "  \"queries\": [\n",
+           numSensors, (unsigned long)days, (unsigned long long)readings, m.len,
+           m.reader.numBlocks, (double)m.len / (double)readings,
+           (double)m.len * 8 / (double)readings, (double)readings / tWrite, tIndex * 1e3,
+           (double)readings / tDecode);
+
+    /* Statistics of random ranges */
+    for (size_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]); r++) {
+        uint32_t seconds = (ranges[r].seconds < (days * T_DAY_S)) ? ranges[r].seconds :
+                                                                    (days * T_DAY_S);
+
+        queries = 0;
+        covered = 0;
+        tStart = timeNow();
+        do {
+            for (int i = 0; i < 1000; i++) {
+                uint16_t s = (uint16_t)(random64(&rng) % numSensors);
+                uint32_t tBegin = T_START +
+                                  (uint32_t)(random64(&rng) % ((days * T_DAY_S) - seconds + 1));
+
+                OregonTHN128_LogStats(&m.reader, s, tBegin, tBegin + seconds, &stats);
+                covered += stats.count;
+            }
+            queries += 1000;
+        } while ((timeNow() - tStart) < T_MEASURE_MIN_S);
+
+        printf("    {\"range\": \"%s\", \"queries_per_s\": %.0f, \"readings_per_query\": %.0f}%s\n",
+               ranges[r].name, queries / (timeNow() - tStart), (double)covered / queries,
+               (r + 1 < sizeof(ranges) / sizeof(ranges[0])) ? "," : "");
+    }
+    printf("  ],\n  \"errors\": %zu,\n  \"pass\": %s\n}\n", errors, errors ? "false" : "true");
+
+    unmapLog(&m);
+    free(streams);
+    free(sensors);
+
+    return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *appendFile = NULL;
+    const char *queryFile = NULL;
+    bool bench = false;
+    bool list = false;
+    long sensor = -1;
+    uint32_t tBegin = 0;
+    uint32_t tEnd = UINT32_MAX;
+    uint16_t numSensors = 300;
+    uint32_t days = 365;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "a:q:s:b:e:lBn:d:")) != -1) {
+        switch (opt) {
+            case 'a': appendFile = optarg; break;
+            case 'q': queryFile = optarg; break;
+            case 's': sensor = strtol(optarg, NULL, 0); break;
+            case 'b': tBegin = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'e': tEnd = (uint32_t)strtoul(optarg, NULL, 0); break;
+            case 'l': list = true; break;
+            case 'B': bench = true; break;
+            case 'n': numSensors = (uint16_t)strtoul(optarg, NULL, 0); break;
+            case 'd': days = (uint32_t)strtoul(optarg, NULL, 0); break;
+            default:
+                fprintf(stderr, "Usage: %s -a log\n"
+                        "       %s -q log -s sensor [-b begin] [-e end] [-l]\n"
+                        "       %s -B [-n sensors] [-d days] log\n", argv[0], argv[0], argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    if (appendFile) {
+        return appendLog(appendFile);
+    }
+    if (queryFile && (sensor >= 0) && (sensor < OREGON_THN128_SENSOR_KEYS)) {
+        return queryLog(queryFile, (uint16_t)sensor, tBegin, tEnd, list);
+    }
+    if (bench && (optind < argc) && (numSensors > 0) && (days > 0) && (days <= 3650)) {
+        return benchmark(argv[optind], numSensors, days);
+    }
+
+    fprintf(stderr, "Invalid argument\n");
+
+    return EXIT_FAILURE;
+}
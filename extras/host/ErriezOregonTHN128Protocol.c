@@ -0,0 +1,310 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Protocol.c
+ * \brief Oregon v1 protocol parameter verification and benchmark
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      Verifies that a decoder set to OregonTHN128_ProtocolTHN128 decodes exactly the same frames
+ *      as OregonTHN128_DecodePulses() from a jittered edge stream, and that a sibling protocol
+ *      with a 25% faster clock and a tighter tolerance is received by the same decoder with
+ *      OregonTHN128_DecoderSetProtocol(). The decode time per edge of the THN128 instance,
+ *      specialized at compile time, and of the sibling protocol, read at run time, is written as
+ *      JSON to stdout. Exits with 1 on a mismatch.
+ *
+ *      Build and run on a Linux host from the repository root:
+ *
+ *      gcc -O2 -Isrc src/ErriezOregonTHN128.c src/ErriezOregonTHN128Decoder.c \
+ *          src/ErriezOregonTHN128Encoder.c extras/host/ErriezOregonTHN128Protocol.c -o protocol
+ *      ./protocol > protocol.json
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ErriezOregonTHN128.h"
+#include "ErriezOregonTHN128Decoder.h"
+#include "ErriezOregonTHN128Encoder.h"
+
+/*! Number of frames in the edge stream */
+#define NUM_FRAMES          20000
+
+/*! Maximum number of levels per frame: frame, noise and idle */
+#define MAX_LEVELS_FRAME    (OREGON_THN128_FRAME_EDGES_MAX + 8)
+
+/*! Minimum decode time in seconds to measure the decode rate */
+#define T_MEASURE_MIN_S     0.2
+
+/*!
+ * \brief THN128 style sensor with a 25% faster clock
+ */
+static const OregonTHN128Protocol_t _fastSensor = {
+    (T_SYNC_US * 4) / 5,        /* tSyncUs */
+    (T_BIT_US * 4) / 5,         /* tBitUs */
+    (T_RX_TOLERANCE_US * 4) / 5, /* tToleranceUs */
+    32,                         /* numBits */
+    OregonTHN128_CheckCRC,      /* checkCrc */
+    OregonTHN128_IsPlausible,   /* isPlausible */
+    OregonTHN128_RawToData,     /* rawToData */
+    OregonTHN128_DataToRaw      /* dataToRaw */
+};
+
+/*!
+ * \brief Edge stream
+ */
+typedef struct {
+    uint16_t *durations;    /*!< Level durations in us */
+    uint8_t *levels;        /*!< Level of each duration */
+    size_t n;               /*!< Number of durations */
+    uint32_t *frames;       /*!< Transmitted frames */
+} Edges_t;
+
+/*! Prevent the compiler from removing benchmarked code */
+static volatile uint32_t _sink;
+
+/*! Pseudo random generator state */
+static uint64_t _rng = 0x2545f4914f6cdd1dULL;
+
+/*!
+ * \brief Pseudo random generator (xorshift64*)
+ */
+static uint32_t random32(void)
+{
+    _rng ^= _rng >> 12;
+    _rng ^= _rng << 25;
+    _rng ^= _rng >> 27;
+
+    return (uint32_t)((_rng * 0x2545f4914f6cdd1dULL) >> 32);
+}
+
+/*!
+ * \brief Get monotonic time in seconds
+ */
+static double timeNow(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + (ts.tv_nsec * 1e-9);
+}
+
+/*!
+ * \brief Random reading with a valid checksum
+ */
+static uint32_t randomFrame(void)
+{
+    OregonTHN128Data_t data;
+
+    data.rollingAddress = random32() % 8;
+    data.channel = 1 + (random32() % 3);
+    data.temperature = (int16_t)((random32() % 1999) - 999);
+    data.lowBattery = random32() & 1;
+
+    return OregonTHN128_DataToRaw(&data);
+}
+
+/*!
+ * \brief Render frames with +/-jitter us, noise and idle levels
+ * \param edges
+ *      Edge stream output
+ * \param scalePercent
+ *      Transmit clock in percent of the THN128 clock
+ * \param jitter
+ *      Maximum jitter per level in us
+ */
+static void generateEdges(Edges_t *edges, uint32_t scalePercent, uint32_t jitter)
+{
+    uint16_t durations[OREGON_THN128_FRAME_EDGES_MAX];
+    uint8_t levels[OREGON_THN128_FRAME_EDGES_MAX];
+    size_t n;
+
+    edges->n = 0;
+    for (size_t frame = 0; frame < NUM_FRAMES; frame++) {
+        edges->frames[frame] = randomFrame();
+        n = OregonTHN128_EncodeEdges(edges->frames[frame], durations, levels,
+                                     OREGON_THN128_FRAME_EDGES_MAX);
+        for (size_t i = 0; i < n; i++) {
+            edges->durations[edges->n] = (uint16_t)(((durations[i] * scalePercent) / 100) +
+                                                    (random32() % ((2 * jitter) + 1)) - jitter);
+            edges->levels[edges->n++] = levels[i];
+        }
+
+        /* Noise between frames */
+        for (uint32_t i = random32() % 4; i > 0; i--) {
+            edges->durations[edges->n] = (uint16_t)(500 + (random32() % 8000));
+            edges->levels[edges->n] = (edges->levels[edges->n - 1] == 0);
+            edges->n++;
+        }
+        if (edges->levels[edges->n - 1]) {
+            edges->durations[edges->n] = 20000;
+            edges->levels[edges->n++] = 0;
+        }
+    }
+}
+
+/*!
+ * \brief Store frames of OregonTHN128_DecodePulses()
+ */
+static void frameReceived(uint32_t rawData, void *arg)
+{
+    uint32_t **frames = (uint32_t **)arg;
+
+    *(*frames)++ = rawData;
+}
+
+/*!
+ * \brief Decode the stream with a protocol
+ * \param edges
+ *      Edge stream
+ * \param protocol
+ *      Protocol of the decoder
+ * \param frames
+ *      Output received frames, can be NULL
+ * \return
+ *      Number of frames
+ */
+static size_t decode(const Edges_t *edges, const OregonTHN128Protocol_t *protocol,
+                     uint32_t *frames)
+{
+    OregonTHN128Decoder_t dec;
+    uint32_t rawData;
+    size_t numFrames = 0;
+
+    OregonTHN128_DecoderInit(&dec);
+    OregonTHN128_DecoderSetProtocol(&dec, protocol);
+    for (size_t i = 0; i < edges->n; i++) {
+        if (OregonTHN128_DecodeEdge(&dec, edges->durations[i], edges->levels[i] != 0, &rawData)) {
+            if (frames) {
+                frames[numFrames] = rawData;
+            }
+            numFrames++;
+        }
+    }
+
+    return numFrames;
+}
+
+/*!
+ * \brief Count the frames equal to the transmitted frames, in order
+ */
+static size_t countTransmitted(const Edges_t *edges, const uint32_t *frames, size_t numFrames)
+{
+    size_t matched = 0;
+    size_t j = 0;
+
+    for (size_t i = 0; (i < numFrames) && (j < NUM_FRAMES); i++) {
+        while ((j < NUM_FRAMES) && (edges->frames[j] != frames[i])) {
+            j++;
+        }
+        if (j < NUM_FRAMES) {
+            matched++;
+            j++;
+        }
+    }
+
+    return matched;
+}
+
+/*!
+ * \brief Measure decode time per edge in ns
+ */
+static double measure(const Edges_t *edges, const OregonTHN128Protocol_t *protocol)
+{
+    double tStart = timeNow();
+    double tElapsed;
+    size_t runs = 0;
+
+    do {
+        _sink += (uint32_t)decode(edges, protocol, NULL);
+        runs++;
+        tElapsed = timeNow() - tStart;
+    } while (tElapsed < T_MEASURE_MIN_S);
+
+    return (tElapsed * 1e9) / ((double)runs * edges->n);
+}
+
+int main(void)
+{
+    Edges_t edges;
+    Edges_t fastEdges;
+    uint32_t *framesPulses = malloc(NUM_FRAMES * 2 * sizeof(uint32_t));
+    uint32_t *framesProtocol = malloc(NUM_FRAMES * 2 * sizeof(uint32_t));
+    uint32_t *framesFast = malloc(NUM_FRAMES * 2 * sizeof(uint32_t));
+    uint32_t *next;
+    size_t numPulses;
+    size_t numProtocol;
+    size_t numFast;
+    size_t numFastMatched;
+    size_t numFastThn128;
+    bool framesEqual;
+    double nsPerEdge;
+    double nsPerEdgeSibling;
+
+    edges.durations = malloc(NUM_FRAMES * MAX_LEVELS_FRAME * sizeof(uint16_t));
+    edges.levels = malloc(NUM_FRAMES * MAX_LEVELS_FRAME);
+    edges.frames = malloc(NUM_FRAMES * sizeof(uint32_t));
+    fastEdges.durations = malloc(NUM_FRAMES * MAX_LEVELS_FRAME * sizeof(uint16_t));
+    fastEdges.levels = malloc(NUM_FRAMES * MAX_LEVELS_FRAME);
+    fastEdges.frames = malloc(NUM_FRAMES * sizeof(uint32_t));
+    if (!framesPulses || !framesProtocol || !framesFast || !edges.durations || !edges.levels ||
+        !edges.frames || !fastEdges.durations || !fastEdges.levels || !fastEdges.frames) {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+
+    generateEdges(&edges, 100, 250);
+    generateEdges(&fastEdges, 80, 200);
+
+    /* THN128 protocol: same frames as the default decoder */
+    next = framesPulses;
+    numPulses = OregonTHN128_DecodePulses(edges.durations, edges.levels, edges.n, frameReceived,
+                                          &next);
+    numProtocol = decode(&edges, &OregonTHN128_ProtocolTHN128, framesProtocol);
+    framesEqual = (numPulses == numProtocol) &&
+                  (memcmp(framesPulses, framesProtocol, numPulses * sizeof(uint32_t)) == 0);
+
+    /* Sibling protocol */
+    numFast = decode(&fastEdges, &_fastSensor, framesFast);
+    numFastMatched = countTransmitted(&fastEdges, framesFast, numFast);
+    numFastThn128 = decode(&fastEdges, &OregonTHN128_ProtocolTHN128, NULL);
+
+    nsPerEdge = measure(&edges, &OregonTHN128_ProtocolTHN128);
+    nsPerEdgeSibling = measure(&fastEdges, &_fastSensor);
+
+    printf("{\n  \"frames\": %d,\n  \"edges\": %zu,\n  \"decode_pulses_frames\": %zu,\n"
+           "  \"protocol_frames\": %zu,\n  \"frames_equal\": %s,\n"
+           "  \"sibling_frames\": %zu,\n  \"sibling_matched\": %zu,\n"
+           "  \"sibling_thn128_frames\": %zu,\n  \"ns_per_edge\": %.3f,\n"
+           "  \"ns_per_edge_sibling\": %.3f\n}\n",
+           NUM_FRAMES, edges.n, numPulses, numProtocol, framesEqual ? "true" : "false",
+           numFast, numFastMatched, numFastThn128, nsPerEdge, nsPerEdgeSibling);
+
+    return (framesEqual && (numFastMatched == numFast) &&
+            (numFast >= (numProtocol * 99) / 100)) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,250 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128RegistrySim.c
+ * \brief Oregon THN128 sensor registry address change simulation
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      Feeds frames of sensors transmitting every 30 seconds to ErriezOregonTHN128Registry.c,
+ *      with OregonTHN128_RegistryTick() every second:
+ *      - Live pair: two sensors on one channel, the second one starts 1..29 seconds after a
+ *        frame of the first one. One frame of the first or of the second sensor around the start
+ *        is dropped. No address change may be reported.
+ *      - Battery swap: a sensor is silent for 30 seconds to 10 minutes and continues with a new
+ *        rolling address, with and without a live sensor on the same channel. An address change
+ *        is expected only when the silence is at least OREGON_THN128_REGISTRY_SWAP_MS, and only
+ *        for the silent sensor.
+ *
+ *      The results are written as JSON to stdout. Exits with 1 when an event is not as expected.
+ *
+ *      Build and run on a Linux host from the repository root:
+ *
+ *      gcc -O2 -Isrc src/ErriezOregonTHN128.c src/ErriezOregonTHN128Registry.c \
+ *          extras/host/ErriezOregonTHN128RegistrySim.c -o registrysim
+ *      ./registrysim > registrysim.json
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "ErriezOregonTHN128.h"
+#include "ErriezOregonTHN128Registry.h"
+
+/*! Transmit interval of the sensors in ms */
+#define T_INTERVAL_MS       30000UL
+
+/*! Simulated time per case in ms */
+#define T_RUN_MS            (20 * 60 * 1000UL)
+
+/*! Stale timeout in ms */
+#define T_STALE_MS          (2 * 60 * 1000UL)
+
+/*! No frame dropped, sensor does not stop */
+#define NONE                UINT32_MAX
+
+/*! Maximum number of simulated sensors */
+#define SIM_SENSORS_MAX     3
+
+/*!
+ * \brief Simulated sensor
+ */
+typedef struct {
+    uint8_t channel;            /*!< Channel */
+    uint8_t rollingAddress;     /*!< Rolling address */
+    uint32_t tStart;            /*!< Time of the first frame in ms */
+    uint32_t tStop;             /*!< No frames from this time in ms, NONE: never */
+    uint32_t drop;              /*!< Index of the dropped frame, NONE: none */
+    uint32_t events[4];         /*!< Registry events per OregonTHN128SensorEvent_t */
+} SimSensor_t;
+
+/*!
+ * \brief Run a case
+ * \param sensors
+ *      Simulated sensors
+ * \param n
+ *      Number of sensors
+ * \param reg
+ *      Sensor registry, initialized by this function
+ */
+static void runCase(SimSensor_t *sensors, uint8_t n, OregonTHN128Registry_t *reg)
+{
+    OregonTHN128Data_t data;
+    uint32_t index;
+
+    OregonTHN128_RegistryInit(reg, T_STALE_MS);
+
+    for (uint32_t t = 0; t < T_RUN_MS; t += 1000) {
+        for (uint8_t i = 0; i < n; i++) {
+            SimSensor_t *sim = &sensors[i];
+
+            if ((t < sim->tStart) || (t >= sim->tStop) ||
+                (((t - sim->tStart) % T_INTERVAL_MS) != 0)) {
+                continue;
+            }
+            index = (t - sim->tStart) / T_INTERVAL_MS;
+            if (index == sim->drop) {
+                continue;
+            }
+
+            data.channel = sim->channel;
+            data.rollingAddress = sim->rollingAddress;
+            data.temperature = 200 + i;
+            data.lowBattery = false;
+            data.rawData = OregonTHN128_DataToRaw(&data);
+            sim->events[OregonTHN128_RegistryUpdate(reg, &data, t, NULL)]++;
+        }
+        OregonTHN128_RegistryTick(reg, t);
+    }
+}
+
+/*!
+ * \brief Live pair cases
+ * \param cases
+ *      Output number of cases
+ * \return
+ *      Number of reported address changes
+ */
+static uint32_t livePair(uint32_t *cases)
+{
+    OregonTHN128Registry_t reg;
+    SimSensor_t sensors[2];
+    uint32_t changes = 0;
+
+    /* Drop 0: frame of the first sensor before the start of the second sensor, 1: first frame
+     * of the second sensor, 2: frame of the first sensor after the start of the second sensor */
+    *cases = 0;
+    for (uint8_t drop = 0; drop < 3; drop++) {
+        for (uint32_t offset = 1000; offset < T_INTERVAL_MS; offset += 1000) {
+            SimSensor_t first = { 1, 3, 0, NONE, (drop == 0) ? 2 : ((drop == 2) ? 3 : NONE),
+                                  { 0 } };
+            SimSensor_t second = { 1, 5, (2 * T_INTERVAL_MS) + offset, NONE,
+                                   (drop == 1) ? 0 : NONE, { 0 } };
+
+            sensors[0] = first;
+            sensors[1] = second;
+            runCase(sensors, 2, &reg);
+
+            changes += sensors[0].events[OregonTHN128SensorAddressChanged] +
+                       sensors[1].events[OregonTHN128SensorAddressChanged];
+            if (!OregonTHN128_RegistryFind(&reg, 1, 3) || !OregonTHN128_RegistryFind(&reg, 1, 5)) {
+                changes++;
+            }
+            (*cases)++;
+        }
+    }
+
+    return changes;
+}
+
+/*!
+ * \brief Battery swap case
+ * \param silenceMs
+ *      Silence between the last frame with the old and the first frame with the new rolling
+ *      address
+ * \param neighbour
+ *      Live sensor on the same channel
+ * \param event
+ *      Output event of the first frame with the new rolling address
+ * \return
+ *      true: Events as expected
+ */
+static bool batterySwap(uint32_t silenceMs, bool neighbour, uint8_t *event)
+{
+    OregonTHN128Registry_t reg;
+    OregonTHN128Sensor_t *entry;
+    SimSensor_t sensors[SIM_SENSORS_MAX];
+    bool expectChange = (silenceMs >= OREGON_THN128_REGISTRY_SWAP_MS);
+    SimSensor_t before = { 1, 3, 0, (9 * T_INTERVAL_MS) + 1, NONE, { 0 } };
+    SimSensor_t after = { 1, 6, (9 * T_INTERVAL_MS) + silenceMs, NONE, NONE, { 0 } };
+    SimSensor_t live = { 1, 5, 15000, NONE, NONE, { 0 } };
+    uint8_t n = 0;
+
+    sensors[n++] = before;
+    sensors[n++] = after;
+    if (neighbour) {
+        sensors[n++] = live;
+    }
+    runCase(sensors, n, &reg);
+
+    *event = sensors[1].events[OregonTHN128SensorAddressChanged] ?
+             OregonTHN128SensorAddressChanged : OregonTHN128SensorNew;
+
+    /* The new rolling address continues the entry of the silent sensor only */
+    entry = OregonTHN128_RegistryFind(&reg, 1, 6);
+    if ((entry == NULL) || (sensors[1].events[OregonTHN128SensorAddressChanged] != expectChange) ||
+        (sensors[1].events[OregonTHN128SensorNew] == expectChange)) {
+        return false;
+    }
+    if (expectChange && ((entry->previousRollingAddress != 3) ||
+                         OregonTHN128_RegistryFind(&reg, 1, 3))) {
+        return false;
+    }
+    if (neighbour && ((sensors[2].events[OregonTHN128SensorNew] != 1) ||
+                      sensors[2].events[OregonTHN128SensorAddressChanged] ||
+                      !OregonTHN128_RegistryFind(&reg, 1, 5))) {
+        return false;
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Registry simulation
+ */
+int main(void)
+{
+    static const uint32_t silences[] = { 30000, 60000, 65000, 90000, 120000, 600000 };
+    uint32_t liveCases;
+    uint32_t liveChanges;
+    bool ok;
+    bool swapOk;
+    uint8_t event;
+
+    liveChanges = livePair(&liveCases);
+    ok = (liveChanges == 0);
+
+    printf("{\n");
+    printf("  \"swap_ms\": %lu,\n", (unsigned long)OREGON_THN128_REGISTRY_SWAP_MS);
+    printf("  \"live_pair\": {\"cases\": %u, \"address_changes\": %u},\n", liveCases, liveChanges);
+    printf("  \"battery_swap\": [\n");
+    for (size_t i = 0; i < (sizeof(silences) / sizeof(silences[0])); i++) {
+        for (uint8_t neighbour = 0; neighbour < 2; neighbour++) {
+            swapOk = batterySwap(silences[i], neighbour, &event);
+            ok &= swapOk;
+            printf("    {\"silence_s\": %u, \"neighbour\": %s, \"event\": \"%s\", \"ok\": %s}%s\n",
+                   silences[i] / 1000, neighbour ? "true" : "false",
+                   (event == OregonTHN128SensorAddressChanged) ? "address_changed" : "new",
+                   swapOk ? "true" : "false",
+                   ((i + 1) < (sizeof(silences) / sizeof(silences[0])) || !neighbour) ? "," : "");
+        }
+    }
+    printf("  ],\n");
+    printf("  \"pass\": %s\n", ok ? "true" : "false");
+    printf("}\n");
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
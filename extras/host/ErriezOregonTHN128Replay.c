@@ -0,0 +1,797 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Replay.c
+ * \brief Oregon THN128 Saleae capture replay and regression tool
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      Decodes digital captures of a 433MHz receiver with the library receive state machine.
+ *      Supported input files:
+ *      - Saleae Logic CSV export: "Time [s],RX" header followed by "<time>,<state>" rows
+ *      - Saleae Logic 2 binary export (digital, version 0)
+ *      - Saleae Logic 2 .sal capture: a zip file with the samples of each digital channel in
+ *        digital-<channel>.bin (version 1, type 100)
+ *
+ *      The samples in a .sal capture are run-length encoded in chunks. The layout is not
+ *      documented by Saleae and was read from captures of Logic 2.3, every chunk is checked
+ *      against its sample count and an unknown layout is rejected.
+ *
+ *      Regression: when a file name contains the expected reading in the same format as
+ *      extras/SaleaeLogicAnalyzer/RX_rol7_channel1_temp20.7_lowbat0.sal, the capture passes only
+ *      when this reading is decoded. When a directory is passed, all .sal, .csv and .bin files in
+ *      the directory are replayed.
+ *
+ *      Build and run on a Linux host from the repository root:
+ *
+ *      gcc -O2 -Isrc src/ErriezOregonTHN128.c src/ErriezOregonTHN128Decoder.c \
+ *          extras/host/ErriezOregonTHN128Replay.c -o replay -lz
+ *      ./replay [-c column] [-q] <capture.sal|capture.csv|capture.bin|directory>...
+ */
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <zlib.h>
+#include "ErriezOregonTHN128.h"
+#include "ErriezOregonTHN128Decoder.h"
+
+/*! Minimum decode time in seconds to measure the decode rate */
+#define T_MEASURE_MIN_S     0.2
+
+/*! Size of the Logic 2 chunk footer in Bytes */
+#define SAL_FOOTER_SIZE     28
+
+/*! Offset of the initial level of a chunk in the footer */
+#define SAL_FOOTER_LEVEL    24
+
+/*! Maximum size of a file in a .sal capture */
+#define SAL_FILE_MAX        (256UL * 1024 * 1024)
+
+/*!
+ * \brief Edge stream
+ */
+typedef struct {
+    uint16_t *durations;    /*!< Level durations in us */
+    uint8_t *levels;        /*!< Level of each duration */
+    size_t n;               /*!< Number of durations */
+    size_t size;            /*!< Allocated number of durations */
+} Edges_t;
+
+/*!
+ * \brief Little endian reader of a memory buffer
+ */
+typedef struct {
+    const uint8_t *data;    /*!< Buffer */
+    size_t len;             /*!< Buffer size */
+    size_t pos;             /*!< Read position */
+    bool error;             /*!< Read beyond the end of the buffer */
+} Reader_t;
+
+/*!
+ * \brief Expected reading parsed from the file name
+ */
+typedef struct {
+    bool valid;                 /*!< File name contains an expected reading */
+    OregonTHN128Data_t data;    /*!< Expected reading */
+    bool found;                 /*!< Expected reading decoded */
+} Expected_t;
+
+/*!
+ * \brief Replay options
+ */
+typedef struct {
+    int column;             /*!< CSV data column (1 = first column after time) */
+    bool quiet;             /*!< Don't print decoded frames */
+} Options_t;
+
+/*!
+ * \brief Decode context
+ */
+typedef struct {
+    Expected_t *expected;   /*!< Expected reading */
+    bool print;             /*!< Print decoded frames */
+} Replay_t;
+
+/*!
+ * \brief Return monotonic time in seconds
+ */
+static double timeNow(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + (ts.tv_nsec / 1e9);
+}
+
+/*!
+ * \brief Append level with duration in seconds to the edge stream
+ */
+static int addLevel(Edges_t *edges, uint8_t level, double tLevel)
+{
+    double tUs = tLevel * 1e6;
+
+    if (edges->n >= edges->size) {
+        edges->size = edges->size ? (edges->size * 2) : 4096;
+        edges->durations = realloc(edges->durations, edges->size * sizeof(uint16_t));
+        edges->levels = realloc(edges->levels, edges->size * sizeof(uint8_t));
+        if (!edges->durations || !edges->levels) {
+            return -1;
+        }
+    }
+
+    edges->durations[edges->n] = (tUs > 0xffff) ? 0xffff : (uint16_t)(tUs + 0.5);
+    edges->levels[edges->n] = level;
+    edges->n++;
+
+    return 0;
+}
+
+/*!
+ * \brief Read Saleae Logic CSV export
+ */
+static int readCsv(FILE *f, int column, Edges_t *edges)
+{
+    char line[512];
+    double tLast = 0;
+    int levelLast = -1;
+
+    while (fgets(line, sizeof(line), f)) {
+        char *p = line;
+        char *end;
+        double t;
+        int level;
+
+        /* Skip header */
+        t = strtod(p, &end);
+        if (end == p) {
+            continue;
+        }
+
+        /* Select data column */
+        p = end;
+        for (int i = 0; i < column; i++) {
+            p = strchr(p, ',');
+            if (!p) {
+                break;
+            }
+            p++;
+        }
+        if (!p) {
+            fprintf(stderr, "CSV column %d not found\n", column);
+            return -1;
+        }
+        level = atoi(p) ? 1 : 0;
+
+        /* Store level which ended at this transition */
+        if (levelLast < 0) {
+            levelLast = level;
+            tLast = t;
+        } else if (level != levelLast) {
+            if (addLevel(edges, (uint8_t)levelLast, t - tLast) < 0) {
+                return -1;
+            }
+            levelLast = level;
+            tLast = t;
+        }
+    }
+
+    return 0;
+}
+
+/*!
+ * \brief Read a little endian unsigned value of 1 to 8 Bytes
+ */
+static uint64_t readLe(Reader_t *r, size_t n)
+{
+    uint64_t value = 0;
+
+    if ((r->len - r->pos) < n) {
+        r->error = true;
+        r->pos = r->len;
+        return 0;
+    }
+    for (size_t i = 0; i < n; i++) {
+        value |= (uint64_t)r->data[r->pos + i] << (8 * i);
+    }
+    r->pos += n;
+
+    return value;
+}
+
+/*!
+ * \brief Read a little endian double
+ */
+static double readDouble(Reader_t *r)
+{
+    uint64_t bits = readLe(r, sizeof(uint64_t));
+    double value;
+
+    memcpy(&value, &bits, sizeof(value));
+
+    return value;
+}
+
+/*!
+ * \brief Read Saleae Logic 2 binary export, digital version 0
+ */
+static int readExport(Reader_t *r, Edges_t *edges)
+{
+    uint32_t initialState;
+    double tBegin;
+    double tEnd;
+    uint64_t numTransitions;
+    double tLast;
+    uint8_t level;
+
+    initialState = (uint32_t)readLe(r, sizeof(uint32_t));
+    tBegin = readDouble(r);
+    tEnd = readDouble(r);
+    numTransitions = readLe(r, sizeof(uint64_t));
+    if (r->error) {
+        fprintf(stderr, "Truncated Saleae binary header\n");
+        return -1;
+    }
+
+    level = initialState ? 1 : 0;
+    tLast = tBegin;
+    for (uint64_t i = 0; i < numTransitions; i++) {
+        double t = readDouble(r);
+
+        if (r->error) {
+            fprintf(stderr, "Truncated Saleae binary data\n");
+            return -1;
+        }
+        if (addLevel(edges, level, t - tLast) < 0) {
+            return -1;
+        }
+        level ^= 1;
+        tLast = t;
+    }
+
+    return addLevel(edges, level, tEnd - tLast);
+}
+
+/*!
+ * \brief Read a run length from Logic 2 capture data
+ * \details
+ *      Big endian variable length value: the first Byte holds 6 bits and flag 0x40, the next
+ *      Bytes hold 7 bits and flag 0x80 when another Byte follows.
+ */
+static uint64_t readRun(Reader_t *r, size_t end)
+{
+    uint64_t value;
+    uint8_t more;
+    uint8_t b;
+
+    if ((r->pos >= end) || (r->data[r->pos] & 0x80)) {
+        r->error = true;
+        return 0;
+    }
+    b = r->data[r->pos++];
+    value = b & 0x3f;
+    more = b & 0x40;
+    while (more) {
+        if ((r->pos >= end) || (value >> 56)) {
+            r->error = true;
+            return 0;
+        }
+        b = r->data[r->pos++];
+        value = (value << 7) | (b & 0x7f);
+        more = b & 0x80;
+    }
+
+    return value;
+}
+
+/*!
+ * \brief Read Saleae Logic 2 capture data of a digital channel (version 1, type 100)
+ * \details
+ *      Header: sample rate, capture start time, first and last sample, number of chunks.
+ *      Chunk: first and end sample, number of samples, sample rate, numBytes, numBytes run
+ *      lengths minus one of alternating levels, footer with the level of the first run. A run
+ *      continues in the next chunk when the level does not change at the chunk boundary.
+ */
+static int readCaptureData(Reader_t *r, Edges_t *edges)
+{
+    uint64_t numChunks;
+    uint64_t runSamples = 0;
+    double sampleRate = 0;
+    uint8_t runLevel = 0;
+
+    /* Capture header */
+    readLe(r, 1);
+    readDouble(r);
+    readLe(r, sizeof(uint64_t));
+    readDouble(r);
+    readLe(r, 1 + sizeof(uint64_t));
+    readLe(r, 1 + sizeof(uint64_t));
+    numChunks = readLe(r, sizeof(uint64_t));
+
+    for (uint64_t chunk = 0; (chunk < numChunks) && !r->error; chunk++) {
+        uint64_t numSamples;
+        uint64_t numBytes;
+        uint64_t samples = 0;
+        size_t end;
+        uint8_t level;
+
+        readLe(r, sizeof(uint64_t));
+        readLe(r, sizeof(uint64_t));
+        numSamples = readLe(r, sizeof(uint64_t));
+        sampleRate = (double)readLe(r, sizeof(uint64_t));
+        readLe(r, sizeof(uint64_t));
+        numBytes = readLe(r, sizeof(uint64_t));
+        if (r->error || ((r->len - r->pos) < (numBytes + SAL_FOOTER_SIZE)) || (sampleRate <= 0)) {
+            r->error = true;
+            break;
+        }
+        end = r->pos + numBytes;
+        level = r->data[end + SAL_FOOTER_LEVEL] ? 1 : 0;
+
+        while ((r->pos < end) && !r->error) {
+            uint64_t run = readRun(r, end) + 1;
+
+            if ((level != runLevel) && runSamples) {
+                if (addLevel(edges, runLevel, runSamples / sampleRate) < 0) {
+                    return -1;
+                }
+                runSamples = 0;
+            }
+            runLevel = level;
+            runSamples += run;
+            samples += run;
+            level ^= 1;
+        }
+
+        /* The run lengths must add up to the chunk */
+        if (samples != numSamples) {
+            r->error = true;
+        }
+        r->pos = end + SAL_FOOTER_SIZE;
+    }
+
+    if (r->error) {
+        fprintf(stderr, "Unsupported or corrupted Saleae capture data\n");
+        return -1;
+    }
+
+    return runSamples ? addLevel(edges, runLevel, runSamples / sampleRate) : 0;
+}
+
+/*!
+ * \brief Read Saleae binary data: Logic 2 export or capture data from a .sal file
+ */
+static int readBinary(const uint8_t *data, size_t len, Edges_t *edges)
+{
+    Reader_t r = { .data = data, .len = len };
+    int32_t version;
+    int32_t type;
+
+    if ((len < 16) || (memcmp(data, "<SALEAE>", 8) != 0)) {
+        fprintf(stderr, "Not a Saleae binary file\n");
+        return -1;
+    }
+    r.pos = 8;
+    version = (int32_t)readLe(&r, sizeof(int32_t));
+    type = (int32_t)readLe(&r, sizeof(int32_t));
+
+    if ((version == 0) && (type == 0)) {
+        return readExport(&r, edges);
+    }
+    if ((version == 1) && (type == 100)) {
+        return readCaptureData(&r, edges);
+    }
+
+    fprintf(stderr, "Unsupported Saleae binary version %d type %d, export digital data as CSV\n",
+            version, type);
+
+    return -1;
+}
+
+/*!
+ * \brief Extract a file from a zip archive
+ * \details
+ *      Sizes are read from the central directory, Logic 2 writes data descriptors.
+ * \return
+ *      Uncompressed file allocated with malloc(), NULL when not found or on error
+ */
+static uint8_t *zipExtract(const uint8_t *zip, size_t zipLen, const char *name, size_t *len)
+{
+    Reader_t r = { .data = zip, .len = zipLen };
+    size_t eocd = zipLen;
+    size_t nameLen = strlen(name);
+    uint64_t numEntries;
+
+    /* End of central directory record, followed by a comment of up to 64kB */
+    for (size_t i = 22; (i <= zipLen) && (i <= (22 + 0xffff)); i++) {
+        if (memcmp(&zip[zipLen - i], "PK\x05\x06", 4) == 0) {
+            eocd = zipLen - i;
+            break;
+        }
+    }
+    if (eocd == zipLen) {
+        return NULL;
+    }
+    r.pos = eocd + 10;
+    numEntries = readLe(&r, 2);
+    readLe(&r, 4);
+    r.pos = readLe(&r, 4);
+
+    for (uint64_t i = 0; (i < numEntries) && !r.error; i++) {
+        size_t entry = r.pos;
+        uint16_t method;
+        uint32_t compressedSize;
+        uint32_t size;
+        uint16_t entryNameLen;
+        uint16_t extraLen;
+        uint16_t commentLen;
+        uint32_t localOffset;
+        uint16_t localNameLen;
+        uint16_t localExtraLen;
+        uint8_t *out;
+
+        if ((readLe(&r, 4) != 0x02014b50UL)) {
+            break;
+        }
+        r.pos = entry + 10;
+        method = (uint16_t)readLe(&r, 2);
+        r.pos = entry + 20;
+        compressedSize = (uint32_t)readLe(&r, 4);
+        size = (uint32_t)readLe(&r, 4);
+        entryNameLen = (uint16_t)readLe(&r, 2);
+        extraLen = (uint16_t)readLe(&r, 2);
+        commentLen = (uint16_t)readLe(&r, 2);
+        r.pos = entry + 42;
+        localOffset = (uint32_t)readLe(&r, 4);
+        if (r.error || ((zipLen - r.pos) < entryNameLen)) {
+            break;
+        }
+
+        if ((entryNameLen != nameLen) || (memcmp(&zip[r.pos], name, nameLen) != 0)) {
+            r.pos += (size_t)entryNameLen + extraLen + commentLen;
+            continue;
+        }
+
+        /* Local file header */
+        r.pos = (size_t)localOffset + 26;
+        localNameLen = (uint16_t)readLe(&r, 2);
+        localExtraLen = (uint16_t)readLe(&r, 2);
+        r.pos += (size_t)localNameLen + localExtraLen;
+        if (r.error || (r.pos > zipLen) || ((zipLen - r.pos) < compressedSize) ||
+            (size > SAL_FILE_MAX)) {
+            return NULL;
+        }
+
+        out = malloc(size ? size : 1);
+        if (!out) {
+            return NULL;
+        }
+        if (method == 0) {
+            memcpy(out, &zip[r.pos], size);
+        } else {
+            z_stream zs;
+            int ret;
+
+            memset(&zs, 0, sizeof(zs));
+            if ((method != Z_DEFLATED) || (inflateInit2(&zs, -MAX_WBITS) != Z_OK)) {
+                free(out);
+                return NULL;
+            }
+            zs.next_in = (Bytef *)&zip[r.pos];
+            zs.avail_in = compressedSize;
+            zs.next_out = out;
+            zs.avail_out = size;
+            ret = inflate(&zs, Z_FINISH);
+            inflateEnd(&zs);
+            if ((ret != Z_STREAM_END) || (zs.total_out != size)) {
+                free(out);
+                return NULL;
+            }
+        }
+        *len = size;
+
+        return out;
+    }
+
+    return NULL;
+}
+
+/*!
+ * \brief Read a digital channel of a Saleae Logic 2 .sal capture
+ */
+static int readSal(const uint8_t *zip, size_t zipLen, int channel, Edges_t *edges)
+{
+    char name[32];
+    uint8_t *data;
+    size_t len;
+    int ret;
+
+    snprintf(name, sizeof(name), "digital-%d.bin", channel);
+    data = zipExtract(zip, zipLen, name, &len);
+    if (!data) {
+        fprintf(stderr, "No %s in .sal capture\n", name);
+        return -1;
+    }
+
+    ret = readBinary(data, len, edges);
+    free(data);
+
+    return ret;
+}
+
+/*!
+ * \brief Read capture file into edge stream
+ */
+static int readCapture(const char *fileName, const Options_t *options, Edges_t *edges)
+{
+    char magic[8] = { 0 };
+    uint8_t *data = NULL;
+    long len;
+    FILE *f;
+    int ret;
+
+    f = fopen(fileName, "rb");
+    if (!f) {
+        perror(fileName);
+        return -1;
+    }
+
+    /* Detect file format */
+    if (fread(magic, 1, sizeof(magic), f) < 2) {
+        magic[0] = '\0';
+    }
+    rewind(f);
+
+    if ((memcmp(magic, "PK", 2) == 0) || (memcmp(magic, "<SALEAE>", sizeof(magic)) == 0)) {
+        /* Read binary file into memory */
+        if ((fseek(f, 0, SEEK_END) != 0) || ((len = ftell(f)) < 0) ||
+            ((unsigned long)len > SAL_FILE_MAX) || (fseek(f, 0, SEEK_SET) != 0) ||
+            ((data = malloc(len ? (size_t)len : 1)) == NULL) ||
+            (fread(data, 1, (size_t)len, f) != (size_t)len)) {
+            fprintf(stderr, "%s: read error\n", fileName);
+            ret = -1;
+        } else if (magic[0] == 'P') {
+            ret = readSal(data, (size_t)len, options->column - 1, edges);
+        } else {
+            ret = readBinary(data, (size_t)len, edges);
+        }
+        free(data);
+    } else {
+        ret = readCsv(f, options->column, edges);
+    }
+
+    fclose(f);
+
+    return ret;
+}
+
+/*!
+ * \brief Parse expected reading from file name
+ * \details
+ *      Format: ..._rol<address>_channel<channel>_temp<temperature>_lowbat<0|1>...
+ */
+static void parseExpected(const char *fileName, Expected_t *expected)
+{
+    const char *baseName = strrchr(fileName, '/');
+    const char *p;
+    int rol;
+    int channel;
+    float temperature;
+    int lowBattery;
+
+    memset(expected, 0, sizeof(Expected_t));
+
+    baseName = baseName ? (baseName + 1) : fileName;
+    p = strstr(baseName, "rol");
+    if (p && (sscanf(p, "rol%d_channel%d_temp%f_lowbat%d",
+                     &rol, &channel, &temperature, &lowBattery) == 4)) {
+        expected->valid = true;
+        expected->data.rollingAddress = (uint8_t)rol;
+        expected->data.channel = (uint8_t)channel;
+        expected->data.temperature = (int16_t)((temperature * 10) + ((temperature < 0) ? -0.5 : 0.5));
+        expected->data.lowBattery = lowBattery ? true : false;
+    }
+}
+
+/*!
+ * \brief Decode callback
+ */
+static void frameReceived(uint32_t rawData, void *arg)
+{
+    Replay_t *replay = arg;
+    OregonTHN128Data_t data;
+    char temperatureStr[10];
+
+    OregonTHN128_RawToData(rawData, &data);
+
+    if (replay->print) {
+        OregonTHN128_TempToString(temperatureStr, sizeof(temperatureStr), data.temperature);
+        printf("  Rol: %d, Channel %d, Temp: %s, Low batt: %d (0x%08lx)\n",
+               data.rollingAddress, data.channel, temperatureStr, data.lowBattery,
+               (unsigned long)rawData);
+    }
+
+    if (replay->expected->valid &&
+        (data.rollingAddress == replay->expected->data.rollingAddress) &&
+        (data.channel == replay->expected->data.channel) &&
+        (data.temperature == replay->expected->data.temperature) &&
+        (data.lowBattery == replay->expected->data.lowBattery)) {
+        replay->expected->found = true;
+    }
+}
+
+/*!
+ * \brief Replay one capture file
+ * \retval 0
+ *      Pass
+ * \retval 1
+ *      Fail
+ */
+static int replayFile(const char *fileName, const Options_t *options)
+{
+    Edges_t edges = { 0 };
+    Expected_t expected;
+    Replay_t replay = { .expected = &expected, .print = !options->quiet };
+    size_t numFrames;
+    size_t numRuns = 0;
+    double tStart;
+    double tElapsed;
+    int ret = 1;
+
+    printf("%s:\n", fileName);
+
+    if (readCapture(fileName, options, &edges) < 0) {
+        printf("  FAIL: read error\n");
+        goto out;
+    }
+
+    /* Decode once and print frames */
+    parseExpected(fileName, &expected);
+    numFrames = OregonTHN128_DecodePulses(edges.durations, edges.levels, edges.n,
+                                          frameReceived, &replay);
+
+    /* Measure decode rate */
+    replay.print = false;
+    tStart = timeNow();
+    do {
+        OregonTHN128_DecodePulses(edges.durations, edges.levels, edges.n, frameReceived, &replay);
+        numRuns++;
+        tElapsed = timeNow() - tStart;
+    } while (tElapsed < T_MEASURE_MIN_S);
+
+    printf("  %zu edges, %zu frames, %.1f Medges/s\n",
+           edges.n, numFrames, (edges.n * numRuns) / tElapsed / 1e6);
+
+    if (expected.valid && !expected.found) {
+        printf("  FAIL: expected reading not decoded\n");
+    } else if (!expected.valid && (numFrames == 0)) {
+        printf("  FAIL: no frames decoded\n");
+    } else {
+        printf("  PASS\n");
+        ret = 0;
+    }
+
+out:
+    free(edges.durations);
+    free(edges.levels);
+
+    return ret;
+}
+
+/*!
+ * \brief Compare strings for qsort()
+ */
+static int compareNames(const void *a, const void *b)
+{
+    return strcmp(*(const char * const *)a, *(const char * const *)b);
+}
+
+/*!
+ * \brief Replay all .sal, .csv and .bin captures in a directory
+ */
+static int replayDirectory(const char *dirName, const Options_t *options, int *numFiles)
+{
+    struct dirent *entry;
+    char **fileNames = NULL;
+    size_t n = 0;
+    int failed = 0;
+    DIR *dir;
+
+    dir = opendir(dirName);
+    if (!dir) {
+        perror(dirName);
+        return 1;
+    }
+
+    while ((entry = readdir(dir)) != NULL) {
+        const char *ext = strrchr(entry->d_name, '.');
+
+        if (ext && ((strcmp(ext, ".sal") == 0) || (strcmp(ext, ".csv") == 0) ||
+                    (strcmp(ext, ".bin") == 0))) {
+            fileNames = realloc(fileNames, (n + 1) * sizeof(char *));
+            fileNames[n] = malloc(strlen(dirName) + strlen(entry->d_name) + 2);
+            sprintf(fileNames[n], "%s/%s", dirName, entry->d_name);
+            n++;
+        }
+    }
+    closedir(dir);
+
+    /* Replay in a reproducible order */
+    qsort(fileNames, n, sizeof(char *), compareNames);
+    for (size_t i = 0; i < n; i++) {
+        failed += replayFile(fileNames[i], options);
+        free(fileNames[i]);
+    }
+    free(fileNames);
+
+    *numFiles += (int)n;
+
+    return failed;
+}
+
+int main(int argc, char *argv[])
+{
+    Options_t options = { .column = 1, .quiet = false };
+    int numFiles = 0;
+    int failed = 0;
+    int i;
+
+    for (i = 1; (i < argc) && (argv[i][0] == '-'); i++) {
+        if ((strcmp(argv[i], "-c") == 0) && ((i + 1) < argc)) {
+            options.column = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-q") == 0) {
+            options.quiet = true;
+        } else {
+            break;
+        }
+    }
+    if ((i >= argc) || (options.column < 1)) {
+        fprintf(stderr, "Usage: %s [-c column] [-q] <capture.sal|capture.csv|capture.bin|directory>...\n",
+                argv[0]);
+        fprintf(stderr, "  -c column  CSV data column, 1 = first column after time, .sal digital\n"
+                        "             channel + 1 (default 1)\n");
+        fprintf(stderr, "  -q         Don't print decoded frames\n");
+        return EXIT_FAILURE;
+    }
+
+    for (; i < argc; i++) {
+        struct stat st;
+
+        if ((stat(argv[i], &st) == 0) && S_ISDIR(st.st_mode)) {
+            failed += replayDirectory(argv[i], &options, &numFiles);
+        } else {
+            failed += replayFile(argv[i], &options);
+            numFiles++;
+        }
+    }
+
+    printf("%d captures, %d passed, %d failed\n", numFiles, numFiles - failed, failed);
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,412 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Sweep.c
+ * \brief Oregon THN128 exhaustive codec validation of all 2^32 raw words
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      Runs every 32-bit raw word through OregonTHN128_CheckCRC(), OregonTHN128_IsPlausible(),
+ *      OregonTHN128_RawToData() and, for words with a valid checksum, OregonTHN128_DataToRaw()
+ *      with all cores. Each word is classified:
+ *      - Checksum valid
+ *      - BCD valid: temperature digits 0..9
+ *      - Plausible: channel 1..3 and BCD valid
+ *      - Round-trip stable: DataToRaw(RawToData(word)) == word. Unstable words are counted per
+ *        first cause: rolling address bit 3 (documented as address bit, decoded as bits 0..2),
+ *        unused bits 4, 5, 20 or 22, non-BCD digit, or sign with temperature 0
+ *      The decoded fields are compared with an independent reference decoder.
+ *
+ *      The accidental-accept rate of the 8-bit checksum is measured on all 2^24 frames with a
+ *      valid checksum: exhaustive for all 1 and 2 bit errors, and for 3 and 4 random bit errors
+ *      per frame. Accepted frames which are also plausible are counted separately.
+ *
+ *      The summary is written as JSON to stdout and does not depend on the number of threads.
+ *      Exits with 1 when a release gate fails:
+ *      - exactly 2^24 words have a valid checksum
+ *      - RawToData() and CheckCRC() agree on the checksum of every word
+ *      - the decoded fields of every word equal the reference decoder
+ *      - every valid word without unused bits, non-BCD digits or negative zero round-trips
+ *      - no single bit error is accepted
+ *
+ *      Build and run on a Linux host from the repository root:
+ *
+ *      gcc -O2 -pthread -Isrc src/ErriezOregonTHN128.c extras/host/ErriezOregonTHN128Sweep.c \
+ *          -o sweep
+ *      ./sweep [-t threads] > sweep.json
+ */
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "ErriezOregonTHN128.h"
+
+/*! Raw words per work item of the word sweep */
+#define WORD_CHUNK          (1UL << 24)
+
+/*! Number of work items of the word sweep */
+#define WORD_ITEMS          256
+
+/*! Frames per work item of the bit error sweep */
+#define FRAME_CHUNK         (1UL << 16)
+
+/*! Number of work items of the bit error sweep */
+#define FRAME_ITEMS         256
+
+/*! Random error patterns per frame for 3 and 4 bit errors */
+#define RANDOM_ERRORS       4
+
+/*! Maximum number of bit errors */
+#define MAX_ERRORS          4
+
+/*! Rolling address bit 3 */
+#define ROL_ADDR_BIT3       (1UL << 3)
+
+/*! Bits not used by the codec: 4, 5, 20 and 22 */
+#define UNUSED_BITS         ((1UL << 4) | (1UL << 5) | (1UL << 20) | (1UL << 22))
+
+/*!
+ * \brief Round-trip failure causes
+ */
+typedef enum {
+    CauseRollingAddressBit3 = 0,    /*!< Rolling address bit 3 set */
+    CauseUnusedBits = 1,            /*!< Unused bit set */
+    CauseNonBcd = 2,                /*!< Temperature digit 10..15 */
+    CauseNegativeZero = 3,          /*!< Sign bit with temperature 0 */
+    CauseOther = 4,                 /*!< Not explained: codec bug */
+    Causes = 5                      /*!< Number of causes */
+} Cause_t;
+
+/*!
+ * \brief Counters of one work item
+ */
+typedef struct {
+    uint64_t words;                 /*!< Words checked */
+    uint64_t crcValid;              /*!< Valid checksum */
+    uint64_t bcdValid;              /*!< Temperature digits 0..9 */
+    uint64_t plausible;             /*!< OregonTHN128_IsPlausible() */
+    uint64_t crcValidPlausible;     /*!< Valid checksum and plausible */
+    uint64_t crcMismatch;           /*!< RawToData() and CheckCRC() disagree */
+    uint64_t decodeMismatch;        /*!< Decoded fields differ from the reference */
+    uint64_t plausibleMismatch;     /*!< IsPlausible() differs from the reference */
+    uint64_t tempOutOfRange;        /*!< Decoded temperature outside -999..999 */
+    uint64_t roundTripStable;       /*!< Valid checksum and round-trip stable */
+    uint64_t unstable[Causes];      /*!< Valid checksum, not round-trip stable, per cause */
+    uint64_t frames;                /*!< Valid frames with bit errors applied */
+    uint64_t patterns[MAX_ERRORS + 1]; /*!< Error patterns per number of bit errors */
+    uint64_t accepted[MAX_ERRORS + 1]; /*!< Accepted by the checksum */
+    uint64_t acceptedPlausible[MAX_ERRORS + 1]; /*!< Accepted and plausible */
+} Counters_t;
+
+/*! Work item results */
+static Counters_t _results[WORD_ITEMS + FRAME_ITEMS];
+/*! Next work item */
+static atomic_size_t _nextItem;
+
+/*!
+ * \brief Pseudo random generator (xorshift64*)
+ */
+static uint64_t random64(uint64_t *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+
+    return *state * 0x2545f4914f6cdd1dULL;
+}
+
+/*!
+ * \brief Reference checksum: sum of bytes 0..2 with end-around carry
+ */
+static uint8_t refChecksum(uint32_t rawData)
+{
+    uint32_t sum = ((rawData >> 16) & 0xff) + ((rawData >> 8) & 0xff) + (rawData & 0xff);
+
+    return (uint8_t)((sum >> 8) + (sum & 0xff));
+}
+
+/*!
+ * \brief Reference BCD check
+ */
+static bool refBcdValid(uint32_t rawData)
+{
+    return (((rawData >> 16) & 0x0f) <= 9) && (((rawData >> 12) & 0x0f) <= 9) &&
+           (((rawData >> 8) & 0x0f) <= 9);
+}
+
+/*!
+ * \brief Compare decoded fields with the reference decoder
+ */
+static bool refFieldsEqual(uint32_t rawData, const OregonTHN128Data_t *data)
+{
+    int16_t temperature = (int16_t)((((rawData >> 16) & 0x0f) * 100) +
+                                    (((rawData >> 12) & 0x0f) * 10) + ((rawData >> 8) & 0x0f));
+
+    if (rawData & (1UL << 21)) {
+        temperature = (int16_t)-temperature;
+    }
+
+    return (data->rawData == rawData) && (data->rollingAddress == (rawData & 0x07)) &&
+           (data->channel == (((rawData >> 6) & 0x03) + 1)) &&
+           (data->temperature == temperature) && (data->lowBattery == ((rawData >> 23) & 1));
+}
+
+/*!
+ * \brief First cause of a round-trip failure
+ */
+static Cause_t unstableCause(uint32_t rawData)
+{
+    if (rawData & ROL_ADDR_BIT3) {
+        return CauseRollingAddressBit3;
+    }
+    if (rawData & UNUSED_BITS) {
+        return CauseUnusedBits;
+    }
+    if (!refBcdValid(rawData)) {
+        return CauseNonBcd;
+    }
+    if ((rawData & (1UL << 21)) && ((rawData & 0x0fff00) == 0)) {
+        return CauseNegativeZero;
+    }
+
+    return CauseOther;
+}
+
+/*!
+ * \brief Classify all words of one work item
+ */
+static void sweepWords(uint32_t first, Counters_t *c)
+{
+    OregonTHN128Data_t data;
+    uint32_t rawData = first;
+    bool crc;
+    bool plausible;
+    bool bcd;
+
+    for (uint32_t i = 0; i < WORD_CHUNK; i++, rawData++) {
+        crc = OregonTHN128_RawToData(rawData, &data);
+        plausible = OregonTHN128_IsPlausible(rawData);
+        bcd = refBcdValid(rawData);
+
+        c->crcValid += crc;
+        c->bcdValid += bcd;
+        c->plausible += plausible;
+        c->crcValidPlausible += crc && plausible;
+        c->crcMismatch += (crc != OregonTHN128_CheckCRC(rawData)) ||
+                          (crc != (refChecksum(rawData) == (rawData >> 24)));
+        c->decodeMismatch += !refFieldsEqual(rawData, &data);
+        c->plausibleMismatch += plausible != (bcd && (((rawData >> 6) & 0x03) <= 2));
+        c->tempOutOfRange += (data.temperature < -999) || (data.temperature > 999);
+
+        if (crc) {
+            if (OregonTHN128_DataToRaw(&data) == rawData) {
+                c->roundTripStable++;
+            } else {
+                c->unstable[unstableCause(rawData)]++;
+            }
+        }
+    }
+    c->words = WORD_CHUNK;
+}
+
+/*!
+ * \brief Count an error pattern
+ */
+static void countError(Counters_t *c, uint32_t rawData, uint8_t numErrors)
+{
+    c->patterns[numErrors]++;
+    if (OregonTHN128_CheckCRC(rawData)) {
+        c->accepted[numErrors]++;
+        c->acceptedPlausible[numErrors] += OregonTHN128_IsPlausible(rawData);
+    }
+}
+
+/*!
+ * \brief Apply bit errors to the valid frames of one work item
+ * \details
+ *      Every 24-bit data value has exactly one valid checksum.
+ */
+static void sweepErrors(uint32_t firstData, uint64_t seed, Counters_t *c)
+{
+    uint64_t rng = seed;
+    uint32_t rawData;
+    uint32_t error;
+
+    for (uint32_t data = firstData; data < firstData + FRAME_CHUNK; data++) {
+        rawData = data | ((uint32_t)refChecksum(data) << 24);
+        c->frames++;
+
+        /* All 1 and 2 bit errors */
+        for (uint8_t i = 0; i < 32; i++) {
+            countError(c, rawData ^ (1UL << i), 1);
+            for (uint8_t j = i + 1; j < 32; j++) {
+                countError(c, rawData ^ (1UL << i) ^ (1UL << j), 2);
+            }
+        }
+
+        /* Random 3 and 4 bit errors */
+        for (uint8_t numErrors = 3; numErrors <= MAX_ERRORS; numErrors++) {
+            for (uint8_t n = 0; n < RANDOM_ERRORS; n++) {
+                error = 0;
+                while (__builtin_popcount(error) < numErrors) {
+                    error |= 1UL << (random64(&rng) & 31);
+                }
+                countError(c, rawData ^ error, numErrors);
+            }
+        }
+    }
+}
+
+/*!
+ * \brief Worker thread: process work items until all are done
+ */
+static void *worker(void *arg)
+{
+    (void)arg;
+
+    for (;;) {
+        size_t item = atomic_fetch_add(&_nextItem, 1);
+
+        if (item < WORD_ITEMS) {
+            sweepWords((uint32_t)(item * WORD_CHUNK), &_results[item]);
+        } else if (item < WORD_ITEMS + FRAME_ITEMS) {
+            /* Seed per work item, so the results do not depend on the number of threads */
+            sweepErrors((uint32_t)((item - WORD_ITEMS) * FRAME_CHUNK),
+                        0x9e3779b97f4a7c15ULL * (item + 1), &_results[item]);
+        } else {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+/*!
+ * \brief Get monotonic time in seconds
+ */
+static double timeNow(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (double)ts.tv_sec + (ts.tv_nsec * 1e-9);
+}
+
+int main(int argc, char *argv[])
+{
+    static const char *causeNames[Causes] = {
+        "rolling_address_bit3", "unused_bits", "non_bcd", "negative_zero", "other"
+    };
+    long numThreads = sysconf(_SC_NPROCESSORS_ONLN);
+    pthread_t *threads;
+    Counters_t total;
+    uint64_t *sum = (uint64_t *)&total;
+    double tStart;
+    double tElapsed;
+    bool pass;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "t:")) != -1) {
+        switch (opt) {
+            case 't': numThreads = strtol(optarg, NULL, 0); break;
+            default:
+                fprintf(stderr, "Usage: %s [-t threads]\n", argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+    if (numThreads < 1) {
+        fprintf(stderr, "Invalid argument\n");
+        return EXIT_FAILURE;
+    }
+
+    threads = calloc((size_t)numThreads, sizeof(pthread_t));
+    if (threads == NULL) {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+
+    tStart = timeNow();
+    for (long i = 0; i < numThreads; i++) {
+        pthread_create(&threads[i], NULL, worker, NULL);
+    }
+    for (long i = 0; i < numThreads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    tElapsed = timeNow() - tStart;
+
+    /* Counters_t contains only uint64_t counters */
+    memset(&total, 0, sizeof(total));
+    for (size_t item = 0; item < WORD_ITEMS + FRAME_ITEMS; item++) {
+        const uint64_t *counters = (const uint64_t *)&_results[item];
+
+        for (size_t i = 0; i < sizeof(Counters_t) / sizeof(uint64_t); i++) {
+            sum[i] += counters[i];
+        }
+    }
+
+    pass = (total.crcValid == (1UL << 24)) && (total.crcMismatch == 0) &&
+           (total.decodeMismatch == 0) && (total.plausibleMismatch == 0) &&
+           (total.unstable[CauseOther] == 0) && (total.accepted[1] == 0);
+
+    printf("{\n  \"threads\": %ld,\n  \"seconds\": %.1f,\n  \"words\": %llu,\n", numThreads,
+           tElapsed, (unsigned long long)total.words);
+    printf("  \"crc_valid\": %llu,\n  \"bcd_valid\": %llu,\n  \"plausible\": %llu,\n"
+           "  \"crc_valid_plausible\": %llu,\n  \"temperature_out_of_range\": %llu,\n",
+           (unsigned long long)total.crcValid, (unsigned long long)total.bcdValid,
+           (unsigned long long)total.plausible, (unsigned long long)total.crcValidPlausible,
+           (unsigned long long)total.tempOutOfRange);
+    printf("  \"crc_mismatches\": %llu,\n  \"decode_mismatches\": %llu,\n"
+           "  \"plausible_mismatches\": %llu,\n  \"round_trip_stable\": %llu,\n"
+           "  \"round_trip_unstable\": {",
+           (unsigned long long)total.crcMismatch, (unsigned long long)total.decodeMismatch,
+           (unsigned long long)total.plausibleMismatch, (unsigned long long)total.roundTripStable);
+    for (int i = 0; i < Causes; i++) {
+        printf("%s\"%s\": %llu", i ? ", " : "", causeNames[i],
+               (unsigned long long)total.unstable[i]);
+    }
+    printf("},\n  \"bit_errors\": [\n");
+    for (int i = 1; i <= MAX_ERRORS; i++) {
+        printf("    {\"errors\": %d, \"exhaustive\": %s, \"patterns\": %llu, \"accepted\": %llu, "
+               "\"accept_rate\": %.6f, \"accepted_plausible\": %llu, "
+               "\"accept_plausible_rate\": %.6f}%s\n",
+               i, (i <= 2) ? "true" : "false", (unsigned long long)total.patterns[i],
+               (unsigned long long)total.accepted[i],
+               (double)total.accepted[i] / (double)total.patterns[i],
+               (unsigned long long)total.acceptedPlausible[i],
+               (double)total.acceptedPlausible[i] / (double)total.patterns[i],
+               (i < MAX_ERRORS) ? "," : "");
+    }
+    printf("  ],\n  \"pass\": %s\n}\n", pass ? "true" : "false");
+
+    free(threads);
+
+    return pass ? EXIT_SUCCESS : EXIT_FAILURE;
+}
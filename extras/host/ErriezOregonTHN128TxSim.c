@@ -0,0 +1,330 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128TxSim.c
+ * \brief Oregon THN128 asynchronous transmit simulation
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      Runs the transmit waveform encoder with simulated timer backends of the asynchronous
+ *      transmit functions and verifies the generated edge timings:
+ *      - The edges must match the blocking OregonTHN128_TxRawData() waveform, modelled with a
+ *        virtual clock, within the timer resolution and interrupt latency.
+ *      - Both transmitted frames must be decoded by the receive state machine.
+ *
+ *      Timer backends:
+ *      - avr:     Timer1 CTC, F_CPU 16MHz / 64, the next period starts at the compare match
+ *      - esp8266: timer1 single shot, 80MHz / 16, the next period starts in the interrupt
+ *      - esp32:   esp_timer single shot, 1us, the next period starts in the timer task
+ *
+ *      Build and run on a Linux host from the repository root:
+ *
+ *      gcc -O2 -Isrc src/ErriezOregonTHN128.c src/ErriezOregonTHN128Decoder.c \
+ *          src/ErriezOregonTHN128Encoder.c extras/host/ErriezOregonTHN128TxSim.c -o txsim
+ *      ./txsim
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ErriezOregonTHN128.h"
+#include "ErriezOregonTHN128Decoder.h"
+#include "ErriezOregonTHN128Encoder.h"
+#include "ErriezOregonTHN128Transmit.h"
+
+/*! Number of random frames per timer backend */
+#define NUM_FRAMES          10000
+
+/*! Maximum number of edges of a transmission */
+#define MAX_EDGES           (OREGON_THN128_TX_FRAMES * (24 + 2 + 64 + 2))
+
+/*!
+ * \brief Simulated timer backend
+ */
+typedef struct {
+    const char *name;           /*!< Backend name */
+    double tTick;               /*!< Timer resolution in us */
+    double tLatency;            /*!< Interrupt latency in us, until the pin is written */
+    bool autoReload;            /*!< Next period starts at the timer event instead of in the ISR */
+} TimerBackend_t;
+
+/*!
+ * \brief Pin waveform
+ */
+typedef struct {
+    uint8_t levels[MAX_EDGES];  /*!< Level */
+    double durations[MAX_EDGES];/*!< Duration of the level in us */
+    size_t n;                   /*!< Number of levels */
+    uint8_t pin;                /*!< Current pin level */
+    double tEdge;               /*!< Time of the last pin change in us */
+} Waveform_t;
+
+/*! Timer backends */
+static const TimerBackend_t _backends[] = {
+    { "avr",     4.0, 6.0,  true },
+    { "esp8266", 0.2, 3.0,  false },
+    { "esp32",   1.0, 40.0, false },
+};
+
+/*! Random generator state */
+static uint32_t _random = 0x12345678;
+
+/*!
+ * \brief Pseudo random 32-bit number (xorshift32)
+ */
+static uint32_t random32(void)
+{
+    _random ^= _random << 13;
+    _random ^= _random >> 17;
+    _random ^= _random << 5;
+
+    return _random;
+}
+
+/*!
+ * \brief Write pin at time t, store the duration of the previous level
+ */
+static void pinWrite(Waveform_t *wave, uint8_t level, double t)
+{
+    if (level == wave->pin) {
+        return;
+    }
+    if ((t > wave->tEdge) && (wave->n < MAX_EDGES)) {
+        wave->levels[wave->n] = wave->pin;
+        wave->durations[wave->n] = t - wave->tEdge;
+        wave->n++;
+    }
+    wave->pin = level;
+    wave->tEdge = t;
+}
+
+/*!
+ * \brief Blocking transmit model: the pin and delay calls of OregonTHN128_TxRawData()
+ */
+static void txBlocking(Waveform_t *wave, uint32_t rawData)
+{
+    double t = 0;
+
+    memset(wave, 0, sizeof(*wave));
+    for (int frame = 0; frame < OREGON_THN128_TX_FRAMES; frame++) {
+        /* txPreamble() */
+        for (int i = 0; i < 12; i++) {
+            pinWrite(wave, 1, t);
+            t += T_BIT_US;
+            pinWrite(wave, 0, t);
+            t += T_BIT_US;
+        }
+        t += T_PREAMBLE_SPACE_US;
+
+        /* txSync() */
+        pinWrite(wave, 1, t);
+        t += T_SYNC_US;
+        pinWrite(wave, 0, t);
+        t += T_SYNC_US;
+
+        /* txData() */
+        for (int i = 0; i < 32; i++) {
+            pinWrite(wave, (rawData >> i) & 1 ? 1 : 0, t);
+            t += T_BIT_US;
+            pinWrite(wave, (rawData >> i) & 1 ? 0 : 1, t);
+            t += T_BIT_US;
+        }
+
+        /* txDisable() and the application delay between the frames */
+        pinWrite(wave, 0, t);
+        t += T_SPACE_FRAMES_MS * 1000UL;
+    }
+}
+
+/*!
+ * \brief Round a delay down to the timer resolution
+ */
+static double timerPeriod(const TimerBackend_t *backend, uint32_t us)
+{
+    return (double)(uint64_t)(us / backend->tTick) * backend->tTick;
+}
+
+/*!
+ * \brief Asynchronous transmit with a simulated timer: same steps as OregonTHN128_TxRawDataAsync()
+ * \return
+ *      Number of timer interrupts
+ */
+static int txAsync(const TimerBackend_t *backend, Waveform_t *wave, uint32_t rawData)
+{
+    OregonTHN128Encoder_t enc;
+    uint32_t duration;
+    uint8_t level;
+    double tEvent;
+    int numInterrupts = 0;
+
+    memset(wave, 0, sizeof(*wave));
+
+    /* Start: first level and timer */
+    OregonTHN128_EncoderInit(&enc, rawData, OREGON_THN128_TX_FRAMES);
+    OregonTHN128_EncoderNext(&enc, &level, &duration);
+    pinWrite(wave, level, 0);
+    tEvent = timerPeriod(backend, duration);
+
+    /* Timer interrupts */
+    for (;;) {
+        double tIsr = tEvent + backend->tLatency;
+
+        numInterrupts++;
+        if (!OregonTHN128_EncoderNext(&enc, &level, &duration)) {
+            pinWrite(wave, 0, tIsr);
+            break;
+        }
+        pinWrite(wave, level, tIsr);
+        tEvent = (backend->autoReload ? tEvent : tIsr) + timerPeriod(backend, duration);
+    }
+
+    return numInterrupts;
+}
+
+/*!
+ * \brief Count decoded frames
+ */
+static void frameReceived(uint32_t rawData, void *arg)
+{
+    uint32_t *expected = (uint32_t *)arg;
+
+    if (rawData == expected[0]) {
+        expected[1]++;
+    }
+}
+
+/*!
+ * \brief Decode waveform with the receive state machine
+ * \return
+ *      Number of frames decoded
+ */
+static uint32_t decodeWaveform(const Waveform_t *wave, uint32_t rawData)
+{
+    uint16_t durations[MAX_EDGES + 1];
+    uint8_t levels[MAX_EDGES + 1];
+    uint32_t expected[2] = { rawData, 0 };
+
+    for (size_t i = 0; i < wave->n; i++) {
+        durations[i] = (wave->durations[i] > 0xffff) ? 0xffff : (uint16_t)(wave->durations[i] + 0.5);
+        levels[i] = wave->levels[i];
+    }
+
+    /* Idle after the transmission */
+    durations[wave->n] = 0xffff;
+    levels[wave->n] = 0;
+
+    OregonTHN128_DecodePulses(durations, levels, wave->n + 1, frameReceived, expected);
+
+    return expected[1];
+}
+
+/*!
+ * \brief Simulate all frames with one timer backend
+ * \return
+ *      0: Success, 1: error
+ */
+static int simulateBackend(const TimerBackend_t *backend)
+{
+    static Waveform_t ref;
+    static Waveform_t wave;
+    double maxError = 0;
+    double tTransmit = 0;
+    int numInterrupts = 0;
+    uint32_t numErrors = 0;
+
+    for (uint32_t i = 0; i < NUM_FRAMES; i++) {
+        OregonTHN128Data_t data;
+        uint32_t rawData;
+
+        /* Readings with a valid checksum and random words, which are rejected by the decoder */
+        if (i & 1) {
+            rawData = random32();
+        } else {
+            data.rollingAddress = random32() % 8;
+            data.channel = 1 + (random32() % 3);
+            data.temperature = (int16_t)((random32() % 1999) - 999);
+            data.lowBattery = random32() & 1;
+            rawData = OregonTHN128_DataToRaw(&data);
+        }
+
+        txBlocking(&ref, rawData);
+        numInterrupts = txAsync(backend, &wave, rawData);
+
+        /* Compare edges with the blocking waveform, without the idle time after the last frame */
+        if (wave.n != ref.n) {
+            fprintf(stderr, "%s: 0x%08x: %zu levels, expected %zu\n",
+                    backend->name, rawData, wave.n, ref.n);
+            numErrors++;
+            continue;
+        }
+        for (size_t j = 0; j < wave.n; j++) {
+            double error = wave.durations[j] - ref.durations[j];
+
+            if (wave.levels[j] != ref.levels[j]) {
+                error = 1e9;
+            }
+            if (error < 0) {
+                error = -error;
+            }
+            if (error > maxError) {
+                maxError = error;
+            }
+        }
+        if (maxError > T_RX_TOLERANCE_US) {
+            fprintf(stderr, "%s: 0x%08x: edge error %.1fus\n", backend->name, rawData, maxError);
+            numErrors++;
+        }
+
+        /* Decode with the receive state machine */
+        if (decodeWaveform(&wave, rawData) != (OregonTHN128_CheckCRC(rawData) ?
+                                               OREGON_THN128_TX_FRAMES : 0)) {
+            fprintf(stderr, "%s: 0x%08x: not decoded\n", backend->name, rawData);
+            numErrors++;
+        }
+        tTransmit = wave.tEdge;
+    }
+
+    printf("%-8s tick %.1fus, latency %4.1fus: max edge error %5.1fus, %d interrupts, "
+           "%.1fms per transmission, %u errors\n",
+           backend->name, backend->tTick, backend->tLatency, maxError, numInterrupts,
+           tTransmit / 1000.0, numErrors);
+
+    return numErrors ? 1 : 0;
+}
+
+int main(void)
+{
+    int ret = 0;
+
+    printf("Simulating %d frames x %d transmissions per timer backend\n",
+           NUM_FRAMES, OREGON_THN128_TX_FRAMES);
+
+    for (size_t i = 0; i < sizeof(_backends) / sizeof(_backends[0]); i++) {
+        ret |= simulateBackend(&_backends[i]);
+    }
+
+    return ret ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -31,7 +31,6 @@
  */
 
 #include <string.h>
-#include <stdio.h>
 #include "ErriezOregonTHN128.h"
 
 /*!
@@ -48,14 +47,22 @@
 /*! Get channel */
 #define GET_CHANNEL(x)      ((((x) >> 6) & 0x03) + 1)
 
-/*! Set temperature */
-#define SET_TEMP(x)         ((((((uint32_t)(x) / 100) % 10)) << 16) | \
-                            ((((uint32_t)(x) / 10) % 10) << 12) | \
-                            (((x) % 10) << 8))
-/*! Get temperature */
-#define GET_TEMP(x)         (((((x) >> 16) & 0x0f) * 100) + \
-                            ((((x) >> 12) & 0x0f) * 10) + \
-                            (((x) >> 8) & 0x0f))
+/*! Set temperature, absolute value 0..32768, only the 3 least significant digits are stored */
+#define SET_TEMP(x)         tempToBcd(x)
+/*! Get temperature, without sign */
+#define GET_TEMP(x)         bcdToTemp(x)
+
+/*! Temperature digits TH1 (x100), TH2 (x10) and TH3 (x1) */
+#define TH1(x)              ((uint8_t)((x) >> 16) & 0x0f)
+#define TH2(x)              ((uint8_t)((x) >> 12) & 0x0f)
+#define TH3(x)              ((uint8_t)((x) >> 8) & 0x0f)
+
+/*! Divide 0..999 by 100 with a 16-bit reciprocal multiply */
+#define DIV100(x)           ((uint8_t)(((uint16_t)(x) * 41U) >> 12))
+/*! Divide 0..99 by 10 with a 16-bit reciprocal multiply */
+#define DIV10(x)            ((uint8_t)(((uint16_t)(x) * 205U) >> 11))
+/*! Multiply by 10 with shift/add */
+#define MUL10(x)            ((uint16_t)(((x) << 3) + ((x) << 1)))
 
 /*! Sign bit */
 #define SIGN_BIT            (1UL << 21)
@@ -71,6 +78,87 @@
 /*! @} */
 
 
+/*!
+ * \brief Convert absolute temperature to decimal digits
+ * \details
+ *      Division-free: AVR has no hardware divider and the / and % operators are library calls.
+ *      The thousands are removed by subtracting 32000, 16000 .. 1000, the remaining digits are
+ *      divided with 16-bit reciprocal multiplies which are exact in their range, so no 32-bit
+ *      multiply is needed.
+ * \param value
+ *      Absolute temperature 0..32768
+ * \param digits
+ *      Output: digits[0] x1 .. digits[4] x10000
+ */
+static inline void tempToDigits(uint16_t value, uint8_t digits[5])
+{
+    uint16_t k = 32000;
+    uint8_t weight = 32;
+    uint8_t thousands = 0;
+    uint8_t rest;
+
+    /* Thousands 0..32 without branches, not present in the -99.9..99.9 range of a sensor */
+    if (value >= 1000) {
+        do {
+            uint8_t ge = (value >= k) ? 0xff : 0x00;
+
+            value -= k & (((uint16_t)ge << 8) | ge);
+            thousands += weight & ge;
+            k >>= 1;
+            weight >>= 1;
+        } while (weight);
+    }
+
+    /* Hundreds of 0..999 */
+    digits[2] = DIV100(value);
+    rest = (uint8_t)(value - MUL10(MUL10((uint16_t)digits[2])));
+
+    /* Tens and ones of 0..99 */
+    digits[1] = DIV10(rest);
+    digits[0] = rest - (uint8_t)MUL10(digits[1]);
+
+    digits[4] = DIV10(thousands);
+    digits[3] = thousands - (uint8_t)MUL10(digits[4]);
+}
+
+/*!
+ * \brief Convert absolute temperature to BCD digits TH1..TH3
+ * \param temperature
+ *      Absolute temperature 0..32768, only the 3 least significant digits are stored
+ * \return
+ *      Raw data bits 8..19
+ */
+static uint32_t tempToBcd(uint16_t temperature)
+{
+    uint8_t digits[5];
+
+    tempToDigits(temperature, digits);
+
+    return ((uint32_t)digits[2] << 16) | ((uint32_t)digits[1] << 12) | ((uint32_t)digits[0] << 8);
+}
+
+/*!
+ * \brief Convert BCD digits TH1..TH3 to absolute temperature
+ * \details
+ *      Digits are extracted as 8-bit values and combined with shift/add, so no 32-bit multiply is
+ *      needed. Non-BCD digits 10..15 are converted with the same weights.
+ * \param rawData
+ *      32-bit raw data
+ * \return
+ *      Absolute temperature
+ */
+static uint16_t bcdToTemp(uint32_t rawData)
+{
+    uint16_t temperature;
+
+    /* ((TH1 * 10) + TH2) * 10 + TH3 */
+    temperature = TH1(rawData);
+    temperature = MUL10(temperature) + TH2(rawData);
+    temperature = MUL10(temperature) + TH3(rawData);
+
+    return temperature;
+}
+
 /*!
  * \brief Calculate CRC
  * \param rawData
@@ -78,7 +166,7 @@
  * \return
  *      8-bit checksum
  */
-static uint8_t calcCrc(uint32_t rawData)
+static uint8_t IRAM_ATTR calcCrc(uint32_t rawData)
 {
     uint16_t crc;
 
@@ -98,14 +186,120 @@ static uint8_t calcCrc(uint32_t rawData)
  * \return
  *      true: Success, false: error
  */
-bool OregonTHN128_CheckCRC(uint32_t rawData)
+bool IRAM_ATTR OregonTHN128_CheckCRC(uint32_t rawData)
 {
     return calcCrc(rawData) == GET_CRC(rawData);
 }
 
+/*!
+ * \brief Verify that the fields contain values a THN128 transmits
+ * \details
+ *      The 8-bit checksum does not detect all errors, so frames repaired from bit errors are also
+ *      checked for a channel 1..3 and BCD temperature digits 0..9.
+ * \param rawData
+ *      32-bit raw data input
+ * \return
+ *      true: Plausible, false: invalid field
+ */
+bool OregonTHN128_IsPlausible(uint32_t rawData)
+{
+    return (GET_CHANNEL(rawData) <= 3) &&
+           (TH1(rawData) <= 9) && (TH2(rawData) <= 9) && (TH3(rawData) <= 9);
+}
+
 /*------------------------------------------------------------------------------------------------*/
 /*                                     Public functions                                           */
 /*------------------------------------------------------------------------------------------------*/
+/*!
+ * \brief Append temperature to a character buffer
+ * \details
+ *      Formats the temperature in tenths of a degree as [-]integer.tenth, for example "-12.3",
+ *      without snprintf() which pulls the complete vfprintf implementation into the AVR flash.
+ *      The output is truncated to bufLen - 1 characters and always zero terminated.
+ * \param buf
+ *      Character buffer, for example the end of a message being built
+ * \param bufLen
+ *      Remaining size of the character buffer including the zero terminator
+ * \param temperature
+ *      Input temperature
+ * \return
+ *      Number of characters written, excluding the zero terminator
+ */
+uint8_t OregonTHN128_TempAppend(char *buf, uint8_t bufLen, int16_t temperature)
+{
+    char chars[7];
+    uint8_t digits[5];
+    uint8_t numDigits = 5;
+    uint8_t numChars = 0;
+    uint8_t len = 0;
+
+    if (bufLen == 0) {
+        return 0;
+    }
+
+    /* Convert absolute temperature */
+    tempToDigits((temperature < 0) ? (uint16_t)-temperature : (uint16_t)temperature, digits);
+
+    /* Integer part without leading zeros, at least one digit */
+    while ((numDigits > 2) && (digits[numDigits - 1] == 0)) {
+        numDigits--;
+    }
+
+    /* Store characters in reverse order, starting with the tenth */
+    chars[numChars++] = '0' + digits[0];
+    chars[numChars++] = '.';
+    for (uint8_t i = 1; i < numDigits; i++) {
+        chars[numChars++] = '0' + digits[i];
+    }
+    if (temperature < 0) {
+        chars[numChars++] = '-';
+    }
+
+    /* Copy to output buffer */
+    while (numChars && (len < (bufLen - 1))) {
+        buf[len++] = chars[--numChars];
+    }
+    buf[len] = '\0';
+
+    return len;
+}
+
+/*!
+ * \brief Append temperature as JSON number to a character buffer
+ * \details
+ *      Same format as OregonTHN128_TempAppend(), which is a valid JSON number. Temperatures outside
+ *      -99.9..99.9 cannot be transmitted and are the result of a corrupted frame, so JSON null is
+ *      written instead.
+ * \param buf
+ *      Character buffer
+ * \param bufLen
+ *      Remaining size of the character buffer including the zero terminator
+ * \param temperature
+ *      Input temperature
+ * \return
+ *      Number of characters written, excluding the zero terminator
+ */
+uint8_t OregonTHN128_TempAppendJson(char *buf, uint8_t bufLen, int16_t temperature)
+{
+    const char null[] = "null";
+    uint8_t len = 0;
+
+    if ((temperature >= -999) && (temperature <= 999)) {
+        return OregonTHN128_TempAppend(buf, bufLen, temperature);
+    }
+
+    if (bufLen == 0) {
+        return 0;
+    }
+    while (null[len] && (len < (bufLen - 1))) {
+        buf[len] = null[len];
+        len++;
+    }
+    buf[len] = '\0';
+
+    return len;
+}
+
 /*!
  * \brief Convert temperature to string
  * \param temperatureStr
@@ -117,18 +311,7 @@ bool OregonTHN128_CheckCRC(uint32_t rawData)
  */
 void OregonTHN128_TempToString(char *temperatureStr, uint8_t temperatureStrLen, int16_t temperature)
 {
-    bool tempNegative = false;
-    int tempAbs;
-
-    /* Convert temperature without using float to string */
-    tempAbs = temperature;
-    if (temperature < 0) {
-        tempNegative = true;
-        tempAbs *= -1;
-    }
-
-    snprintf(temperatureStr, temperatureStrLen, "%s%d.%d",
-             tempNegative ? "-" : "", (tempAbs / 10), tempAbs % 10);
+    OregonTHN128_TempAppend(temperatureStr, temperatureStrLen, temperature);
 }
 
 /*!
@@ -151,9 +334,9 @@ uint32_t OregonTHN128_DataToRaw(OregonTHN128Data_t *data)
     /* Set temperature -999..999 */
     if (data->temperature < 0) {
         rawData |= SIGN_BIT;
-        rawData |= SET_TEMP(data->temperature * -1);
+        rawData |= SET_TEMP((uint16_t)-data->temperature);
     } else {
-        rawData |= SET_TEMP(data->temperature);
+        rawData |= SET_TEMP((uint16_t)data->temperature);
     }
 
     /* Low battery bit */
@@ -185,7 +368,7 @@ bool OregonTHN128_RawToData(uint32_t rawData, OregonTHN128Data_t *data)
     data->rawData = rawData;
     data->rollingAddress = GET_ROL_ADDR(rawData);
     data->channel = GET_CHANNEL(rawData);
-    data->temperature = GET_TEMP(rawData);
+    data->temperature = (int16_t)GET_TEMP(rawData);
     if (rawData & SIGN_BIT) {
         data->temperature *= -1;
     }
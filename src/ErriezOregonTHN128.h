@@ -25,8 +25,9 @@
 #ifndef ERRIEZ_OREGON_THN128_H_
 #define ERRIEZ_OREGON_THN128_H_
 
-/* Check platform */
-#if !defined(ARDUINO_ARCH_AVR) && !defined(ARDUINO_ARCH_ESP8266) && !defined(ARDUINO_ARCH_ESP32)
+/* Check platform (the codec and decoder can also be built on a host without Arduino) */
+#if defined(ARDUINO) && \
+    !defined(ARDUINO_ARCH_AVR) && !defined(ARDUINO_ARCH_ESP8266) && !defined(ARDUINO_ARCH_ESP32)
 #error "Platform not supported."
 #endif
 
@@ -37,6 +38,16 @@ extern "C" {
 #include <stdbool.h>
 #include <stdint.h>
 
+/* Functions called from interrupt handlers are placed in IRAM on ESP targets */
+#if defined(ARDUINO_ARCH_ESP32)
+#include <esp_attr.h>
+#elif defined(ARDUINO_ARCH_ESP8266)
+#include <c_types.h>
+#endif
+#ifndef IRAM_ATTR
+#define IRAM_ATTR
+#endif
+
 /* Timing micro's in micro seconds */
 #define T_RX_TOLERANCE_US       400
 #define T_PREAMBLE_SPACE_US     3000
@@ -57,6 +68,13 @@ extern "C" {
 #define T_BIT_LONG_MIN      ((T_BIT_US * 2) - T_RX_TOLERANCE_US)
 #define T_BIT_LONG_MAX      ((T_BIT_US * 2) + T_RX_TOLERANCE_US)
 
+/*! Sensor key of channel 1..4 and rolling address 0..7 */
+#define OREGON_THN128_SENSOR(channel, rollingAddress) \
+    ((uint8_t)((((channel) - 1) & 0x03) << 3) | ((rollingAddress) & 0x07))
+
+/*! Number of sensor keys */
+#define OREGON_THN128_SENSOR_KEYS   32
+
 /*!
  * \brief Data structure
  */
@@ -70,7 +88,10 @@ typedef struct {
 
 /* Public functions */
 bool OregonTHN128_CheckCRC(uint32_t rawData);
+bool OregonTHN128_IsPlausible(uint32_t rawData);
 void OregonTHN128_TempToString(char *temperatureStr, uint8_t temperatureStrLen, int16_t temperature);
+uint8_t OregonTHN128_TempAppend(char *buf, uint8_t bufLen, int16_t temperature);
+uint8_t OregonTHN128_TempAppendJson(char *buf, uint8_t bufLen, int16_t temperature);
 uint32_t OregonTHN128_DataToRaw(OregonTHN128Data_t *data);
 bool OregonTHN128_RawToData(uint32_t rawData, OregonTHN128Data_t *data);
 
@@ -0,0 +1,184 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Batch.c
+ * \brief Oregon THN128 batch checksum validation and decoding
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      Frames are processed by a SIMD kernel when one is linked, see
+ *      OregonTHN128_BatchKernelSimd(). Frames which do not fill a complete vector, and all frames
+ *      without a kernel, are processed by the scalar codec functions. The SSE2 and AVX2 kernels for x86 hosts are in
+ *      extras/host/ErriezOregonTHN128BatchX86.c: src contains only code which compiles for every
+ *      Arduino target.
+ */
+
+#include "ErriezOregonTHN128Batch.h"
+
+/*!
+ * \brief The scalar path is always supported
+ */
+static bool scalarSupported(void)
+{
+    return true;
+}
+
+/*!
+ * \brief No SIMD kernel, all frames are processed by the scalar path
+ */
+static size_t scalarCrcBatch(const uint32_t *rawData, size_t n, uint8_t *okMask, size_t *numOk)
+{
+    (void)rawData;
+    (void)n;
+    (void)okMask;
+    (void)numOk;
+
+    return 0;
+}
+
+/*!
+ * \brief No SIMD kernel, all frames are processed by the scalar path
+ */
+static size_t scalarDecodeBatch(const uint32_t *rawData, size_t n, OregonTHN128Columns_t *columns,
+                                size_t *numOk)
+{
+    (void)rawData;
+    (void)n;
+    (void)columns;
+    (void)numOk;
+
+    return 0;
+}
+
+/*! Scalar kernel */
+static const OregonTHN128BatchKernel_t _scalarKernel = {
+    "scalar", scalarSupported, scalarCrcBatch, scalarDecodeBatch
+};
+
+/*!
+ * \brief SIMD kernel, none by default
+ * \details
+ *      Weak, replaced by a SIMD kernel file linked with the application, for example
+ *      extras/host/ErriezOregonTHN128BatchX86.c on x86 hosts.
+ * \return
+ *      Fastest kernel supported by the CPU, NULL for the scalar path
+ */
+__attribute__((weak)) const OregonTHN128BatchKernel_t *OregonTHN128_BatchKernelSimd(void)
+{
+    return NULL;
+}
+
+/*!
+ * \brief Fastest kernel supported by the CPU, selected at the first call
+ */
+static const OregonTHN128BatchKernel_t *bestKernel(void)
+{
+    static const OregonTHN128BatchKernel_t *kernel = NULL;
+
+    if (kernel == NULL) {
+        kernel = OregonTHN128_BatchKernelSimd();
+        if (kernel == NULL) {
+            kernel = &_scalarKernel;
+        }
+    }
+
+    return kernel;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                     Public functions                                           */
+/*------------------------------------------------------------------------------------------------*/
+/*!
+ * \brief Get name of the batch kernel selected for the CPU
+ * \return
+ *      "avx2", "sse2" or "scalar"
+ */
+const char *OregonTHN128_BatchKernel(void)
+{
+    return bestKernel()->name;
+}
+
+/*!
+ * \brief Verify checksum of an array of frames
+ * \param rawData
+ *      32-bit raw data input
+ * \param n
+ *      Number of frames
+ * \param okMask
+ *      Output, one Byte per frame 1: Success, 0: error
+ * \return
+ *      Number of frames with a valid checksum
+ */
+size_t OregonTHN128_CheckCRCBatch(const uint32_t *rawData, size_t n, uint8_t *okMask)
+{
+    size_t numOk = 0;
+    size_t i;
+
+    i = bestKernel()->crcBatch(rawData, n, okMask, &numOk);
+
+    /* Remaining frames */
+    for (; i < n; i++) {
+        okMask[i] = OregonTHN128_CheckCRC(rawData[i]) ? 1 : 0;
+        numOk += okMask[i];
+    }
+
+    return numOk;
+}
+
+/*!
+ * \brief Convert an array of frames to columns
+ * \details
+ *      Frames with a checksum error are decoded as well, check columns->crcOk.
+ * \param rawData
+ *      32-bit raw data input
+ * \param n
+ *      Number of frames
+ * \param columns
+ *      Output arrays
+ * \return
+ *      Number of frames with a valid checksum
+ */
+size_t OregonTHN128_RawToDataBatch(const uint32_t *rawData, size_t n,
+                                   OregonTHN128Columns_t *columns)
+{
+    OregonTHN128Data_t data;
+    size_t numOk = 0;
+    size_t i;
+
+    i = bestKernel()->decodeBatch(rawData, n, columns, &numOk);
+
+    /* Remaining frames */
+    for (; i < n; i++) {
+        columns->crcOk[i] = OregonTHN128_RawToData(rawData[i], &data) ? 1 : 0;
+        columns->rollingAddress[i] = data.rollingAddress;
+        columns->channel[i] = data.channel;
+        columns->temperature[i] = data.temperature;
+        columns->lowBattery[i] = data.lowBattery ? 1 : 0;
+        numOk += columns->crcOk[i];
+    }
+
+    return numOk;
+}
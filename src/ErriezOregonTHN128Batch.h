@@ -0,0 +1,90 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Batch.h
+ * \brief Oregon THN128 batch checksum validation and decoding
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      Validates and decodes arrays of 32-bit raw frames, for example on a gateway collecting
+ *      frames from many receivers. On x86 hosts linked with
+ *      extras/host/ErriezOregonTHN128BatchX86.c the frames are processed with SSE2 or AVX2, selected
+ *      at run time for the CPU, otherwise with the scalar codec functions. The results are identical to OregonTHN128_CheckCRC() and
+ *      OregonTHN128_RawToData().
+ */
+
+#ifndef ERRIEZ_OREGON_THN128_BATCH_H_
+#define ERRIEZ_OREGON_THN128_BATCH_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ErriezOregonTHN128.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Decoded frames, one array per field
+ * \details
+ *      All arrays are provided by the caller and hold at least the number of frames to decode.
+ */
+typedef struct {
+    uint8_t *rollingAddress;    /*!< Rolling address */
+    uint8_t *channel;           /*!< Channel */
+    int16_t *temperature;       /*!< Temperature */
+    uint8_t *lowBattery;        /*!< Low battery indication 0 or 1 */
+    uint8_t *crcOk;             /*!< Checksum 1: Success, 0: error */
+} OregonTHN128Columns_t;
+
+/*!
+ * \brief Batch kernel
+ * \details
+ *      The kernel functions process complete blocks of frames and return the number of frames
+ *      processed, the remaining frames are processed by the scalar codec functions.
+ */
+typedef struct {
+    const char *name;           /*!< Kernel name */
+    bool (*supported)(void);    /*!< CPU supports the kernel */
+    size_t (*crcBatch)(const uint32_t *rawData, size_t n, uint8_t *okMask,
+                       size_t *numOk);                  /*!< Check CRC */
+    size_t (*decodeBatch)(const uint32_t *rawData, size_t n, OregonTHN128Columns_t *columns,
+                          size_t *numOk);               /*!< Decode */
+} OregonTHN128BatchKernel_t;
+
+/* Public functions */
+const OregonTHN128BatchKernel_t *OregonTHN128_BatchKernelSimd(void);
+const char *OregonTHN128_BatchKernel(void);
+size_t OregonTHN128_CheckCRCBatch(const uint32_t *rawData, size_t n, uint8_t *okMask);
+size_t OregonTHN128_RawToDataBatch(const uint32_t *rawData, size_t n,
+                                   OregonTHN128Columns_t *columns);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ERRIEZ_OREGON_THN128_BATCH_H_ */
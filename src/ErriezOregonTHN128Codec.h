@@ -0,0 +1,241 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Codec.h
+ * \brief Oregon THN128 constexpr codec (C++11, header only)
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      Bit-identical constexpr versions of OregonTHN128_DataToRaw(), OregonTHN128_RawToData(),
+ *      OregonTHN128_CheckCRC() and OregonTHN128_IsPlausible(). Fixed frames are computed by the
+ *      compiler, so no codec code is linked for them:
+ *
+ *      static const uint32_t rawData = OregonTHN128::Frame<5, 1, 278, false>::value;
+ *
+ *      The frame examples of ErriezOregonTHN128Receive.h are checked with static_assert when this
+ *      header is compiled.
+ */
+
+#ifndef ERRIEZ_OREGON_THN128_CODEC_H_
+#define ERRIEZ_OREGON_THN128_CODEC_H_
+
+#ifndef __cplusplus
+#error "ErriezOregonTHN128Codec.h requires C++11"
+#endif
+
+#include <stdint.h>
+#include "ErriezOregonTHN128.h"
+
+namespace OregonTHN128 {
+
+/*! Sign bit */
+constexpr uint32_t signBit = 1UL << 21;
+/*! Low battery bit */
+constexpr uint32_t lowBatteryBit = 1UL << 23;
+
+/*!
+ * \brief Fold the carry of the byte sum, as calcCrc()
+ */
+constexpr uint8_t foldCarry(uint32_t sum)
+{
+    return (uint8_t)((sum >> 8) + (sum & 0xff));
+}
+
+/*!
+ * \brief 8-bit checksum of bytes 0..2
+ * \param rawData
+ *      32-bit raw data
+ * \return
+ *      Checksum, stored in byte 3
+ */
+constexpr uint8_t checksum(uint32_t rawData)
+{
+    return foldCarry(((rawData >> 16) & 0xff) + ((rawData >> 8) & 0xff) + (rawData & 0xff));
+}
+
+/*!
+ * \brief Verify checksum, as OregonTHN128_CheckCRC()
+ */
+constexpr bool checkCrc(uint32_t rawData)
+{
+    return checksum(rawData) == (rawData >> 24);
+}
+
+/*!
+ * \brief Temperature digit TH1 (x100), TH2 (x10) or TH3 (x1)
+ * \param rawData
+ *      32-bit raw data
+ * \param shift
+ *      16: TH1, 12: TH2, 8: TH3
+ */
+constexpr uint8_t digit(uint32_t rawData, uint8_t shift)
+{
+    return (uint8_t)((rawData >> shift) & 0x0f);
+}
+
+/*!
+ * \brief Channel and BCD digits valid, as OregonTHN128_IsPlausible()
+ */
+constexpr bool isPlausible(uint32_t rawData)
+{
+    return (((rawData >> 6) & 0x03) <= 2) &&
+           (digit(rawData, 16) <= 9) && (digit(rawData, 12) <= 9) && (digit(rawData, 8) <= 9);
+}
+
+/*! Rolling address */
+constexpr uint8_t rollingAddress(uint32_t rawData)
+{
+    return (uint8_t)(rawData & 0x07);
+}
+
+/*! Channel 1..4 */
+constexpr uint8_t channel(uint32_t rawData)
+{
+    return (uint8_t)(((rawData >> 6) & 0x03) + 1);
+}
+
+/*! Temperature in 0.1 degree Celsius, non-BCD digits with the same weights */
+constexpr int16_t temperature(uint32_t rawData)
+{
+    return (int16_t)(((rawData & signBit) ? -1 : 1) *
+                     (int16_t)((digit(rawData, 16) * 100) + (digit(rawData, 12) * 10) +
+                               digit(rawData, 8)));
+}
+
+/*! Low battery */
+constexpr bool lowBattery(uint32_t rawData)
+{
+    return (rawData & lowBatteryBit) != 0;
+}
+
+/*!
+ * \brief BCD digits of the 3 least significant decimal digits, as tempToBcd()
+ */
+constexpr uint32_t tempToBcd(uint16_t temperature)
+{
+    return ((uint32_t)((temperature / 100) % 10) << 16) |
+           ((uint32_t)((temperature / 10) % 10) << 12) | ((uint32_t)(temperature % 10) << 8);
+}
+
+/*!
+ * \brief Add the checksum to bytes 0..2
+ */
+constexpr uint32_t withChecksum(uint32_t rawData)
+{
+    return rawData | ((uint32_t)checksum(rawData) << 24);
+}
+
+/*!
+ * \brief Encode fields, as OregonTHN128_DataToRaw()
+ * \param rollingAddress
+ *      Rolling address 0..7
+ * \param channel
+ *      Channel 1..3
+ * \param temperature
+ *      Temperature -999..999 in 0.1 degree Celsius
+ * \param lowBattery
+ *      Low battery indication
+ * \return
+ *      32-bit raw data
+ */
+constexpr uint32_t encode(uint8_t rollingAddress, uint8_t channel, int16_t temperature,
+                          bool lowBattery)
+{
+    return withChecksum((uint32_t)(rollingAddress & 0x07) |
+                        ((uint32_t)((channel - 1) & 0x03) << 6) |
+                        ((temperature < 0) ? (signBit | tempToBcd((uint16_t)-temperature)) :
+                                             tempToBcd((uint16_t)temperature)) |
+                        (lowBattery ? lowBatteryBit : 0));
+}
+
+/*!
+ * \brief Convert data structure to raw data, as OregonTHN128_DataToRaw()
+ */
+constexpr uint32_t dataToRaw(const OregonTHN128Data_t &data)
+{
+    return encode(data.rollingAddress, data.channel, data.temperature, data.lowBattery);
+}
+
+/*!
+ * \brief Convert raw data to data structure, as OregonTHN128_RawToData()
+ * \details
+ *      The checksum is not verified, see checkCrc().
+ */
+constexpr OregonTHN128Data_t rawToData(uint32_t rawData)
+{
+    return OregonTHN128Data_t{ rawData, rollingAddress(rawData), channel(rawData),
+                               temperature(rawData), lowBattery(rawData) };
+}
+
+/*!
+ * \brief Frame computed at compile time
+ * \tparam RollingAddress
+ *      Rolling address 0..7
+ * \tparam Channel
+ *      Channel 1..3
+ * \tparam Temperature
+ *      Temperature -999..999 in 0.1 degree Celsius
+ * \tparam LowBattery
+ *      Low battery indication
+ */
+template <uint8_t RollingAddress, uint8_t Channel, int16_t Temperature, bool LowBattery>
+struct Frame {
+    static_assert(RollingAddress <= 7, "Rolling address must be 0..7");
+    static_assert((Channel >= 1) && (Channel <= 3), "Channel must be 1..3");
+    static_assert((Temperature >= -999) && (Temperature <= 999), "Temperature must be -999..999");
+
+    /*! 32-bit raw data */
+    static constexpr uint32_t value = encode(RollingAddress, Channel, Temperature, LowBattery);
+};
+
+template <uint8_t RollingAddress, uint8_t Channel, int16_t Temperature, bool LowBattery>
+constexpr uint32_t Frame<RollingAddress, Channel, Temperature, LowBattery>::value;
+
+/* Example of ErriezOregonTHN128Receive.h: rolling address 5, channel 1, 27.8 `C */
+static_assert(Frame<5, 1, 278, false>::value == 0x7f027805UL, "Receive header example");
+static_assert(checkCrc(0x7f027805UL), "Receive header example checksum");
+static_assert(rawToData(0x7f027805UL).rollingAddress == 5, "Receive header example address");
+static_assert(rawToData(0x7f027805UL).channel == 1, "Receive header example channel");
+static_assert(rawToData(0x7f027805UL).temperature == 278, "Receive header example temperature");
+static_assert(!rawToData(0x7f027805UL).lowBattery, "Receive header example low battery");
+
+/* Capture extras/SaleaeLogicAnalyzer/RX_rol7_channel1_temp20.7_lowbat0 */
+static_assert(Frame<7, 1, 207, false>::value == 0x10020707UL, "Capture example");
+
+/* Sign, low battery and checksum carry: rolling address 2, channel 3, -12.3 `C */
+static_assert(Frame<2, 3, -123, true>::value == 0x47a12382UL, "Negative example");
+static_assert(rawToData(0x47a12382UL).temperature == -123, "Negative example temperature");
+static_assert(rawToData(0x47a12382UL).lowBattery, "Negative example low battery");
+
+/* Checksum errors */
+static_assert(!checkCrc(0x7f027805UL ^ (1UL << 8)), "Data bit error detected");
+static_assert(!checkCrc(0x7f027805UL ^ (1UL << 24)), "Checksum bit error detected");
+static_assert(isPlausible(0x7f027805UL) && !isPlausible(withChecksum(0x0a0000UL)),
+              "Plausible BCD digits");
+
+} /* namespace OregonTHN128 */
+
+#endif /* ERRIEZ_OREGON_THN128_CODEC_H_ */
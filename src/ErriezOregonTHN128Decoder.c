@@ -0,0 +1,642 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Decoder.c
+ * \brief Oregon THN128 433MHz temperature receive state machine
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ */
+
+#include <string.h>
+#include "ErriezOregonTHN128Decoder.h"
+
+/*!
+ * \brief Receive state
+ */
+typedef enum {
+    StateSearchSync = 0,    /*!< Search for sync */
+    StateMid0 = 1,          /*!< Sample at the middle of a pulse part 1 */
+    StateMid1 = 2,          /*!< Sample at the middle of a pulse part 2 */
+    StateEnd = 3            /*!< Sample at the end of a pulse to store bit */
+} RxState_t;
+
+/*!
+ * \brief THN128 protocol: 32-bit frames with the timings of ErriezOregonTHN128.h
+ */
+const OregonTHN128Protocol_t OregonTHN128_ProtocolTHN128 = OREGON_THN128_PROTOCOL_THN128;
+
+/*!
+ * \brief Copy of the THN128 protocol for the specialized state machine
+ * \details
+ *      Internal linkage, so the compiler replaces all field reads by constants and the checksum by
+ *      a direct call.
+ */
+static const OregonTHN128Protocol_t _protocolTHN128 = OREGON_THN128_PROTOCOL_THN128;
+
+/*!
+ * \def DECODER_INLINE
+ * \brief State machine functions are inlined into each protocol instance
+ */
+#define DECODER_INLINE      static inline __attribute__((always_inline))
+
+/*!
+ * \defgroup Adaptive clock
+ * @{
+ */
+/*! Number of preamble levels averaged per bit time measurement, power of 2 */
+#define PREAMBLE_AVG        16
+/*! Minimum preamble level length: bit time -50% */
+#define T_PREAMBLE_MIN(tBitUs)  ((tBitUs) / 2)
+/*! Maximum preamble level length: bit time +50% */
+#define T_PREAMBLE_MAX(tBitUs)  ((tBitUs) + ((tBitUs) / 2))
+/*! @} */
+
+
+/* Check number of soft bits */
+#if (OREGON_THN128_RX_SOFT_BITS < 0) || (OREGON_THN128_RX_SOFT_BITS > 8)
+#error "OREGON_THN128_RX_SOFT_BITS must be between 0 and 8"
+#endif
+
+/*!
+ * \def RX_BIT_TOLERANCE()
+ * \brief Tolerance of the 1 and 2 bit time windows
+ * \details
+ *      With soft windows enabled, a level between 0.5 and 2.5 bit times is taken as the nearest
+ *      nominal length and its deviation lowers the confidence of the bit, instead of aborting the
+ *      frame outside the tolerance of the protocol. The checksum rejects wrong decisions.
+ */
+#if OREGON_THN128_RX_SOFT_BITS
+#define RX_BIT_TOLERANCE(dec, protocol, tBit) \
+    ((dec)->softWindows ? ((tBit) / 2) : (protocol)->tToleranceUs)
+#else
+#define RX_BIT_TOLERANCE(dec, protocol, tBit) ((protocol)->tToleranceUs)
+#endif
+
+/*!
+ * \def RX_STATS_INC()
+ * \brief Increment receive statistics counter
+ */
+#if OREGON_THN128_RX_STATS
+#define RX_STATS_INC(dec, counter)  ((dec)->stats.counter++)
+#else
+#define RX_STATS_INC(dec, counter)
+#endif
+
+/*!
+ * \brief Set nominal bit and sync time
+ * \param dec
+ *      Decoder state
+ * \param protocol
+ *      Protocol of the instance
+ */
+DECODER_INLINE void resetClock(OregonTHN128Decoder_t *dec, const OregonTHN128Protocol_t *protocol)
+{
+    dec->tBit = protocol->tBitUs;
+    dec->tSync = protocol->tSyncUs;
+}
+
+#if OREGON_THN128_RX_ADAPTIVE_CLOCK
+/*!
+ * \brief Measure bit time from the preamble
+ * \details
+ *      The preamble is 12 bits 1, a sequence of high and low levels of one bit time. Blocks of
+ *      PREAMBLE_AVG levels within +/-50% of the protocol bit time are averaged, an even number of
+ *      levels cancels pulse stretching of the receiver. The sync time is scaled with the same ratio.
+ *      Integer only: a shift and a 16 x 16-bit multiply per block.
+ * \param dec
+ *      Decoder state
+ * \param protocol
+ *      Protocol of the instance
+ * \param tLevel
+ *      Length of the pulse or space in us
+ */
+DECODER_INLINE void measurePreamble(OregonTHN128Decoder_t *dec,
+                                    const OregonTHN128Protocol_t *protocol, uint16_t tLevel)
+{
+    uint16_t tBitUs = protocol->tBitUs;
+    uint16_t tBit;
+
+    if ((tLevel < T_PREAMBLE_MIN(tBitUs)) || (tLevel > T_PREAMBLE_MAX(tBitUs))) {
+        /* Not a preamble level, keep the last measurement for the sync */
+        dec->tPreambleSum = 0;
+        dec->preambleCount = 0;
+        return;
+    }
+
+    dec->tPreambleSum += tLevel;
+    if (++dec->preambleCount == PREAMBLE_AVG) {
+        tBit = dec->tPreambleSum / PREAMBLE_AVG;
+        dec->tBit = tBit;
+        dec->tSync = (uint16_t)(((uint32_t)tBit * dec->syncRatioQ8) >> 8);
+        dec->tPreambleSum = 0;
+        dec->preambleCount = 0;
+    }
+}
+#endif
+
+#if OREGON_THN128_RX_SOFT_BITS
+/*!
+ * \brief Add the deviation of an accepted level to the bit being received
+ * \param dec
+ *      Decoder state
+ * \param tLevel
+ *      Length of the pulse or space in us
+ * \param tNominal
+ *      Nominal length: 1 or 2 bit times in us
+ */
+DECODER_INLINE void softLevel(OregonTHN128Decoder_t *dec, uint16_t tLevel, uint16_t tNominal)
+{
+    uint16_t deviation = (tLevel > tNominal) ? (tLevel - tNominal) : (tNominal - tLevel);
+
+    if (deviation > dec->bitDeviation) {
+        dec->bitDeviation = deviation;
+    }
+}
+
+/*!
+ * \brief Record the confidence of a stored bit
+ * \details
+ *      Keeps the OREGON_THN128_RX_SOFT_BITS bits with the largest deviation sorted by insertion,
+ *      at most OREGON_THN128_RX_SOFT_BITS compares per bit.
+ * \param dec
+ *      Decoder state
+ */
+DECODER_INLINE void softBit(OregonTHN128Decoder_t *dec)
+{
+    uint16_t deviation = dec->bitDeviation;
+    uint8_t i = dec->softCount;
+
+    dec->bitDeviation = 0;
+
+    if (i < OREGON_THN128_RX_SOFT_BITS) {
+        dec->softCount++;
+    } else if (deviation > dec->softDeviation[OREGON_THN128_RX_SOFT_BITS - 1]) {
+        i = OREGON_THN128_RX_SOFT_BITS - 1;
+    } else {
+        return;
+    }
+
+    while ((i > 0) && (dec->softDeviation[i - 1] < deviation)) {
+        dec->softBits[i] = dec->softBits[i - 1];
+        dec->softDeviation[i] = dec->softDeviation[i - 1];
+        i--;
+    }
+    dec->softBits[i] = (uint8_t)dec->rxBit;
+    dec->softDeviation[i] = deviation;
+}
+
+/*! Add level deviation */
+#define SOFT_LEVEL(dec, tLevel, tNominal)   softLevel(dec, tLevel, tNominal)
+/*! Record bit confidence */
+#define SOFT_BIT(dec)                       softBit(dec)
+/*! Start recording a frame */
+#define SOFT_RESET(dec)                     ((dec)->softCount = 0, (dec)->bitDeviation = 0)
+#else
+#define SOFT_LEVEL(dec, tLevel, tNominal)
+#define SOFT_BIT(dec)
+#define SOFT_RESET(dec)
+#endif
+
+/*!
+ * \brief Check is pulse duration is within range
+ * \param tPulse
+ *      Measured pulse length in us
+ * \param tMin
+ *      Minimum pulse length in us
+ * \param tMax
+ *      Maximum pulse length in us
+ * \retval true
+ *      Pulse is in range
+ * \retval false
+ *      Pulse not in range
+ */
+DECODER_INLINE bool isPulseInRange(uint16_t tPulse, uint16_t tMin, uint16_t tMax)
+{
+    /* Check is pulse length between min and max time */
+    if ((tPulse >= tMin) && (tPulse <= tMax)) {
+        return true;
+    } else {
+        return false;
+    }
+}
+
+/*!
+ * \brief Find synchronisation
+ * \param dec
+ *      Decoder state
+ * \param protocol
+ *      Protocol of the instance
+ * \retval true
+ *      Sync found
+ * \retval false
+ *      Sync not found
+ */
+DECODER_INLINE bool findSync(OregonTHN128Decoder_t *dec, const OregonTHN128Protocol_t *protocol)
+{
+    uint16_t tSync = dec->tSync;
+    uint16_t tTol = protocol->tToleranceUs;
+
+    /* Read sync pulse, the low level of the sync is extended by a first bit 0 */
+    if (isPulseInRange(dec->tPinHigh, tSync - tTol, tSync + tTol)) {
+        if (isPulseInRange(dec->tPinLow, tSync + dec->tBit - tTol, tSync + dec->tBit + tTol)) {
+            dec->rxData = 0;
+            dec->rxState = StateMid1;
+            dec->rxBit = 1;
+            SOFT_RESET(dec);
+            RX_STATS_INC(dec, syncs);
+            return true;
+        } else if (isPulseInRange(dec->tPinLow, tSync - tTol, tSync + tTol)) {
+            dec->rxData = 0;
+            dec->rxState = StateEnd;
+            dec->rxBit = 0;
+            SOFT_RESET(dec);
+            RX_STATS_INC(dec, syncs);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*!
+ * \brief Store a logical bit 1 or 0
+ * \param dec
+ *      Decoder state
+ * \param protocol
+ *      Protocol of the instance
+ * \param one
+ *      true: Bit 1\n
+ *      false: Bit 0
+ * \retval true
+ *      All bits of the protocol received with a valid checksum
+ * \retval false
+ *      Frame not complete or checksum error
+ */
+DECODER_INLINE bool storeBit(OregonTHN128Decoder_t *dec, const OregonTHN128Protocol_t *protocol,
+                             bool one)
+{
+    /* Store received bit */
+    if (one) {
+        dec->rxData |= (1UL << dec->rxBit);
+    }
+    SOFT_BIT(dec);
+
+    /* Check if all data bits are received */
+    dec->rxBit++;
+    if (dec->rxBit >= protocol->numBits) {
+        /* Continue searching for the next frame, measured again from its preamble */
+        dec->rxState = StateSearchSync;
+        resetClock(dec, protocol);
+
+        if (!protocol->checkCrc(dec->rxData)) {
+            RX_STATS_INC(dec, crcErrors);
+            dec->crcError = true;
+            return false;
+        }
+        RX_STATS_INC(dec, frames);
+
+        return true;
+    }
+
+    return false;
+}
+
+/*!
+ * \brief Handle pulse RF receive pin
+ * \param dec
+ *      Decoder state
+ * \param protocol
+ *      Protocol of the instance
+ * \retval true
+ *      Frame received
+ * \retval false
+ *      No frame received
+ */
+DECODER_INLINE bool handlePulse(OregonTHN128Decoder_t *dec, const OregonTHN128Protocol_t *protocol)
+{
+    uint16_t tBit = dec->tBit;
+    uint16_t tTol = RX_BIT_TOLERANCE(dec, protocol, tBit);
+
+    if (isPulseInRange(dec->tPinHigh, tBit - tTol, tBit + tTol)) {
+        SOFT_LEVEL(dec, dec->tPinHigh, tBit);
+        if (dec->rxState == StateEnd) {
+            dec->rxState = StateMid0;
+            return storeBit(dec, protocol, 1);
+        } else if (dec->rxState == StateMid1) {
+            dec->rxState = StateEnd;
+        } else {
+            dec->rxState = StateSearchSync;
+            RX_STATS_INC(dec, pulseWrongState);
+        }
+    } else if (isPulseInRange(dec->tPinHigh, (tBit * 2) - tTol, (tBit * 2) + tTol)) {
+        SOFT_LEVEL(dec, dec->tPinHigh, tBit * 2);
+        if (dec->rxState == StateMid1) {
+            dec->rxState = StateMid0;
+            return storeBit(dec, protocol, 1);
+        } else {
+            dec->rxState = StateSearchSync;
+            RX_STATS_INC(dec, pulseWrongState);
+        }
+    } else {
+        dec->rxState = StateSearchSync;
+        RX_STATS_INC(dec, pulseOutOfRange);
+    }
+
+    return false;
+}
+
+/*!
+ * \brief Handle space RF receive pin
+ * \param dec
+ *      Decoder state
+ * \param protocol
+ *      Protocol of the instance
+ * \retval true
+ *      Frame received
+ * \retval false
+ *      No frame received
+ */
+DECODER_INLINE bool handleSpace(OregonTHN128Decoder_t *dec, const OregonTHN128Protocol_t *protocol)
+{
+    uint16_t tBit = dec->tBit;
+    uint16_t tTol = RX_BIT_TOLERANCE(dec, protocol, tBit);
+
+    /* State machine */
+    if (isPulseInRange(dec->tPinLow, tBit - tTol, tBit + tTol)) {
+        SOFT_LEVEL(dec, dec->tPinLow, tBit);
+        if (dec->rxState == StateEnd) {
+            dec->rxState = StateMid1;
+            return storeBit(dec, protocol, 0);
+        } else if (dec->rxState == StateMid0) {
+            dec->rxState = StateEnd;
+        } else {
+            dec->rxState = StateSearchSync;
+            RX_STATS_INC(dec, spaceWrongState);
+        }
+    } else if (isPulseInRange(dec->tPinLow, (tBit * 2) - tTol, (tBit * 2) + tTol)) {
+        SOFT_LEVEL(dec, dec->tPinLow, tBit * 2);
+        if (dec->rxState == StateMid0) {
+            dec->rxState = StateMid1;
+            return storeBit(dec, protocol, 0);
+        } else {
+            dec->rxState = StateSearchSync;
+            RX_STATS_INC(dec, spaceWrongState);
+        }
+    } else {
+        dec->rxState = StateSearchSync;
+        RX_STATS_INC(dec, spaceOutOfRange);
+    }
+
+    return false;
+}
+
+/*!
+ * \brief Set protocol and restart the search for its sync
+ * \param dec
+ *      Decoder state
+ * \param protocol
+ *      Protocol
+ */
+static void setProtocol(OregonTHN128Decoder_t *dec, const OregonTHN128Protocol_t *protocol)
+{
+    dec->protocol = protocol;
+    dec->syncRatioQ8 = (uint16_t)((((uint32_t)protocol->tSyncUs * 256) + (protocol->tBitUs / 2)) /
+                                  protocol->tBitUs);
+
+    /* Initialize with search for sync state */
+    dec->rxState = StateSearchSync;
+    dec->tPreambleSum = 0;
+    dec->preambleCount = 0;
+    resetClock(dec, protocol);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                     Public functions                                           */
+/*------------------------------------------------------------------------------------------------*/
+/*!
+ * \brief Initialize decoder
+ * \param dec
+ *      Decoder state
+ */
+void OregonTHN128_DecoderInit(OregonTHN128Decoder_t *dec)
+{
+    memset(dec, 0, sizeof(OregonTHN128Decoder_t));
+
+    setProtocol(dec, &OregonTHN128_ProtocolTHN128);
+}
+
+#if OREGON_THN128_RX_PROTOCOL_SELECT
+/*!
+ * \brief Set protocol timing and frame
+ * \details
+ *      Aborts a frame in progress and searches for the sync of the protocol.
+ * \param dec
+ *      Decoder state
+ * \param protocol
+ *      Protocol, must remain valid while the decoder uses it
+ */
+void OregonTHN128_DecoderSetProtocol(OregonTHN128Decoder_t *dec,
+                                     const OregonTHN128Protocol_t *protocol)
+{
+    setProtocol(dec, protocol);
+}
+#endif
+
+#if OREGON_THN128_RX_SOFT_BITS
+/*!
+ * \brief Enable soft bit windows
+ * \details
+ *      Levels between 0.5 and 2.5 bit times are accepted as the nearest 1 or 2 bit times, so
+ *      frames with a checksum error can be retried with OregonTHN128_RecoverSoft(). Without a
+ *      retry, the wider windows only pass more frames with a checksum error, so the default is
+ *      the tolerance of the protocol. Call after OregonTHN128_DecoderInit().
+ * \param dec
+ *      Decoder state
+ * \param enable
+ *      true: Soft windows, false: Protocol tolerance windows (default)
+ */
+void OregonTHN128_DecoderSetSoft(OregonTHN128Decoder_t *dec, bool enable)
+{
+    dec->softWindows = enable;
+}
+#endif
+
+/*!
+ * \brief Decode one pulse (high) or space (low) with the state machine of a protocol
+ * \param dec
+ *      Decoder state
+ * \param protocol
+ *      Protocol of the instance
+ * \param tPulse
+ *      Length of the pulse or space in us
+ * \param pulse
+ *      true: pulse (high level), false: space (low level)
+ * \param rawData
+ *      32-bit raw data output, written when a frame is received
+ * \return
+ *      true: Frame with valid checksum received
+ */
+DECODER_INLINE bool decodeEdge(OregonTHN128Decoder_t *dec, const OregonTHN128Protocol_t *protocol,
+                               uint16_t tPulse, bool pulse, uint32_t *rawData)
+{
+    bool frameReceived = false;
+
+    /* Store pulse (high) or space (low) length */
+    if (pulse) {
+        dec->tPinHigh = tPulse;
+    } else {
+        dec->tPinLow = tPulse;
+    }
+
+#if OREGON_THN128_RX_ADAPTIVE_CLOCK
+    /* Measure bit time from the preamble before the sync */
+    if (dec->rxState == StateSearchSync) {
+        measurePreamble(dec, protocol, tPulse);
+    }
+#endif
+
+    /* Always search for sync */
+    if (findSync(dec, protocol)) {
+        return false;
+    }
+
+    /* Handle received pulse */
+    if (dec->rxState != StateSearchSync) {
+        if (pulse) {
+            frameReceived = handlePulse(dec, protocol);
+        } else {
+            frameReceived = handleSpace(dec, protocol);
+        }
+    }
+
+    if (frameReceived) {
+        *rawData = dec->rxData;
+    }
+
+    return frameReceived;
+}
+
+/*!
+ * \def DECODER_INSTANCE()
+ * \brief Instantiate the state machine for a protocol
+ * \details
+ *      With a protocol of internal linkage, timings and frame length are compile time constants
+ *      of the instance. With dec->protocol, the instance reads the protocol at run time.
+ */
+#define DECODER_INSTANCE(name, protocol)                                                    \
+    static bool IRAM_ATTR name(OregonTHN128Decoder_t *dec, uint16_t tPulse, bool pulse,     \
+                               uint32_t *rawData)                                           \
+    {                                                                                       \
+        return decodeEdge(dec, (protocol), tPulse, pulse, rawData);                         \
+    }
+
+/*! THN128 state machine */
+DECODER_INSTANCE(decodeEdgeTHN128, &_protocolTHN128)
+
+#if OREGON_THN128_RX_PROTOCOL_SELECT
+/*! State machine of a protocol selected at run time */
+DECODER_INSTANCE(decodeEdgeProtocol, dec->protocol)
+#endif
+
+/*!
+ * \brief Decode one pulse (high) or space (low)
+ * \details
+ *      Called at each edge with the length of the level which just ended. Short glitches should be
+ *      filtered by the caller: edges closer than the protocol tolerance to the previous accepted
+ *      edge are ignored and their time is added to the next pulse or space.
+ *      OregonTHN128_ProtocolTHN128 is decoded by a state machine specialized at compile time.
+ * \param dec
+ *      Decoder state
+ * \param tPulse
+ *      Length of the pulse or space in us
+ * \param pulse
+ *      true: pulse (high level), false: space (low level)
+ * \param rawData
+ *      32-bit raw data output, written when a frame is received
+ * \retval true
+ *      Frame with valid checksum received
+ * \retval false
+ *      No frame received
+ */
+bool IRAM_ATTR OregonTHN128_DecodeEdge(OregonTHN128Decoder_t *dec, uint16_t tPulse, bool pulse,
+                                       uint32_t *rawData)
+{
+#if OREGON_THN128_RX_PROTOCOL_SELECT
+    if (dec->protocol != &OregonTHN128_ProtocolTHN128) {
+        return decodeEdgeProtocol(dec, tPulse, pulse, rawData);
+    }
+#endif
+
+    return decodeEdgeTHN128(dec, tPulse, pulse, rawData);
+}
+
+/*!
+ * \brief Decode recorded edge durations
+ * \details
+ *      Runs the THN128 receive state machine over a buffer at memory speed, including the same
+ *      short glitch filter as the receive interrupt handler.
+ * \param durations
+ *      Length of each level in us
+ * \param levels
+ *      Level of each duration: 0 = low (space), otherwise high (pulse)
+ * \param n
+ *      Number of durations
+ * \param callback
+ *      Called for each received frame with a valid checksum, may be NULL
+ * \param arg
+ *      User argument passed to the callback
+ * \return
+ *      Number of frames received
+ */
+size_t OregonTHN128_DecodePulses(const uint16_t *durations, const uint8_t *levels, size_t n,
+                                 OregonTHN128DecodeCallback_t callback, void *arg)
+{
+    OregonTHN128Decoder_t dec;
+    uint32_t tPulse = 0;
+    uint32_t rawData;
+    size_t numFrames = 0;
+
+    OregonTHN128_DecoderInit(&dec);
+
+    for (size_t i = 0; i < n; i++) {
+        /* Ignore short pulses and add them to the next level */
+        tPulse += durations[i];
+        if (tPulse < OREGON_THN128_DECODER_TOLERANCE(&dec)) {
+            continue;
+        }
+
+        if (OregonTHN128_DecodeEdge(&dec, (tPulse > 0xffff) ? 0xffff : (uint16_t)tPulse,
+                                    levels[i] ? true : false, &rawData)) {
+            numFrames++;
+            if (callback) {
+                callback(rawData, arg);
+            }
+        }
+        tPulse = 0;
+    }
+
+    return numFrames;
+}
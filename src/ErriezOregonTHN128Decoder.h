@@ -0,0 +1,234 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Decoder.h
+ * \brief Oregon THN128 433MHz temperature receive state machine
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      The decoder has no Arduino dependency. It is driven by the receive interrupt handler
+ *      (see ErriezOregonTHN128Receive.h) or by recorded edge durations on a host.
+ *
+ *      The state machine is shared by the Oregon v1 sensors. The sync and bit timings, tolerance,
+ *      number of frame bits, checksum and field extractors are taken from an
+ *      OregonTHN128Protocol_t, by default OregonTHN128_ProtocolTHN128. The state machine is
+ *      instantiated at compile time for OregonTHN128_ProtocolTHN128, with constant timings and a
+ *      direct checksum call. A sibling sensor is received by passing its own protocol to
+ *      OregonTHN128_DecoderSetProtocol() or OregonTHN128_RxSetProtocol(), decoded by a second
+ *      instance which reads the protocol at run time.
+ */
+
+#ifndef ERRIEZ_OREGON_THN128_DECODER_H_
+#define ERRIEZ_OREGON_THN128_DECODER_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ErriezOregonTHN128.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \def OREGON_THN128_RX_ADAPTIVE_CLOCK
+ * \brief Measure the bit time of each frame from the preamble
+ * \details
+ *      1: The sync and bit windows are centered on the bit time measured from the preamble, so
+ *      frames of sensors with a drifted clock are received. 0: Fixed windows around the nominal
+ *      bit and sync time of the protocol. Can be overruled by a compiler define.
+ */
+#ifndef OREGON_THN128_RX_ADAPTIVE_CLOCK
+#define OREGON_THN128_RX_ADAPTIVE_CLOCK     1
+#endif
+
+/*!
+ * \def OREGON_THN128_RX_PROTOCOL_SELECT
+ * \brief Protocol selectable at run time
+ * \details
+ *      1: OregonTHN128_DecoderSetProtocol() and OregonTHN128_RxSetProtocol() select a sibling
+ *      protocol. Each edge compares the protocol with OregonTHN128_ProtocolTHN128 to select the
+ *      instance. 0: Only the THN128 instance is compiled, without the compare and the flash of the
+ *      second instance. Can be overruled by a compiler define.
+ */
+#ifndef OREGON_THN128_RX_PROTOCOL_SELECT
+#define OREGON_THN128_RX_PROTOCOL_SELECT    1
+#endif
+
+/*!
+ * \def OREGON_THN128_RX_STATS
+ * \brief Count decoder events
+ * \details
+ *      1: Syncs, aborted frames per reason and checksum errors are counted in the decoder state,
+ *      see OregonTHN128_GetRxStats(). 0: Disabled. Can be overruled by a compiler define.
+ */
+#ifndef OREGON_THN128_RX_STATS
+#define OREGON_THN128_RX_STATS              1
+#endif
+
+/*!
+ * \def OREGON_THN128_RX_SOFT_BITS
+ * \brief Number of least confident bits recorded per frame (0..8)
+ * \details
+ *      1..8: The confidence of a bit is the largest deviation of its levels from the nominal
+ *      length. The bits with the largest deviation of a frame with a checksum error are retried
+ *      with OregonTHN128_RecoverSoft(), 2^n - 1 checksum checks. More bits recover more frames,
+ *      but accept more wrong frames. Only when enabled with OregonTHN128_DecoderSetSoft(), which
+ *      frame recovery does, levels between 0.5 and 2.5 bit times are taken as the nearest 1 or 2
+ *      bit times instead of aborting the frame outside +/-T_RX_TOLERANCE_US.
+ *      0: No soft bits. Can be overruled by a compiler define.
+ */
+#ifndef OREGON_THN128_RX_SOFT_BITS
+#define OREGON_THN128_RX_SOFT_BITS          2
+#endif
+
+/*!
+ * \brief Oregon v1 protocol timing, frame and fields
+ * \details
+ *      Passed by pointer, the protocol must remain valid while the decoder uses it.
+ */
+typedef struct {
+    uint16_t tSyncUs;               /*!< Sync pulse and space in us */
+    uint16_t tBitUs;                /*!< Half Manchester bit time in us */
+    uint16_t tToleranceUs;          /*!< Sync, bit and glitch tolerance in us, < tBitUs / 2 */
+    uint8_t numBits;                /*!< Frame bits 2..32, least significant bit first */
+    bool (*checkCrc)(uint32_t rawData); /*!< Returns true when the frame checksum is valid */
+    bool (*isPlausible)(uint32_t rawData); /*!< Returns true when the fields are valid, used to
+                                                accept recovered frames */
+    bool (*rawToData)(uint32_t rawData, OregonTHN128Data_t *data); /*!< Extracts channel,
+                                                rolling address, temperature, sign and low
+                                                battery, returns checkCrc() */
+    uint32_t (*dataToRaw)(OregonTHN128Data_t *data); /*!< Builds a frame with checksum */
+} OregonTHN128Protocol_t;
+
+/*! Initializer of the THN128 protocol: timings of ErriezOregonTHN128.h and 32-bit frames */
+#define OREGON_THN128_PROTOCOL_THN128 {                                 \
+    T_SYNC_US,                      /* tSyncUs */                       \
+    T_BIT_US,                       /* tBitUs */                        \
+    T_RX_TOLERANCE_US,              /* tToleranceUs */                  \
+    32,                             /* numBits */                       \
+    OregonTHN128_CheckCRC,          /* checkCrc */                      \
+    OregonTHN128_IsPlausible,       /* isPlausible */                   \
+    OregonTHN128_RawToData,         /* rawToData */                     \
+    OregonTHN128_DataToRaw          /* dataToRaw */                     \
+}
+
+/*!
+ * \brief Receive statistics
+ * \details
+ *      Counters wrap around. Frames delivered to the application: frames + recovered +
+ *      softRecovered - overruns.
+ */
+typedef struct {
+    uint32_t edges;                 /*!< Edges seen by the interrupt handler */
+    uint32_t glitches;              /*!< Edges shorter than T_RX_TOLERANCE_US ignored */
+    uint16_t syncs;                 /*!< Syncs found */
+    uint16_t pulseOutOfRange;       /*!< Frames aborted on a pulse of no 1 or 2 bit times */
+    uint16_t pulseWrongState;       /*!< Frames aborted on a pulse not expected in the state */
+    uint16_t spaceOutOfRange;       /*!< Frames aborted on a space of no 1 or 2 bit times */
+    uint16_t spaceWrongState;       /*!< Frames aborted on a space not expected in the state */
+    uint16_t crcErrors;             /*!< Complete frames with a checksum error */
+    uint16_t frames;                /*!< Frames with a valid checksum */
+    uint16_t recovered;             /*!< Frames recovered from two copies with checksum errors */
+    uint16_t softRecovered;         /*!< Frames recovered by flipping least confident bits */
+    uint16_t overruns;              /*!< Frames dropped on a full receive queue */
+} OregonTHN128RxStats_t;
+
+/*!
+ * \brief Decoder state
+ * \details
+ *      Fields are private to the library. Initialize with OregonTHN128_DecoderInit().
+ */
+typedef struct {
+    const OregonTHN128Protocol_t *protocol; /*!< Protocol timing and frame */
+    uint16_t tPinHigh;              /*!< Last pulse (high) length in us */
+    uint16_t tPinLow;               /*!< Last space (low) length in us */
+    int8_t rxBit;                   /*!< Bit number being received */
+    uint32_t rxData;                /*!< Frame being received */
+    volatile uint8_t rxState;       /*!< Receive state */
+    uint16_t tBit;                  /*!< Bit time of the current frame in us */
+    uint16_t tSync;                 /*!< Sync time of the current frame in us */
+    uint16_t syncRatioQ8;           /*!< Protocol sync time / bit time in 1/256 */
+    uint16_t tPreambleSum;          /*!< Sum of the preamble levels being measured */
+    uint8_t preambleCount;          /*!< Number of preamble levels being measured */
+    bool crcError;                  /*!< rxData is a complete frame with a checksum error, cleared
+                                         by the caller */
+#if OREGON_THN128_RX_SOFT_BITS
+    bool softWindows;               /*!< Bit windows of 0.5 to 2.5 bit times, default off */
+    uint16_t bitDeviation;          /*!< Largest level deviation of the bit being received in us */
+    uint8_t softCount;              /*!< Number of recorded bits */
+    uint8_t softBits[OREGON_THN128_RX_SOFT_BITS]; /*!< Least confident bit numbers of rxData,
+                                                       least confident first */
+    uint16_t softDeviation[OREGON_THN128_RX_SOFT_BITS]; /*!< Deviation of softBits[] in us */
+#endif
+#if OREGON_THN128_RX_STATS
+    OregonTHN128RxStats_t stats;    /*!< Receive statistics */
+#endif
+} OregonTHN128Decoder_t;
+
+/*! Decoder searching for the preamble or sync, no frame in progress */
+#define OREGON_THN128_DECODER_IDLE(dec)     ((dec)->rxState == 0)
+
+/*! Glitch tolerance of the decoder protocol in us, a constant for the THN128 */
+#if OREGON_THN128_RX_PROTOCOL_SELECT
+#define OREGON_THN128_DECODER_TOLERANCE(dec) \
+    (((dec)->protocol == &OregonTHN128_ProtocolTHN128) ? T_RX_TOLERANCE_US : \
+                                                         (dec)->protocol->tToleranceUs)
+#else
+#define OREGON_THN128_DECODER_TOLERANCE(dec) T_RX_TOLERANCE_US
+#endif
+
+/*!
+ * \brief Callback for each decoded frame with a valid checksum
+ * \param rawData
+ *      32-bit raw data
+ * \param arg
+ *      User argument passed to OregonTHN128_DecodePulses()
+ */
+typedef void (*OregonTHN128DecodeCallback_t)(uint32_t rawData, void *arg);
+
+/*! THN128 protocol, the default of OregonTHN128_DecoderInit() */
+extern const OregonTHN128Protocol_t OregonTHN128_ProtocolTHN128;
+
+/* Public functions */
+void OregonTHN128_DecoderInit(OregonTHN128Decoder_t *dec);
+#if OREGON_THN128_RX_PROTOCOL_SELECT
+void OregonTHN128_DecoderSetProtocol(OregonTHN128Decoder_t *dec,
+                                     const OregonTHN128Protocol_t *protocol);
+#endif
+#if OREGON_THN128_RX_SOFT_BITS
+void OregonTHN128_DecoderSetSoft(OregonTHN128Decoder_t *dec, bool enable);
+#endif
+bool OregonTHN128_DecodeEdge(OregonTHN128Decoder_t *dec, uint16_t tPulse, bool pulse,
+                             uint32_t *rawData);
+size_t OregonTHN128_DecodePulses(const uint16_t *durations, const uint8_t *levels, size_t n,
+                                 OregonTHN128DecodeCallback_t callback, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ERRIEZ_OREGON_THN128_DECODER_H_ */
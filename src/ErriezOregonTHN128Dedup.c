@@ -0,0 +1,131 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Dedup.c
+ * \brief Oregon THN128 repeated frame filter
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ */
+
+#include <string.h>
+
+#include "ErriezOregonTHN128Dedup.h"
+
+/* Check number of slots */
+#if (OREGON_THN128_DEDUP_SLOTS < 4) || (OREGON_THN128_DEDUP_SLOTS > OREGON_THN128_SENSOR_KEYS) || \
+    ((OREGON_THN128_DEDUP_SLOTS & (OREGON_THN128_DEDUP_SLOTS - 1)) != 0)
+#error "OREGON_THN128_DEDUP_SLOTS must be a power of 2 between 4 and OREGON_THN128_SENSOR_KEYS"
+#endif
+
+/*!
+ * \def DEDUP_SLOT()
+ * \brief Slot index of byte 0 of a frame
+ * \details
+ *      Sensor key of the channel in bit 6..7 and the 3-bit rolling address in bit 0..2.
+ */
+#define DEDUP_SLOT(byte0) \
+    (OREGON_THN128_SENSOR((((byte0) >> 6) & 0x03) + 1, (byte0)) & (OREGON_THN128_DEDUP_SLOTS - 1))
+
+/*!
+ * \brief Initialize repeated frame filter
+ * \param dedup
+ *      Repeated frame filter
+ * \param windowMs
+ *      Repeat window in ms, for example OREGON_THN128_DEDUP_WINDOW_MS. 0: Report all frames.
+ */
+void OregonTHN128_DedupInit(OregonTHN128Dedup_t *dedup, uint16_t windowMs)
+{
+    memset(dedup, 0, sizeof(OregonTHN128Dedup_t));
+    dedup->windowMs = windowMs;
+}
+
+/*!
+ * \brief Check frame for a repeat of the last reported frame of the sensor
+ * \details
+ *      A frame is a repeat when the raw data is identical to the last frame of the same channel
+ *      and rolling address and it is received within the window after the previous copy. Each
+ *      repeat restarts the window, so a burst of copies is reported once.
+ * \param dedup
+ *      Repeated frame filter
+ * \param rawData
+ *      32-bit raw data with a valid checksum
+ * \param tMs
+ *      Receive time in ms, for example millis()
+ * \retval 0
+ *      First copy, report frame
+ * \retval 1..255
+ *      Repeat number, drop frame
+ */
+uint8_t OregonTHN128_DedupFilter(OregonTHN128Dedup_t *dedup, uint32_t rawData, uint32_t tMs)
+{
+    OregonTHN128DedupSlot_t *slot = &dedup->slots[DEDUP_SLOT((uint8_t)rawData)];
+
+    if (dedup->windowMs == 0) {
+        return 0;
+    }
+
+    /* Unsigned subtraction handles the millis() wrap */
+    if (slot->valid && (slot->rawData == rawData) &&
+        ((uint32_t)(tMs - slot->tReceived) <= dedup->windowMs)) {
+        slot->tReceived = tMs;
+        if (slot->repeatCount < 255) {
+            slot->repeatCount++;
+        }
+        return slot->repeatCount;
+    }
+
+    /* New frame */
+    slot->rawData = rawData;
+    slot->tReceived = tMs;
+    slot->repeatCount = 0;
+    slot->valid = true;
+
+    return 0;
+}
+
+/*!
+ * \brief Get number of repeats filtered after a reported frame
+ * \details
+ *      The repeat is received after the first copy is reported, so call this function when the
+ *      repeat window has expired or on the next frame of the sensor.
+ * \param dedup
+ *      Repeated frame filter
+ * \param data
+ *      Reported frame
+ * \return
+ *      Number of repeats of the frame, 0 when the sensor slot holds another frame
+ */
+uint8_t OregonTHN128_DedupRepeatCount(const OregonTHN128Dedup_t *dedup,
+                                      const OregonTHN128Data_t *data)
+{
+    const OregonTHN128DedupSlot_t *slot = &dedup->slots[DEDUP_SLOT((uint8_t)data->rawData)];
+
+    if (!slot->valid || (slot->rawData != data->rawData)) {
+        return 0;
+    }
+
+    return slot->repeatCount;
+}
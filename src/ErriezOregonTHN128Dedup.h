@@ -0,0 +1,105 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Dedup.h
+ * \brief Oregon THN128 repeated frame filter
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      A THN128 transmits every frame twice, T_SPACE_FRAMES_MS apart. The filter reports the
+ *      first copy and counts the repeats of a frame with identical raw data from the same channel
+ *      and rolling address within a time window. Every sensor slot is addressed directly by its
+ *      channel and rolling address, so memory is fixed and each frame is checked in constant time.
+ */
+
+#ifndef ERRIEZ_OREGON_THN128_DEDUP_H_
+#define ERRIEZ_OREGON_THN128_DEDUP_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ErriezOregonTHN128.h"
+
+/*!
+ * \def OREGON_THN128_DEDUP_SLOTS
+ * \brief Number of sensors tracked by the repeated frame filter
+ * \details
+ *      Power of 2 between 4 and OREGON_THN128_SENSOR_KEYS. The default has one slot per sensor key
+ *      of channel and rolling address. Fewer slots save RAM: slots are selected by the low bits of
+ *      the sensor key and sensors sharing a slot evict each other. Can be overruled by a compiler
+ *      define.
+ */
+#ifndef OREGON_THN128_DEDUP_SLOTS
+#define OREGON_THN128_DEDUP_SLOTS       OREGON_THN128_SENSOR_KEYS
+#endif
+
+/*!
+ * \def OREGON_THN128_DEDUP_WINDOW_MS
+ * \brief Default repeated frame window in ms
+ * \details
+ *      Covers the repeat T_SPACE_FRAMES_MS after the first frame with margin for a delayed read,
+ *      far below the 30 second transmit interval. The repeat count of a reported frame is final
+ *      only after this window has expired, as the repeat is received after the first copy has
+ *      been read.
+ */
+#ifndef OREGON_THN128_DEDUP_WINDOW_MS
+#define OREGON_THN128_DEDUP_WINDOW_MS   500
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Last reported frame of a sensor slot
+ */
+typedef struct {
+    uint32_t rawData;               /*!< Raw data of the last reported frame */
+    uint32_t tReceived;             /*!< Receive time of the last copy in ms */
+    uint8_t repeatCount;            /*!< Repeats filtered since the last reported frame */
+    bool valid;                     /*!< Slot contains a frame */
+} OregonTHN128DedupSlot_t;
+
+/*!
+ * \brief Repeated frame filter
+ * \details
+ *      Fields are private to the library. Initialize with OregonTHN128_DedupInit().
+ */
+typedef struct {
+    uint16_t windowMs;              /*!< Repeat window in ms, 0: disabled */
+    OregonTHN128DedupSlot_t slots[OREGON_THN128_DEDUP_SLOTS]; /*!< Sensor slots */
+} OregonTHN128Dedup_t;
+
+/* Public functions */
+void OregonTHN128_DedupInit(OregonTHN128Dedup_t *dedup, uint16_t windowMs);
+uint8_t OregonTHN128_DedupFilter(OregonTHN128Dedup_t *dedup, uint32_t rawData, uint32_t tMs);
+uint8_t OregonTHN128_DedupRepeatCount(const OregonTHN128Dedup_t *dedup,
+                                      const OregonTHN128Data_t *data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ERRIEZ_OREGON_THN128_DEDUP_H_ */
@@ -0,0 +1,197 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Encoder.c
+ * \brief Oregon THN128 433MHz temperature transmit waveform
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ */
+
+#include "ErriezOregonTHN128Encoder.h"
+
+/*!
+ * \defgroup Frame steps
+ * \details
+ *      A frame is a sequence of steps with a fixed level and duration. Steps with the same level
+ *      are merged by OregonTHN128_EncoderNext().
+ * @{
+ */
+/*! 12 preamble bits 1, two steps per bit */
+#define STEP_PREAMBLE       0
+/*! Space after preamble */
+#define STEP_PREAMBLE_SPACE 24
+/*! Sync pulse */
+#define STEP_SYNC_HIGH      25
+/*! Sync space */
+#define STEP_SYNC_LOW       26
+/*! 32 data bits, two steps per bit */
+#define STEP_DATA           27
+/*! Space between two frames */
+#define STEP_FRAME_SPACE    (STEP_DATA + 64)
+/*! @} */
+
+/*!
+ * \brief Get level and duration of a frame step
+ * \details
+ *      Same waveform as the blocking transmit functions: bit 1 is high-low, bit 0 is low-high.
+ * \param enc
+ *      Encoder state
+ * \param step
+ *      Step number
+ * \param duration
+ *      Output duration in us
+ * \return
+ *      Level 0 or 1
+ */
+static uint8_t IRAM_ATTR frameStep(const OregonTHN128Encoder_t *enc, uint8_t step,
+                                   uint32_t *duration)
+{
+    uint8_t bit;
+
+    if (step < STEP_PREAMBLE_SPACE) {
+        *duration = T_BIT_US;
+        return (step & 1) ? 0 : 1;
+    } else if (step == STEP_PREAMBLE_SPACE) {
+        *duration = T_PREAMBLE_SPACE_US;
+        return 0;
+    } else if (step == STEP_SYNC_HIGH) {
+        *duration = T_SYNC_US;
+        return 1;
+    } else if (step == STEP_SYNC_LOW) {
+        *duration = T_SYNC_US;
+        return 0;
+    } else if (step < STEP_FRAME_SPACE) {
+        step -= STEP_DATA;
+        bit = (enc->rawData >> (step >> 1)) & 1;
+        *duration = T_BIT_US;
+        return (step & 1) ? !bit : bit;
+    }
+
+    *duration = T_SPACE_FRAMES_MS * 1000UL;
+    return 0;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                     Public functions                                           */
+/*------------------------------------------------------------------------------------------------*/
+/*!
+ * \brief Initialize encoder
+ * \param enc
+ *      Encoder state
+ * \param rawData
+ *      32-bit raw data
+ * \param numFrames
+ *      Number of times the frame is transmitted, with T_SPACE_FRAMES_MS between the frames
+ */
+void OregonTHN128_EncoderInit(OregonTHN128Encoder_t *enc, uint32_t rawData, uint8_t numFrames)
+{
+    enc->rawData = rawData;
+    enc->step = STEP_PREAMBLE;
+    enc->numFrames = numFrames;
+}
+
+/*!
+ * \brief Get next level of the waveform
+ * \details
+ *      Consecutive steps with the same level are returned as one level, so each call is one
+ *      edge of the transmit pin. After the last level, the transmit pin must be set low.
+ * \param enc
+ *      Encoder state
+ * \param level
+ *      Output level 0 or 1
+ * \param duration
+ *      Output duration of the level in us
+ * \return
+ *      true: Level returned, false: transmission complete
+ */
+bool IRAM_ATTR OregonTHN128_EncoderNext(OregonTHN128Encoder_t *enc, uint8_t *level,
+                                        uint32_t *duration)
+{
+    uint32_t stepDuration;
+    uint8_t lastStep;
+
+    if (enc->numFrames == 0) {
+        return false;
+    }
+
+    /* The space after the last frame is not transmitted */
+    lastStep = (enc->numFrames > 1) ? STEP_FRAME_SPACE : (STEP_FRAME_SPACE - 1);
+
+    *level = frameStep(enc, enc->step, duration);
+    for (;;) {
+        if (enc->step == lastStep) {
+            if (--enc->numFrames == 0) {
+                break;
+            }
+            enc->step = STEP_PREAMBLE;
+            lastStep = (enc->numFrames > 1) ? STEP_FRAME_SPACE : (STEP_FRAME_SPACE - 1);
+        } else {
+            enc->step++;
+        }
+
+        /* Merge next step with the same level */
+        if (frameStep(enc, enc->step, &stepDuration) != *level) {
+            break;
+        }
+        *duration += stepDuration;
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Render the waveform of one frame
+ * \details
+ *      Same format as the input of OregonTHN128_DecodePulses(). The frame starts with the first
+ *      preamble pulse and ends with the last data level, the transmit pin is low afterwards.
+ * \param rawData
+ *      32-bit raw data
+ * \param durations
+ *      Output length of each level in us
+ * \param levels
+ *      Output level of each duration, 0 = low, 1 = high
+ * \param maxEdges
+ *      Size of the output arrays, OREGON_THN128_FRAME_EDGES_MAX for a complete frame
+ * \return
+ *      Number of levels written
+ */
+size_t OregonTHN128_EncodeEdges(uint32_t rawData, uint16_t *durations, uint8_t *levels,
+                                size_t maxEdges)
+{
+    OregonTHN128Encoder_t enc;
+    uint32_t duration;
+    uint8_t level;
+    size_t n = 0;
+
+    OregonTHN128_EncoderInit(&enc, rawData, 1);
+    while ((n < maxEdges) && OregonTHN128_EncoderNext(&enc, &level, &duration)) {
+        durations[n] = (uint16_t)duration;
+        levels[n] = level;
+        n++;
+    }
+
+    return n;
+}
@@ -0,0 +1,75 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Encoder.h
+ * \brief Oregon THN128 433MHz temperature transmit waveform
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      The encoder has no Arduino dependency. It returns the transmit waveform as levels with
+ *      their duration and is driven by the transmit timer interrupt handler
+ *      (see ErriezOregonTHN128Transmit.h) or by a simulation on a host.
+ */
+
+#ifndef ERRIEZ_OREGON_THN128_ENCODER_H_
+#define ERRIEZ_OREGON_THN128_ENCODER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ErriezOregonTHN128.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \def OREGON_THN128_FRAME_EDGES_MAX
+ * \brief Maximum number of levels of one frame: 24 preamble, 2 sync and 64 data levels
+ */
+#define OREGON_THN128_FRAME_EDGES_MAX   (24 + 2 + 64)
+
+/*!
+ * \brief Encoder state
+ * \details
+ *      Fields are private to the library. Initialize with OregonTHN128_EncoderInit().
+ */
+typedef struct {
+    uint32_t rawData;               /*!< Frame being transmitted */
+    uint8_t step;                   /*!< Next half bit of the frame */
+    uint8_t numFrames;              /*!< Frames left including the current frame */
+} OregonTHN128Encoder_t;
+
+/* Public functions */
+void OregonTHN128_EncoderInit(OregonTHN128Encoder_t *enc, uint32_t rawData, uint8_t numFrames);
+bool OregonTHN128_EncoderNext(OregonTHN128Encoder_t *enc, uint8_t *level, uint32_t *duration);
+size_t OregonTHN128_EncodeEdges(uint32_t rawData, uint16_t *durations, uint8_t *levels,
+                                size_t maxEdges);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ERRIEZ_OREGON_THN128_ENCODER_H_ */
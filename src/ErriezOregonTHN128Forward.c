@@ -0,0 +1,840 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Forward.c
+ * \brief Oregon THN128 store-and-forward buffer in flash
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ */
+
+#include <string.h>
+#include "ErriezOregonTHN128Forward.h"
+
+/*! Size of the sector header in Bytes */
+#define HEADER_SIZE         20
+
+/*! Size of a record in Bytes */
+#define RECORD_SIZE         6
+
+/*! Uncommitted bit of the record time delta */
+#define DT_UNCOMMITTED      0x8000
+
+/*! Maximum time delta between records in a sector */
+#define DT_MAX              0x7fff
+
+/*! No sector */
+#define SECTOR_NONE         0xffff
+
+/*!
+ * \brief Sector header, stored little endian
+ */
+typedef struct {
+    uint32_t magic;         /*!< OREGON_THN128_FORWARD_MAGIC */
+    uint32_t seq;           /*!< Sequence number */
+    uint32_t eraseCount;    /*!< Number of erases */
+    uint32_t eraseCountInv; /*!< Inverted number of erases */
+    uint32_t tBase;         /*!< Timestamp before the first record */
+} Header_t;
+
+/*!
+ * \brief Read a little endian 32-bit value
+ */
+static uint32_t getLe32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+           ((uint32_t)p[3] << 24);
+}
+
+/*!
+ * \brief Write a little endian 32-bit value
+ */
+static void putLe32(uint8_t *p, uint32_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+/*!
+ * \brief Address of a sector
+ */
+static uint32_t sectorAddr(const OregonTHN128Forward_t *fwd, uint16_t sector)
+{
+    return (uint32_t)sector * fwd->storage->sectorSize;
+}
+
+/*!
+ * \brief Read a sector header
+ * \return
+ *      true: valid header, false: erased, incomplete or read error
+ */
+static bool readHeader(const OregonTHN128Forward_t *fwd, uint16_t sector, Header_t *header)
+{
+    uint8_t buf[HEADER_SIZE];
+
+    if (!fwd->storage->read(fwd->storage->ctx, sectorAddr(fwd, sector), buf, sizeof(buf))) {
+        memset(buf, 0, sizeof(buf));
+    }
+
+    header->magic = getLe32(&buf[0]);
+    header->seq = getLe32(&buf[4]);
+    header->eraseCount = getLe32(&buf[8]);
+    header->eraseCountInv = getLe32(&buf[12]);
+    header->tBase = getLe32(&buf[16]);
+
+    return header->magic == OREGON_THN128_FORWARD_MAGIC;
+}
+
+/*!
+ * \brief Erase count of a sector header
+ * \details
+ *      The erase count of a header written partially at a power loss is lost.
+ */
+static uint32_t eraseCount(const Header_t *header)
+{
+    return (header->eraseCount == ~header->eraseCountInv) ? header->eraseCount : 0;
+}
+
+/*!
+ * \brief Read a record
+ * \param rawData
+ *      Raw data
+ * \return
+ *      Time delta field, 0xffff on read error
+ */
+static uint16_t readRecord(const OregonTHN128Forward_t *fwd, uint16_t sector, uint16_t index,
+                           uint32_t *rawData)
+{
+    uint8_t buf[RECORD_SIZE];
+    uint32_t addr = sectorAddr(fwd, sector) + fwd->recordsOffset + (uint32_t)index * RECORD_SIZE;
+
+    if (!fwd->storage->read(fwd->storage->ctx, addr, buf, sizeof(buf))) {
+        memset(buf, 0xff, sizeof(buf));
+    }
+    *rawData = getLe32(buf);
+
+    return (uint16_t)(buf[4] | (buf[5] << 8));
+}
+
+/*!
+ * \brief Check if a record was never written
+ */
+static bool recordErased(const OregonTHN128Forward_t *fwd, uint16_t sector, uint16_t index)
+{
+    uint32_t rawData;
+
+    return (readRecord(fwd, sector, index, &rawData) == 0xffff) && (rawData == 0xffffffffUL);
+}
+
+/*!
+ * \brief Number of written records of a sector
+ * \details
+ *      Records are written in order, so the first erased record is found by binary search.
+ */
+static uint16_t usedRecords(const OregonTHN128Forward_t *fwd, uint16_t sector)
+{
+    uint16_t lo = 0;
+    uint16_t hi = fwd->recordsPerSector;
+    uint16_t mid;
+
+    while (lo < hi) {
+        mid = (uint16_t)(lo + (hi - lo) / 2);
+        if (recordErased(fwd, sector, mid)) {
+            hi = mid;
+        } else {
+            lo = (uint16_t)(mid + 1);
+        }
+    }
+
+    return lo;
+}
+
+/*!
+ * \brief Number of consumed records of a sector
+ * \details
+ *      Records are consumed in order: the acknowledge bits are cleared from bit 0 of the first
+ *      Byte.
+ */
+static uint16_t consumedRecords(const OregonTHN128Forward_t *fwd, uint16_t sector)
+{
+    uint8_t buf[16];
+    uint32_t addr = sectorAddr(fwd, sector) + HEADER_SIZE;
+    uint16_t mapBytes = (uint16_t)((fwd->recordsPerSector + 7) / 8);
+    uint16_t consumed = 0;
+    uint16_t len;
+    uint16_t i;
+    uint8_t bits;
+
+    while (mapBytes) {
+        len = (mapBytes < sizeof(buf)) ? mapBytes : (uint16_t)sizeof(buf);
+        if (!fwd->storage->read(fwd->storage->ctx, addr, buf, len)) {
+            break;
+        }
+        for (i = 0; i < len; i++) {
+            if (buf[i] != 0) {
+                for (bits = buf[i]; !(bits & 1); bits >>= 1) {
+                    consumed++;
+                }
+                return (consumed < fwd->recordsPerSector) ? consumed : fwd->recordsPerSector;
+            }
+            consumed = (uint16_t)(consumed + 8);
+        }
+        addr += len;
+        mapBytes -= len;
+    }
+
+    return (consumed < fwd->recordsPerSector) ? consumed : fwd->recordsPerSector;
+}
+
+/*!
+ * \brief Timestamp after the records before an index
+ * \param index
+ *      Number of records to apply to the time base
+ */
+static uint32_t timeAt(const OregonTHN128Forward_t *fwd, uint16_t sector, uint32_t tBase,
+                       uint16_t index)
+{
+    uint32_t rawData;
+    uint16_t dt;
+    uint16_t i;
+
+    for (i = 0; i < index; i++) {
+        dt = readRecord(fwd, sector, i, &rawData);
+        if (!(dt & DT_UNCOMMITTED)) {
+            tBase += dt;
+        }
+    }
+
+    return tBase;
+}
+
+/*!
+ * \brief Number of committed records of a sector in an index range
+ */
+static uint32_t committedRecords(const OregonTHN128Forward_t *fwd, uint16_t sector,
+                                 uint16_t begin, uint16_t end)
+{
+    uint32_t rawData;
+    uint32_t count = 0;
+
+    for (; begin < end; begin++) {
+        if (!(readRecord(fwd, sector, begin, &rawData) & DT_UNCOMMITTED)) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/*!
+ * \brief Find the sector following a sequence number
+ * \return
+ *      Sector with the lowest sequence number above seq, SECTOR_NONE if there is none
+ */
+static uint16_t nextSector(const OregonTHN128Forward_t *fwd, uint32_t seq, Header_t *next)
+{
+    Header_t header;
+    uint16_t found = SECTOR_NONE;
+    uint16_t sector;
+
+    for (sector = 0; sector < fwd->storage->numSectors; sector++) {
+        if (readHeader(fwd, sector, &header) && (header.seq > seq) &&
+            ((found == SECTOR_NONE) || (header.seq < next->seq))) {
+            found = sector;
+            *next = header;
+        }
+    }
+
+    return found;
+}
+
+/*!
+ * \brief Cache the sector following the tail sector
+ * \details
+ *      Reads all sector headers, called at mount and when the tail moves to the next sector.
+ */
+static void cacheNext(OregonTHN128Forward_t *fwd)
+{
+    Header_t header;
+
+    fwd->next = SECTOR_NONE;
+    if (fwd->tail != fwd->head) {
+        fwd->next = nextSector(fwd, fwd->tailSeq, &header);
+    }
+    if (fwd->next != SECTOR_NONE) {
+        fwd->nextSeq = header.seq;
+        fwd->tNext = header.tBase;
+    }
+}
+
+/*!
+ * \brief Move the tail to the next sector when the tail sector is consumed
+ * \details
+ *      Records are only acknowledged in the tail sector, so the next sector has no consumed
+ *      records and the tail timestamp starts at its time base.
+ * \param used
+ *      Number of written records of the tail sector
+ * \return
+ *      Number of written records of the new tail sector
+ */
+static uint16_t advanceTail(OregonTHN128Forward_t *fwd, uint16_t used)
+{
+    while ((fwd->tail != fwd->head) && (fwd->tailIndex >= used) && (fwd->next != SECTOR_NONE)) {
+        fwd->tail = fwd->next;
+        fwd->tailSeq = fwd->nextSeq;
+        fwd->tailIndex = 0;
+        fwd->tTail = fwd->tNext;
+        cacheNext(fwd);
+        used = (fwd->tail == fwd->head) ? fwd->headIndex : usedRecords(fwd, fwd->tail);
+        fwd->tailUsed = used;
+    }
+
+    return used;
+}
+
+/*!
+ * \brief Clear the acknowledge bits of records
+ * \param begin
+ *      First record to acknowledge, all records before are acknowledged
+ * \param end
+ *      Record after the last record to acknowledge
+ */
+static bool acknowledge(const OregonTHN128Forward_t *fwd, uint16_t sector, uint16_t begin,
+                        uint16_t end)
+{
+    uint8_t buf[16];
+    uint32_t addr;
+    uint16_t first = begin / 8;
+    uint16_t last = (uint16_t)((end - 1) / 8);
+    uint16_t len;
+    uint16_t i;
+    uint16_t bit;
+
+    while ((begin < end) && (first <= last)) {
+        len = (uint16_t)(last - first + 1);
+        if (len > sizeof(buf)) {
+            len = sizeof(buf);
+        }
+        for (i = 0; i < len; i++) {
+            /* Clear all bits below end, bits below begin are already cleared */
+            bit = (uint16_t)(end - (first + i) * 8);
+            buf[i] = (bit >= 8) ? 0x00 : (uint8_t)(0xff << bit);
+        }
+        addr = sectorAddr(fwd, sector) + HEADER_SIZE + first;
+        if (!fwd->storage->write(fwd->storage->ctx, addr, buf, len)) {
+            return false;
+        }
+        first = (uint16_t)(first + len);
+    }
+
+    return true;
+}
+
+/*!
+ * \brief Start a new head sector
+ * \details
+ *      Selects the free sector with the lowest erase count. When there is no free sector, the
+ *      oldest sector is reused and its pending records are dropped.
+ */
+static bool startSector(OregonTHN128Forward_t *fwd, uint32_t timestamp)
+{
+    const OregonTHN128Storage_t *storage = fwd->storage;
+    Header_t header;
+    uint8_t buf[HEADER_SIZE];
+    uint32_t erases = 0;
+    uint32_t count;
+    uint16_t found = SECTOR_NONE;
+    uint16_t sector;
+    uint16_t used;
+
+    for (sector = 0; sector < storage->numSectors; sector++) {
+        if (sector == fwd->head) {
+            continue;
+        }
+        if (readHeader(fwd, sector, &header) && (fwd->pending != 0) &&
+            (header.seq >= fwd->tailSeq)) {
+            continue;
+        }
+        if ((found == SECTOR_NONE) || (eraseCount(&header) < erases)) {
+            found = sector;
+            erases = eraseCount(&header);
+        }
+    }
+
+    if (found == SECTOR_NONE) {
+        /* Full: reuse the oldest sector */
+        found = fwd->tail;
+        readHeader(fwd, found, &header);
+        erases = eraseCount(&header);
+        used = fwd->tailUsed;
+        count = committedRecords(fwd, found, fwd->tailIndex, used);
+        if (!storage->erase(storage->ctx, sectorAddr(fwd, found))) {
+            return false;
+        }
+
+        /* Drop its pending records */
+        fwd->dropped += count;
+        fwd->pending -= count;
+        fwd->tailIndex = used;
+        advanceTail(fwd, used);
+    } else if (!storage->erase(storage->ctx, sectorAddr(fwd, found))) {
+        return false;
+    }
+
+    /* Write the magic last: an incomplete header is invalid */
+    putLe32(&buf[4], fwd->headSeq + 1);
+    putLe32(&buf[8], erases + 1);
+    putLe32(&buf[12], ~(erases + 1));
+    putLe32(&buf[16], timestamp);
+    if (!storage->write(storage->ctx, sectorAddr(fwd, found) + 4, &buf[4], HEADER_SIZE - 4)) {
+        return false;
+    }
+    putLe32(&buf[0], OREGON_THN128_FORWARD_MAGIC);
+    if (!storage->write(storage->ctx, sectorAddr(fwd, found), &buf[0], 4)) {
+        return false;
+    }
+
+    /* The previous head is complete */
+    if (fwd->tail == fwd->head) {
+        fwd->tailUsed = fwd->headIndex;
+    }
+    fwd->head = found;
+    fwd->headSeq++;
+    fwd->headIndex = 0;
+    fwd->tHead = timestamp;
+
+    if (fwd->pending == 0) {
+        fwd->tail = fwd->head;
+        fwd->tailSeq = fwd->headSeq;
+        fwd->tailIndex = 0;
+        fwd->tTail = timestamp;
+        fwd->next = SECTOR_NONE;
+    } else if (fwd->next == SECTOR_NONE) {
+        /* The tail was the previous head */
+        fwd->next = fwd->head;
+        fwd->nextSeq = fwd->headSeq;
+        fwd->tNext = timestamp;
+    }
+
+    return true;
+}
+
+
+/*!
+ * \brief Read RAM storage
+ */
+static bool ramRead(void *ctx, uint32_t addr, void *buf, size_t len)
+{
+    memcpy(buf, &((OregonTHN128RamStorage_t *)ctx)->memory[addr], len);
+
+    return true;
+}
+
+/*!
+ * \brief Program RAM storage: bits can only be cleared
+ */
+static bool ramWrite(void *ctx, uint32_t addr, const void *buf, size_t len)
+{
+    OregonTHN128RamStorage_t *ram = (OregonTHN128RamStorage_t *)ctx;
+    const uint8_t *data = (const uint8_t *)buf;
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        if (data[i] & (uint8_t)~ram->memory[addr + i]) {
+            ram->violations++;
+        }
+        ram->memory[addr + i] &= data[i];
+    }
+    ram->writes++;
+
+    return true;
+}
+
+/*!
+ * \brief Erase a sector of RAM storage
+ */
+static bool ramErase(void *ctx, uint32_t addr)
+{
+    OregonTHN128RamStorage_t *ram = (OregonTHN128RamStorage_t *)ctx;
+
+    memset(&ram->memory[addr], 0xff, ram->sectorSize);
+    ram->erases++;
+
+    return true;
+}
+
+/*!
+ * \brief Initialize a RAM storage backend
+ * \param storage
+ *      Storage to initialize
+ * \param ram
+ *      RAM backend context
+ * \param memory
+ *      Buffer of sectorSize * numSectors Bytes, erased by this function
+ * \param sectorSize
+ *      Sector size in Bytes
+ * \param numSectors
+ *      Number of sectors
+ */
+void OregonTHN128_StorageRamInit(OregonTHN128Storage_t *storage, OregonTHN128RamStorage_t *ram,
+                                 uint8_t *memory, uint32_t sectorSize, uint16_t numSectors)
+{
+    memset(ram, 0, sizeof(*ram));
+    ram->memory = memory;
+    ram->sectorSize = sectorSize;
+    memset(memory, 0xff, (size_t)sectorSize * numSectors);
+
+    storage->sectorSize = sectorSize;
+    storage->numSectors = numSectors;
+    storage->read = ramRead;
+    storage->write = ramWrite;
+    storage->erase = ramErase;
+    storage->ctx = ram;
+}
+
+/*!
+ * \brief Mount a store-and-forward buffer
+ * \details
+ *      Scans the sectors to find the last written record and the oldest pending record. Erased
+ *      storage is an empty buffer.
+ * \param fwd
+ *      Store-and-forward buffer
+ * \param storage
+ *      Storage, must stay valid while the buffer is used
+ * \return
+ *      true: Success, false: invalid storage geometry
+ */
+bool OregonTHN128_ForwardBegin(OregonTHN128Forward_t *fwd, const OregonTHN128Storage_t *storage)
+{
+    Header_t header;
+    uint32_t recordsPerSector;
+    uint32_t mapBytes;
+    uint32_t headBase = 0;
+    uint32_t tailBase = 0;
+    uint32_t count;
+    uint16_t sector;
+    uint16_t used;
+    uint16_t consumed;
+
+    memset(fwd, 0, sizeof(*fwd));
+    fwd->head = SECTOR_NONE;
+    fwd->tail = SECTOR_NONE;
+    fwd->next = SECTOR_NONE;
+
+    if ((storage->sectorSize < 64) || (storage->sectorSize > 65536UL) ||
+        (storage->numSectors < 2) || (storage->numSectors == SECTOR_NONE)) {
+        return false;
+    }
+    fwd->storage = storage;
+
+    /* One acknowledge bit and RECORD_SIZE Bytes per record */
+    recordsPerSector = ((storage->sectorSize - HEADER_SIZE) * 8) / (RECORD_SIZE * 8 + 1);
+    for (;;) {
+        mapBytes = (((recordsPerSector + 7) / 8) + 3) & ~3UL;
+        if ((HEADER_SIZE + mapBytes + recordsPerSector * RECORD_SIZE) <= storage->sectorSize) {
+            break;
+        }
+        recordsPerSector--;
+    }
+    fwd->recordsPerSector = (uint16_t)recordsPerSector;
+    fwd->recordsOffset = (uint16_t)(HEADER_SIZE + mapBytes);
+
+    for (sector = 0; sector < storage->numSectors; sector++) {
+        if (!readHeader(fwd, sector, &header)) {
+            continue;
+        }
+        used = usedRecords(fwd, sector);
+        consumed = consumedRecords(fwd, sector);
+        if (consumed > used) {
+            consumed = used;
+        }
+        count = committedRecords(fwd, sector, consumed, used);
+        fwd->pending += count;
+
+        if ((fwd->head == SECTOR_NONE) || (header.seq > fwd->headSeq)) {
+            fwd->head = sector;
+            fwd->headSeq = header.seq;
+            fwd->headIndex = used;
+            headBase = header.tBase;
+        }
+        if (count && ((fwd->tail == SECTOR_NONE) || (header.seq < fwd->tailSeq))) {
+            fwd->tail = sector;
+            fwd->tailSeq = header.seq;
+            fwd->tailIndex = consumed;
+            fwd->tailUsed = used;
+            tailBase = header.tBase;
+        }
+    }
+
+    if (fwd->head == SECTOR_NONE) {
+        return true;
+    }
+    fwd->tHead = timeAt(fwd, fwd->head, headBase, fwd->headIndex);
+
+    /* Nothing pending: records after the consumed records of the head were not committed */
+    if (fwd->tail == SECTOR_NONE) {
+        fwd->tail = fwd->head;
+        fwd->tailSeq = fwd->headSeq;
+        fwd->tailIndex = consumedRecords(fwd, fwd->head);
+        tailBase = headBase;
+    }
+    fwd->tTail = timeAt(fwd, fwd->tail, tailBase, fwd->tailIndex);
+    cacheNext(fwd);
+
+    return true;
+}
+
+/*!
+ * \brief Append a record
+ * \details
+ *      When all sectors contain pending records, the oldest sector is reused and its pending
+ *      records are dropped.
+ * \param fwd
+ *      Store-and-forward buffer
+ * \param timestamp
+ *      Timestamp, for example seconds since epoch
+ * \param rawData
+ *      Raw data
+ * \return
+ *      true: Success, false: storage error
+ */
+bool OregonTHN128_ForwardAppend(OregonTHN128Forward_t *fwd, uint32_t timestamp, uint32_t rawData)
+{
+    const OregonTHN128Storage_t *storage = fwd->storage;
+    uint8_t buf[RECORD_SIZE];
+    uint32_t addr;
+    uint32_t dt;
+
+    if (storage == NULL) {
+        return false;
+    }
+
+    if ((fwd->head == SECTOR_NONE) || (fwd->headIndex >= fwd->recordsPerSector) ||
+        (timestamp < fwd->tHead) || ((timestamp - fwd->tHead) > DT_MAX)) {
+        if (!startSector(fwd, timestamp)) {
+            return false;
+        }
+    }
+
+    dt = timestamp - fwd->tHead;
+    putLe32(buf, rawData);
+    buf[4] = (uint8_t)dt;
+    buf[5] = (uint8_t)((dt | DT_UNCOMMITTED) >> 8);
+    addr = sectorAddr(fwd, fwd->head) + fwd->recordsOffset +
+           (uint32_t)fwd->headIndex * RECORD_SIZE;
+
+    /* A record is used even when a write fails */
+    fwd->headIndex++;
+    if (!storage->write(storage->ctx, addr, buf, RECORD_SIZE)) {
+        return false;
+    }
+
+    /* Commit */
+    buf[5] = (uint8_t)(dt >> 8);
+    if (!storage->write(storage->ctx, addr + 5, &buf[5], 1)) {
+        return false;
+    }
+
+    fwd->tHead = timestamp;
+    fwd->pending++;
+    fwd->appended++;
+
+    return true;
+}
+
+/*!
+ * \brief Get the oldest pending records without consuming them
+ * \param fwd
+ *      Store-and-forward buffer
+ * \param records
+ *      Records, oldest first
+ * \param maxRecords
+ *      Maximum number of records
+ * \return
+ *      Number of records
+ */
+size_t OregonTHN128_ForwardPeek(OregonTHN128Forward_t *fwd, OregonTHN128ForwardRecord_t *records,
+                                size_t maxRecords)
+{
+    Header_t header;
+    uint32_t rawData;
+    uint32_t t = fwd->tTail;
+    uint32_t seq = fwd->tailSeq;
+    uint16_t sector = fwd->tail;
+    uint16_t index = fwd->tailIndex;
+    uint16_t used;
+    uint16_t dt;
+    size_t n = 0;
+
+    if (fwd->head == SECTOR_NONE) {
+        return 0;
+    }
+
+    used = (sector == fwd->head) ? fwd->headIndex : fwd->tailUsed;
+    while ((n < maxRecords) && (n < fwd->pending)) {
+        if (index >= used) {
+            if (sector == fwd->head) {
+                break;
+            }
+            if (sector == fwd->tail) {
+                sector = fwd->next;
+                seq = fwd->nextSeq;
+                t = fwd->tNext;
+            } else {
+                /* Only a batch longer than a sector reads the headers */
+                sector = nextSector(fwd, seq, &header);
+                seq = header.seq;
+                t = header.tBase;
+            }
+            if (sector == SECTOR_NONE) {
+                break;
+            }
+            index = 0;
+            used = (sector == fwd->head) ? fwd->headIndex : usedRecords(fwd, sector);
+            continue;
+        }
+
+        dt = readRecord(fwd, sector, index++, &rawData);
+        if (!(dt & DT_UNCOMMITTED)) {
+            t += dt;
+            records[n].timestamp = t;
+            records[n].rawData = rawData;
+            n++;
+        }
+    }
+
+    return n;
+}
+
+/*!
+ * \brief Consume the oldest pending records
+ * \details
+ *      Call after the records returned by OregonTHN128_ForwardPeek() are delivered. Records
+ *      are delivered at least once: a power loss before this call returns them again.
+ * \param fwd
+ *      Store-and-forward buffer
+ * \param numRecords
+ *      Number of records
+ * \return
+ *      true: Success, false: storage error
+ */
+bool OregonTHN128_ForwardConsume(OregonTHN128Forward_t *fwd, size_t numRecords)
+{
+    uint32_t rawData;
+    uint16_t begin = fwd->tailIndex;
+    uint16_t sector;
+    uint16_t used;
+    uint16_t dt;
+    bool ok = true;
+
+    if (fwd->head == SECTOR_NONE) {
+        return numRecords == 0;
+    }
+    if (numRecords > fwd->pending) {
+        numRecords = fwd->pending;
+    }
+
+    used = (fwd->tail == fwd->head) ? fwd->headIndex : fwd->tailUsed;
+    while (numRecords) {
+        if (fwd->tailIndex >= used) {
+            if (begin < fwd->tailIndex) {
+                ok = acknowledge(fwd, fwd->tail, begin, fwd->tailIndex) && ok;
+            }
+            sector = fwd->tail;
+            used = advanceTail(fwd, used);
+            if (fwd->tail == sector) {
+                break;
+            }
+            begin = fwd->tailIndex;
+            continue;
+        }
+
+        dt = readRecord(fwd, fwd->tail, fwd->tailIndex++, &rawData);
+        if (!(dt & DT_UNCOMMITTED)) {
+            fwd->tTail += dt;
+            fwd->pending--;
+            numRecords--;
+        }
+    }
+
+    if (begin < fwd->tailIndex) {
+        ok = acknowledge(fwd, fwd->tail, begin, fwd->tailIndex) && ok;
+    }
+
+    /* A consumed sector is free */
+    advanceTail(fwd, used);
+
+    return ok;
+}
+
+/*!
+ * \brief Get the number of pending records
+ * \param fwd
+ *      Store-and-forward buffer
+ * \return
+ *      Number of records not consumed
+ */
+uint32_t OregonTHN128_ForwardPending(const OregonTHN128Forward_t *fwd)
+{
+    return fwd->pending;
+}
+
+/*!
+ * \brief Get statistics
+ * \details
+ *      Reads all sector headers for the erase counts.
+ * \param fwd
+ *      Store-and-forward buffer
+ * \param stats
+ *      Statistics
+ */
+void OregonTHN128_ForwardGetStats(OregonTHN128Forward_t *fwd, OregonTHN128ForwardStats_t *stats)
+{
+    Header_t header;
+    uint16_t sector;
+
+    memset(stats, 0, sizeof(*stats));
+    if (fwd->storage == NULL) {
+        return;
+    }
+
+    stats->pending = fwd->pending;
+    stats->capacity = (uint32_t)fwd->recordsPerSector * fwd->storage->numSectors;
+    stats->appended = fwd->appended;
+    stats->dropped = fwd->dropped;
+    stats->minEraseCount = 0xffffffffUL;
+
+    for (sector = 0; sector < fwd->storage->numSectors; sector++) {
+        readHeader(fwd, sector, &header);
+        if (eraseCount(&header) < stats->minEraseCount) {
+            stats->minEraseCount = eraseCount(&header);
+        }
+        if (eraseCount(&header) > stats->maxEraseCount) {
+            stats->maxEraseCount = eraseCount(&header);
+        }
+    }
+}
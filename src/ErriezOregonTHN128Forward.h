@@ -0,0 +1,154 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Forward.h
+ * \brief Oregon THN128 store-and-forward buffer in flash
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      Keeps received frames in a circular log while the network is down and returns them in
+ *      batches, oldest first, when it is available again. The log uses erase sectors of a NOR
+ *      flash: bits are only programmed from 1 to 0 and a sector is erased as a whole.
+ *
+ *      Sector layout:
+ *      - Header: magic, sequence number, erase count and time base
+ *      - Acknowledge bit map: one bit per record, cleared when the record is consumed
+ *      - Records of 6 Bytes: 32-bit raw data and 16-bit time delta. Bit 15 of the time delta is
+ *        cleared by a second write to commit the record, so a record partially written at a
+ *        power loss is skipped.
+ *
+ *      A 4096 Byte sector holds 665 records. Sectors are written in sequence number order. A new
+ *      sector is the free sector with the lowest erase count. When all sectors contain pending
+ *      records, the oldest sector is reused and its pending records are dropped. A time delta
+ *      above 32767 or a time going backwards starts a new sector.
+ *
+ *      The buffer keeps the sector following the tail sector and running timestamps in RAM. Only
+ *      OregonTHN128_ForwardBegin() and moving the tail to the next sector read all sector headers.
+ */
+
+#ifndef ERRIEZ_OREGON_THN128_FORWARD_H_
+#define ERRIEZ_OREGON_THN128_FORWARD_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*! Sector header magic "OTF1" */
+#define OREGON_THN128_FORWARD_MAGIC     0x3146544fUL
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Flash storage
+ * \details
+ *      Addresses are relative to the start of the storage. write() may only clear bits,
+ *      erase() sets a sector to 0xff.
+ */
+typedef struct {
+    uint32_t sectorSize;            /*!< Erase sector size in Bytes (64..65536) */
+    uint16_t numSectors;            /*!< Number of sectors, at least 2 */
+    bool (*read)(void *ctx, uint32_t addr, void *buf, size_t len);         /*!< Read */
+    bool (*write)(void *ctx, uint32_t addr, const void *buf, size_t len);  /*!< Program */
+    bool (*erase)(void *ctx, uint32_t addr);                               /*!< Erase sector */
+    void *ctx;                      /*!< Backend context */
+} OregonTHN128Storage_t;
+
+/*!
+ * \brief RAM storage backend with flash semantics, for testing
+ */
+typedef struct {
+    uint8_t *memory;                /*!< sectorSize * numSectors Bytes */
+    uint32_t sectorSize;            /*!< Sector size in Bytes */
+    uint32_t writes;                /*!< Number of writes */
+    uint32_t erases;                /*!< Number of sector erases */
+    uint32_t violations;            /*!< Writes which would set a bit from 0 to 1 */
+} OregonTHN128RamStorage_t;
+
+/*!
+ * \brief Record returned by OregonTHN128_ForwardPeek()
+ */
+typedef struct {
+    uint32_t timestamp;             /*!< Timestamp passed to OregonTHN128_ForwardAppend() */
+    uint32_t rawData;               /*!< Raw data */
+} OregonTHN128ForwardRecord_t;
+
+/*!
+ * \brief Store-and-forward statistics
+ */
+typedef struct {
+    uint32_t pending;               /*!< Records not consumed */
+    uint32_t capacity;              /*!< Maximum number of records */
+    uint32_t appended;              /*!< Records appended since OregonTHN128_ForwardBegin() */
+    uint32_t dropped;               /*!< Pending records overwritten by new records */
+    uint32_t minEraseCount;         /*!< Lowest erase count of the sectors */
+    uint32_t maxEraseCount;         /*!< Highest erase count of the sectors */
+} OregonTHN128ForwardStats_t;
+
+/*!
+ * \brief Store-and-forward buffer
+ * \details
+ *      Fields are private to the library. Initialize with OregonTHN128_ForwardBegin().
+ */
+typedef struct {
+    const OregonTHN128Storage_t *storage; /*!< Storage */
+    uint16_t recordsPerSector;      /*!< Records per sector */
+    uint16_t recordsOffset;         /*!< Offset of the first record in a sector */
+    uint16_t head;                  /*!< Sector being written, numSectors: none */
+    uint16_t headIndex;             /*!< Next record of the head sector */
+    uint32_t headSeq;               /*!< Sequence number of the head sector */
+    uint32_t tHead;                 /*!< Timestamp of the last record of the head sector */
+    uint16_t tail;                  /*!< Sector of the oldest pending record */
+    uint16_t tailIndex;             /*!< Oldest pending record of the tail sector */
+    uint32_t tailSeq;               /*!< Sequence number of the tail sector */
+    uint32_t tTail;                 /*!< Timestamp of the record before the tail record */
+    uint16_t tailUsed;              /*!< Written records of the tail sector, not the head */
+    uint16_t next;                  /*!< Sector following the tail sector, 0xffff: none */
+    uint32_t nextSeq;               /*!< Sequence number of the next sector */
+    uint32_t tNext;                 /*!< Time base of the next sector */
+    uint32_t pending;               /*!< Committed records not consumed */
+    uint32_t appended;              /*!< Records appended */
+    uint32_t dropped;               /*!< Pending records overwritten */
+} OregonTHN128Forward_t;
+
+/* Public functions */
+void OregonTHN128_StorageRamInit(OregonTHN128Storage_t *storage, OregonTHN128RamStorage_t *ram,
+                                 uint8_t *memory, uint32_t sectorSize, uint16_t numSectors);
+
+bool OregonTHN128_ForwardBegin(OregonTHN128Forward_t *fwd, const OregonTHN128Storage_t *storage);
+bool OregonTHN128_ForwardAppend(OregonTHN128Forward_t *fwd, uint32_t timestamp, uint32_t rawData);
+size_t OregonTHN128_ForwardPeek(OregonTHN128Forward_t *fwd, OregonTHN128ForwardRecord_t *records,
+                                size_t maxRecords);
+bool OregonTHN128_ForwardConsume(OregonTHN128Forward_t *fwd, size_t numRecords);
+uint32_t OregonTHN128_ForwardPending(const OregonTHN128Forward_t *fwd);
+void OregonTHN128_ForwardGetStats(OregonTHN128Forward_t *fwd, OregonTHN128ForwardStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ERRIEZ_OREGON_THN128_FORWARD_H_ */
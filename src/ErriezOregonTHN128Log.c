@@ -0,0 +1,640 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Log.c
+ * \brief Oregon THN128 append-only binary reading log
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ */
+
+#include <string.h>
+#include "ErriezOregonTHN128Log.h"
+
+/*! Size of the encoded readings in bits */
+#define PAYLOAD_BITS        ((OREGON_THN128_LOG_BLOCK_SIZE - sizeof(OregonTHN128LogHeader_t)) * 8)
+
+/*! Maximum size of one encoded reading in bits */
+#define READING_BITS_MAX    (3 + 32 + 3 + 12)
+
+/*! Minimum and maximum temperature of the 11-bit encoding */
+#define TEMPERATURE_MIN     -1024
+#define TEMPERATURE_MAX     1023
+
+/*!
+ * \brief Bit reader of the encoded readings
+ */
+typedef struct {
+    const uint8_t *p;       /*!< Next Byte */
+    const uint8_t *end;     /*!< End of the encoded readings */
+    uint64_t bits;          /*!< Buffered bits */
+    uint8_t numBits;        /*!< Number of buffered bits */
+} BitReader_t;
+
+/*!
+ * \brief Readings being aggregated by OregonTHN128_LogStats()
+ */
+typedef struct {
+    int16_t minTemperature; /*!< Minimum temperature */
+    int16_t maxTemperature; /*!< Maximum temperature */
+    int64_t sumTemperature; /*!< Sum of the temperatures */
+    size_t count;           /*!< Number of readings */
+} Aggregate_t;
+
+/*!
+ * \brief Append bits to the block of a stream, least significant bit first
+ * \param stream
+ *      Stream
+ * \param value
+ *      Bits
+ * \param numBits
+ *      Number of bits (1..32)
+ */
+static void putBits(OregonTHN128LogStream_t *stream, uint32_t value, uint8_t numBits)
+{
+    uint8_t *payload = stream->block.data + sizeof(OregonTHN128LogHeader_t);
+    uint32_t pos = stream->bitPos;
+    uint8_t take;
+
+    if (numBits < 32) {
+        value &= (1UL << numBits) - 1;
+    }
+    stream->bitPos += numBits;
+
+    while (numBits) {
+        take = 8 - (pos & 7);
+        if (take > numBits) {
+            take = numBits;
+        }
+        payload[pos >> 3] |= (uint8_t)(value << (pos & 7));
+        value >>= take;
+        numBits -= take;
+        pos += take;
+    }
+}
+
+/*!
+ * \brief Get bits, least significant bit first
+ * \param reader
+ *      Bit reader
+ * \param numBits
+ *      Number of bits (1..32)
+ * \return
+ *      Bits, 0 beyond the end of the encoded readings
+ */
+static uint32_t getBits(BitReader_t *reader, uint8_t numBits)
+{
+    uint32_t value;
+
+    /* Refill per Byte: never reads beyond the block */
+    while ((reader->numBits <= 56) && (reader->p < reader->end)) {
+        reader->bits |= (uint64_t)*reader->p++ << reader->numBits;
+        reader->numBits += 8;
+    }
+
+    value = (uint32_t)(reader->bits & ((1ULL << numBits) - 1));
+    reader->bits >>= numBits;
+    reader->numBits = (reader->numBits > numBits) ? (reader->numBits - numBits) : 0;
+
+    return value;
+}
+
+/*!
+ * \brief Get signed bits
+ */
+static int32_t getSigned(BitReader_t *reader, uint8_t numBits)
+{
+    uint32_t value = getBits(reader, numBits);
+
+    return (int32_t)(value ^ (1UL << (numBits - 1))) - (int32_t)(1UL << (numBits - 1));
+}
+
+/*!
+ * \brief Get prefix code 0, 10, 110 or 111
+ * \return
+ *      0..3
+ */
+static uint8_t getPrefix(BitReader_t *reader)
+{
+    uint8_t code = 0;
+
+    while ((code < 3) && getBits(reader, 1)) {
+        code++;
+    }
+
+    return code;
+}
+
+/*!
+ * \brief Write the block of a stream and start a new block
+ * \param writer
+ *      Log writer
+ * \param stream
+ *      Stream with at least one reading
+ * \return
+ *      true: Success, false: write error
+ */
+static bool writeBlock(OregonTHN128LogWriter_t *writer, OregonTHN128LogStream_t *stream)
+{
+    uint16_t bytes = (uint16_t)((stream->bitPos + 7) / 8);
+    size_t len = sizeof(OregonTHN128LogHeader_t) + ((bytes + 3UL) & ~3UL);
+
+    bool ok;
+
+    stream->block.header.bytes = bytes;
+    ok = writer->write(stream->block.data, len, writer->arg);
+    writer->blocks++;
+    writer->bytes += (uint32_t)len;
+
+    /* The next reading starts a new block */
+    stream->block.header.count = 0;
+
+    return ok;
+}
+
+/*!
+ * \brief Aggregate a reading
+ */
+static void aggregate(uint32_t timestamp, int16_t temperature, uint8_t flags, void *arg)
+{
+    Aggregate_t *agg = (Aggregate_t *)arg;
+
+    (void)timestamp;
+    (void)flags;
+
+    if (temperature < agg->minTemperature) {
+        agg->minTemperature = temperature;
+    }
+    if (temperature > agg->maxTemperature) {
+        agg->maxTemperature = temperature;
+    }
+    agg->sumTemperature += temperature;
+    agg->count++;
+}
+
+/*!
+ * \brief Decode the readings of a block in a time range
+ * \param header
+ *      Block
+ * \param tBegin
+ *      First timestamp
+ * \param tEnd
+ *      End timestamp, not included
+ * \param callback
+ *      Called for each reading in the range
+ * \param arg
+ *      Callback argument
+ * \return
+ *      Number of readings in the range
+ */
+static size_t decodeBlock(const OregonTHN128LogHeader_t *header, uint32_t tBegin, uint32_t tEnd,
+                          OregonTHN128LogCallback_t callback, void *arg)
+{
+    const uint8_t *payload = (const uint8_t *)header + sizeof(OregonTHN128LogHeader_t);
+    BitReader_t reader = { payload, payload + header->bytes, 0, 0 };
+    uint32_t timestamp = header->tFirst;
+    int32_t temperature = header->firstTemperature;
+    uint8_t flags = header->flags;
+    uint32_t dt = 0;
+    size_t n = 0;
+
+    for (uint16_t i = 0; i < header->count; i++) {
+        if (i) {
+            switch (getPrefix(&reader)) {
+                case 0: break;
+                case 1: dt += (uint32_t)getSigned(&reader, 3); break;
+                case 2: dt += (uint32_t)getSigned(&reader, 12); break;
+                default: dt = getBits(&reader, 32); break;
+            }
+            timestamp += dt;
+
+            switch (getPrefix(&reader)) {
+                case 0: break;
+                case 1: temperature += getSigned(&reader, 3); break;
+                case 2: temperature += getSigned(&reader, 6); break;
+                default:
+                    temperature = getSigned(&reader, 11);
+                    flags = getBits(&reader, 1) ? OREGON_THN128_FLAG_LOW_BATTERY : 0;
+                    break;
+            }
+        }
+
+        if (timestamp >= tEnd) {
+            break;
+        }
+        if (timestamp >= tBegin) {
+            callback(timestamp, (int16_t)temperature, flags, arg);
+            n++;
+        }
+    }
+
+    return n;
+}
+
+/*!
+ * \brief Find the first block of a sensor which ends at or after a timestamp
+ * \return
+ *      Block index, first block of the next sensor when not found
+ */
+static size_t lowerBound(const OregonTHN128LogReader_t *reader, uint16_t sensor, uint32_t tBegin)
+{
+    size_t first = reader->first[sensor];
+    size_t count = reader->first[sensor + 1] - first;
+
+    /* Blocks of one sensor are in time order */
+    while (count > 0) {
+        size_t half = count / 2;
+
+        if (reader->blocks[first + half]->tLast < tBegin) {
+            first += half + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+
+    return first;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                     Public functions                                           */
+/*------------------------------------------------------------------------------------------------*/
+/*!
+ * \brief Initialize log writer
+ * \param writer
+ *      Log writer
+ * \param streams
+ *      Array of numSensors streams, one block buffer per sensor number
+ * \param numSensors
+ *      Number of sensor numbers, for example OREGON_THN128_SENSOR_KEYS per receiver
+ * \param write
+ *      Append function, called with complete blocks
+ * \param arg
+ *      Write function argument
+ */
+void OregonTHN128_LogWriterInit(OregonTHN128LogWriter_t *writer, OregonTHN128LogStream_t *streams,
+                                uint16_t numSensors, OregonTHN128LogWrite_t write, void *arg)
+{
+    memset(streams, 0, numSensors * sizeof(OregonTHN128LogStream_t));
+
+    writer->streams = streams;
+    writer->numSensors = numSensors;
+    writer->write = write;
+    writer->arg = arg;
+    writer->blocks = 0;
+    writer->bytes = 0;
+}
+
+/*!
+ * \brief Append reading
+ * \details
+ *      Full blocks are written immediately, partial blocks by OregonTHN128_LogFlush().
+ * \param writer
+ *      Log writer
+ * \param sensor
+ *      Sensor number 0..numSensors-1, for example OREGON_THN128_SENSOR()
+ * \param timestamp
+ *      Receive time in application units, for example seconds. Must be equal or later than the
+ *      previous reading of the sensor.
+ * \param data
+ *      Decoded frame, see OregonTHN128_RawToData()
+ * \return
+ *      true: Success, false: invalid sensor, timestamp or temperature, or write error
+ */
+bool OregonTHN128_LogAppend(OregonTHN128LogWriter_t *writer, uint16_t sensor, uint32_t timestamp,
+                            const OregonTHN128Data_t *data)
+{
+    OregonTHN128LogStream_t *stream;
+    OregonTHN128LogHeader_t *header;
+    uint8_t flags = data->lowBattery ? OREGON_THN128_FLAG_LOW_BATTERY : 0;
+    int16_t temperature = data->temperature;
+    int32_t dTemperature;
+    int64_t dod;
+    uint32_t dt;
+
+    if ((sensor >= writer->numSensors) || (temperature < TEMPERATURE_MIN) ||
+        (temperature > TEMPERATURE_MAX)) {
+        return false;
+    }
+    stream = &writer->streams[sensor];
+    header = &stream->block.header;
+    if (timestamp < header->tLast) {
+        return false;
+    }
+
+    /* Full block */
+    if (header->count &&
+        (((stream->bitPos + READING_BITS_MAX) > PAYLOAD_BITS) || (header->count == 0xffff))) {
+        if (!writeBlock(writer, stream)) {
+            return false;
+        }
+    }
+
+    /* First reading of a block in the header */
+    if (header->count == 0) {
+        memset(stream->block.data, 0, sizeof(stream->block.data));
+        header->magic = OREGON_THN128_LOG_MAGIC;
+        header->sensor = sensor;
+        header->count = 1;
+        header->flags = flags;
+        header->tFirst = timestamp;
+        header->tLast = timestamp;
+        header->firstTemperature = temperature;
+        header->minTemperature = temperature;
+        header->maxTemperature = temperature;
+        header->sumTemperature = temperature;
+        stream->bitPos = 0;
+        stream->dtPrev = 0;
+        stream->temperaturePrev = temperature;
+        stream->flagsPrev = flags;
+        return true;
+    }
+
+    /* Delta of the time delta */
+    dt = timestamp - header->tLast;
+    dod = (int64_t)dt - stream->dtPrev;
+    if (dod == 0) {
+        putBits(stream, 0, 1);
+    } else if ((dod >= -4) && (dod <= 3)) {
+        putBits(stream, 0x01, 2);
+        putBits(stream, (uint32_t)dod, 3);
+    } else if ((dod >= -2048) && (dod <= 2047)) {
+        putBits(stream, 0x03, 3);
+        putBits(stream, (uint32_t)dod, 12);
+    } else {
+        putBits(stream, 0x07, 3);
+        putBits(stream, dt, 32);
+    }
+    stream->dtPrev = dt;
+
+    /* Delta of the temperature, a changed flag is written with the full temperature */
+    dTemperature = temperature - stream->temperaturePrev;
+    if (flags != stream->flagsPrev) {
+        dTemperature = INT16_MAX;
+    }
+    if (dTemperature == 0) {
+        putBits(stream, 0, 1);
+    } else if ((dTemperature >= -4) && (dTemperature <= 3)) {
+        putBits(stream, 0x01, 2);
+        putBits(stream, (uint32_t)dTemperature, 3);
+    } else if ((dTemperature >= -32) && (dTemperature <= 31)) {
+        putBits(stream, 0x03, 3);
+        putBits(stream, (uint32_t)dTemperature, 6);
+    } else {
+        putBits(stream, 0x07, 3);
+        putBits(stream, (uint32_t)(int32_t)temperature, 11);
+        putBits(stream, flags ? 1 : 0, 1);
+    }
+    stream->temperaturePrev = temperature;
+    stream->flagsPrev = flags;
+
+    /* Checkpoint */
+    header->count++;
+    header->tLast = timestamp;
+    if (temperature < header->minTemperature) {
+        header->minTemperature = temperature;
+    }
+    if (temperature > header->maxTemperature) {
+        header->maxTemperature = temperature;
+    }
+    header->sumTemperature += temperature;
+
+    return true;
+}
+
+/*!
+ * \brief Write all partial blocks
+ * \details
+ *      The next reading of each sensor starts a new block. Call before closing the log, not after
+ *      each reading: each block has a header of 32 Bytes.
+ * \param writer
+ *      Log writer
+ * \return
+ *      true: Success, false: write error
+ */
+bool OregonTHN128_LogFlush(OregonTHN128LogWriter_t *writer)
+{
+    bool ok = true;
+
+    for (uint16_t i = 0; i < writer->numSensors; i++) {
+        if (writer->streams[i].block.header.count) {
+            ok = writeBlock(writer, &writer->streams[i]) && ok;
+        }
+    }
+
+    return ok;
+}
+
+/*!
+ * \brief Count the valid blocks of a log
+ * \details
+ *      Stops at the first invalid block, for example a block partially written at a power loss.
+ * \param log
+ *      Log memory, 4 Byte aligned
+ * \param len
+ *      Log size in Bytes
+ * \param validLen
+ *      Output size of the valid blocks in Bytes, may be NULL
+ * \return
+ *      Number of valid blocks
+ */
+size_t OregonTHN128_LogCountBlocks(const void *log, size_t len, size_t *validLen)
+{
+    const uint8_t *p = (const uint8_t *)log;
+    const OregonTHN128LogHeader_t *header;
+    size_t offset = 0;
+    size_t numBlocks = 0;
+    size_t blockLen;
+
+    while ((len - offset) >= sizeof(OregonTHN128LogHeader_t)) {
+        header = (const OregonTHN128LogHeader_t *)(p + offset);
+        blockLen = sizeof(OregonTHN128LogHeader_t) + ((header->bytes + 3UL) & ~3UL);
+        if ((header->magic != OREGON_THN128_LOG_MAGIC) || (header->count == 0) ||
+            (blockLen > (len - offset))) {
+            break;
+        }
+        offset += blockLen;
+        numBlocks++;
+    }
+
+    if (validLen) {
+        *validLen = offset;
+    }
+
+    return numBlocks;
+}
+
+/*!
+ * \brief Initialize log reader
+ * \details
+ *      Indexes the block headers in place, the log memory must remain valid while reading. Blocks
+ *      of one sensor must be in time order, which is the case for a log written with
+ *      non-decreasing timestamps per sensor.
+ * \param reader
+ *      Log reader
+ * \param log
+ *      Log memory, 4 Byte aligned
+ * \param len
+ *      Log size in Bytes
+ * \param blocks
+ *      Array of maxBlocks block pointers, see OregonTHN128_LogCountBlocks()
+ * \param maxBlocks
+ *      Size of the blocks array
+ * \param first
+ *      Array of numSensors + 1 block indices
+ * \param numSensors
+ *      Number of sensor numbers
+ * \return
+ *      true: Success, false: blocks array too small or sensor number out of range
+ */
+bool OregonTHN128_LogReaderInit(OregonTHN128LogReader_t *reader, const void *log, size_t len,
+                                const OregonTHN128LogHeader_t **blocks, size_t maxBlocks,
+                                uint32_t *first, uint16_t numSensors)
+{
+    const uint8_t *p = (const uint8_t *)log;
+    const OregonTHN128LogHeader_t *header;
+    size_t validLen;
+    size_t numBlocks = OregonTHN128_LogCountBlocks(log, len, &validLen);
+    size_t offset;
+
+    if (numBlocks > maxBlocks) {
+        return false;
+    }
+
+    /* Blocks per sensor in first[sensor + 1] */
+    memset(first, 0, (numSensors + 1UL) * sizeof(uint32_t));
+    for (offset = 0; offset < validLen;
+         offset += sizeof(OregonTHN128LogHeader_t) + ((header->bytes + 3UL) & ~3UL)) {
+        header = (const OregonTHN128LogHeader_t *)(p + offset);
+        if (header->sensor >= numSensors) {
+            return false;
+        }
+        first[header->sensor + 1]++;
+    }
+
+    /* Start index per sensor */
+    for (uint16_t i = 0; i < numSensors; i++) {
+        first[i + 1] += first[i];
+    }
+
+    /* Place blocks in file order, first[sensor] moves to the start of the next sensor */
+    for (offset = 0; offset < validLen;
+         offset += sizeof(OregonTHN128LogHeader_t) + ((header->bytes + 3UL) & ~3UL)) {
+        header = (const OregonTHN128LogHeader_t *)(p + offset);
+        blocks[first[header->sensor]++] = header;
+    }
+    for (uint16_t i = numSensors; i > 0; i--) {
+        first[i] = first[i - 1];
+    }
+    first[0] = 0;
+
+    reader->blocks = blocks;
+    reader->first = first;
+    reader->numSensors = numSensors;
+    reader->numBlocks = numBlocks;
+
+    return true;
+}
+
+/*!
+ * \brief Calculate temperature statistics of one sensor in a time range
+ * \details
+ *      Blocks completely in the range use the checkpoint in the block header, only the blocks at
+ *      the begin and end of the range are decoded.
+ * \param reader
+ *      Log reader
+ * \param sensor
+ *      Sensor number
+ * \param tBegin
+ *      First timestamp
+ * \param tEnd
+ *      End timestamp, not included
+ * \param stats
+ *      Output statistics, minimum and maximum are INT16_MAX and INT16_MIN without readings
+ */
+void OregonTHN128_LogStats(const OregonTHN128LogReader_t *reader, uint16_t sensor,
+                           uint32_t tBegin, uint32_t tEnd, OregonTHN128StoreStats_t *stats)
+{
+    Aggregate_t agg = { INT16_MAX, INT16_MIN, 0, 0 };
+    const OregonTHN128LogHeader_t *header;
+
+    if (sensor < reader->numSensors) {
+        for (size_t i = lowerBound(reader, sensor, tBegin);
+             (i < reader->first[sensor + 1]) && (reader->blocks[i]->tFirst < tEnd); i++) {
+            header = reader->blocks[i];
+
+            if ((header->tFirst >= tBegin) && (header->tLast < tEnd)) {
+                if (header->minTemperature < agg.minTemperature) {
+                    agg.minTemperature = header->minTemperature;
+                }
+                if (header->maxTemperature > agg.maxTemperature) {
+                    agg.maxTemperature = header->maxTemperature;
+                }
+                agg.sumTemperature += header->sumTemperature;
+                agg.count += header->count;
+            } else {
+                decodeBlock(header, tBegin, tEnd, aggregate, &agg);
+            }
+        }
+    }
+
+    stats->count = agg.count;
+    stats->minTemperature = agg.minTemperature;
+    stats->maxTemperature = agg.maxTemperature;
+    stats->sumTemperature = agg.sumTemperature;
+}
+
+/*!
+ * \brief Read the readings of one sensor in a time range
+ * \param reader
+ *      Log reader
+ * \param sensor
+ *      Sensor number
+ * \param tBegin
+ *      First timestamp
+ * \param tEnd
+ *      End timestamp, not included
+ * \param callback
+ *      Called for each reading in time order
+ * \param arg
+ *      Callback argument
+ * \return
+ *      Number of readings
+ */
+size_t OregonTHN128_LogRead(const OregonTHN128LogReader_t *reader, uint16_t sensor,
+                            uint32_t tBegin, uint32_t tEnd, OregonTHN128LogCallback_t callback,
+                            void *arg)
+{
+    size_t n = 0;
+
+    if (sensor < reader->numSensors) {
+        for (size_t i = lowerBound(reader, sensor, tBegin);
+             (i < reader->first[sensor + 1]) && (reader->blocks[i]->tFirst < tEnd); i++) {
+            n += decodeBlock(reader->blocks[i], tBegin, tEnd, callback, arg);
+        }
+    }
+
+    return n;
+}
@@ -0,0 +1,176 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Log.h
+ * \brief Oregon THN128 append-only binary reading log
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      Readings are written as blocks of one sensor. Each block starts with a checkpoint header
+ *      containing the first reading and the time range, minimum, maximum and sum of the
+ *      temperatures of the block, followed by the delta encoded readings:
+ *
+ *      Time, delta of the time delta:
+ *      - 0:   unchanged
+ *      - 10:  3-bit signed change
+ *      - 110: 12-bit signed change
+ *      - 111: 32-bit time delta
+ *
+ *      Temperature, delta of the temperature:
+ *      - 0:   unchanged
+ *      - 10:  3-bit signed change
+ *      - 110: 6-bit signed change
+ *      - 111: 11-bit signed temperature and low battery flag
+ *
+ *      Readings every 30 seconds take a few bits each. Blocks are appended with a write function
+ *      provided by the application, for example to a file. The reader works in place on the
+ *      memory of the log, such as a file mapped with mmap() or a memory mapped flash partition,
+ *      and uses the block headers for random access and for statistics of complete blocks. All
+ *      fields are little endian.
+ */
+
+#ifndef ERRIEZ_OREGON_THN128_LOG_H_
+#define ERRIEZ_OREGON_THN128_LOG_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "ErriezOregonTHN128.h"
+#include "ErriezOregonTHN128Store.h"
+
+/*!
+ * \def OREGON_THN128_LOG_BLOCK_SIZE
+ * \brief Maximum block size in Bytes including the header, multiple of 4 (64..65536)
+ * \details
+ *      The writer buffers one block per sensor. Can be overruled by a compiler define.
+ */
+#ifndef OREGON_THN128_LOG_BLOCK_SIZE
+#define OREGON_THN128_LOG_BLOCK_SIZE    1024
+#endif
+
+/*! Block header magic "OTL1" */
+#define OREGON_THN128_LOG_MAGIC         0x314c544fUL
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Block header, the checkpoint of a block
+ */
+typedef struct {
+    uint32_t magic;                 /*!< OREGON_THN128_LOG_MAGIC */
+    uint16_t sensor;                /*!< Sensor number */
+    uint16_t count;                 /*!< Number of readings including the first */
+    uint16_t bytes;                 /*!< Encoded readings in Bytes after the header */
+    uint8_t flags;                  /*!< Flags of the first reading */
+    uint8_t reserved0;              /*!< Reserved, 0 */
+    uint32_t tFirst;                /*!< Timestamp of the first reading */
+    uint32_t tLast;                 /*!< Timestamp of the last reading */
+    int16_t firstTemperature;       /*!< Temperature of the first reading */
+    int16_t minTemperature;         /*!< Minimum temperature */
+    int16_t maxTemperature;         /*!< Maximum temperature */
+    uint16_t reserved1;             /*!< Reserved, 0 */
+    int32_t sumTemperature;         /*!< Sum of the temperatures */
+} OregonTHN128LogHeader_t;
+
+/*!
+ * \brief Block being written for one sensor
+ * \details
+ *      Fields are private to the library.
+ */
+typedef struct {
+    union {
+        OregonTHN128LogHeader_t header; /*!< Block header */
+        uint8_t data[OREGON_THN128_LOG_BLOCK_SIZE]; /*!< Header and encoded readings */
+    } block;                        /*!< Block */
+    uint32_t bitPos;                /*!< Encoded bits after the header */
+    uint32_t dtPrev;                /*!< Previous time delta */
+    int16_t temperaturePrev;        /*!< Previous temperature */
+    uint8_t flagsPrev;              /*!< Previous flags */
+} OregonTHN128LogStream_t;
+
+/*!
+ * \brief Append data to the log
+ * \return
+ *      true: Success, false: write error
+ */
+typedef bool (*OregonTHN128LogWrite_t)(const void *data, size_t len, void *arg);
+
+/*!
+ * \brief Log writer
+ * \details
+ *      Fields are private to the library. Initialize with OregonTHN128_LogWriterInit().
+ */
+typedef struct {
+    OregonTHN128LogStream_t *streams; /*!< One stream per sensor number */
+    uint16_t numSensors;            /*!< Number of streams */
+    OregonTHN128LogWrite_t write;   /*!< Write function */
+    void *arg;                      /*!< Write function argument */
+    uint32_t blocks;                /*!< Blocks written */
+    uint32_t bytes;                 /*!< Bytes written */
+} OregonTHN128LogWriter_t;
+
+/*!
+ * \brief Log reader
+ * \details
+ *      Fields are private to the library. Initialize with OregonTHN128_LogReaderInit().
+ */
+typedef struct {
+    const OregonTHN128LogHeader_t **blocks; /*!< Blocks ordered by sensor and time */
+    uint32_t *first;                /*!< Index of the first block per sensor, numSensors + 1 */
+    uint16_t numSensors;            /*!< Number of sensor numbers */
+    size_t numBlocks;               /*!< Number of blocks */
+} OregonTHN128LogReader_t;
+
+/*!
+ * \brief Called for each reading by OregonTHN128_LogRead()
+ */
+typedef void (*OregonTHN128LogCallback_t)(uint32_t timestamp, int16_t temperature, uint8_t flags,
+                                          void *arg);
+
+/* Public functions */
+void OregonTHN128_LogWriterInit(OregonTHN128LogWriter_t *writer, OregonTHN128LogStream_t *streams,
+                                uint16_t numSensors, OregonTHN128LogWrite_t write, void *arg);
+bool OregonTHN128_LogAppend(OregonTHN128LogWriter_t *writer, uint16_t sensor, uint32_t timestamp,
+                            const OregonTHN128Data_t *data);
+bool OregonTHN128_LogFlush(OregonTHN128LogWriter_t *writer);
+
+size_t OregonTHN128_LogCountBlocks(const void *log, size_t len, size_t *validLen);
+bool OregonTHN128_LogReaderInit(OregonTHN128LogReader_t *reader, const void *log, size_t len,
+                                const OregonTHN128LogHeader_t **blocks, size_t maxBlocks,
+                                uint32_t *first, uint16_t numSensors);
+void OregonTHN128_LogStats(const OregonTHN128LogReader_t *reader, uint16_t sensor,
+                           uint32_t tBegin, uint32_t tEnd, OregonTHN128StoreStats_t *stats);
+size_t OregonTHN128_LogRead(const OregonTHN128LogReader_t *reader, uint16_t sensor,
+                            uint32_t tBegin, uint32_t tEnd, OregonTHN128LogCallback_t callback,
+                            void *arg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ERRIEZ_OREGON_THN128_LOG_H_ */
@@ -0,0 +1,109 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Profile.c
+ * \brief Oregon THN128 interrupt handler cycle profile
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ */
+
+#include <string.h>
+#include "ErriezOregonTHN128Profile.h"
+
+/*!
+ * \brief Clear profile
+ * \param profile
+ *      Interrupt handler profile
+ */
+void OregonTHN128_ProfileReset(OregonTHN128IsrProfile_t *profile)
+{
+    memset(profile, 0, sizeof(OregonTHN128IsrProfile_t));
+    profile->minCycles = UINT32_MAX;
+}
+
+/*!
+ * \brief Add one interrupt
+ * \details
+ *      Called from the interrupt handler after the cycle count is taken, so the bookkeeping is
+ *      not part of the measurement.
+ * \param profile
+ *      Interrupt handler profile
+ * \param cycles
+ *      Duration of the interrupt in CPU cycles
+ * \param path
+ *      Path through the interrupt handler, OregonTHN128IsrPath_t
+ */
+void IRAM_ATTR OregonTHN128_ProfileAdd(OregonTHN128IsrProfile_t *profile, uint32_t cycles,
+                                       uint8_t path)
+{
+    uint32_t c = cycles;
+    uint8_t bin = 0;
+
+    profile->count++;
+    profile->totalCycles += cycles;
+
+    if (cycles < profile->minCycles) {
+        profile->minCycles = cycles;
+    }
+    if (cycles > profile->maxCycles) {
+        profile->maxCycles = cycles;
+        profile->maxPath = path;
+    }
+
+    profile->pathCount[path]++;
+    if (cycles > profile->pathMaxCycles[path]) {
+        profile->pathMaxCycles[path] = cycles;
+    }
+
+    /* Bin floor(log2(cycles)) */
+    while ((c >>= 1) && (bin < (OREGON_THN128_PROFILE_BINS - 1))) {
+        bin++;
+    }
+    profile->histogram[bin]++;
+}
+
+/*!
+ * \brief Calculate share of CPU time spent in the interrupt handler
+ * \param profile
+ *      Interrupt handler profile
+ * \param elapsedUs
+ *      Time since the profile was reset in us
+ * \param cyclesPerUs
+ *      CPU cycles per us
+ */
+void OregonTHN128_ProfileLoad(OregonTHN128IsrProfile_t *profile, uint32_t elapsedUs,
+                              uint32_t cyclesPerUs)
+{
+    uint64_t elapsedCycles = (uint64_t)elapsedUs * cyclesPerUs;
+    uint64_t load = 10000;
+
+    if (profile->totalCycles < elapsedCycles) {
+        load = (profile->totalCycles * 10000) / elapsedCycles;
+    }
+
+    profile->elapsedUs = elapsedUs;
+    profile->load = (uint16_t)load;
+}
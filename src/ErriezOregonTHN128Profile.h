@@ -0,0 +1,97 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Profile.h
+ * \brief Oregon THN128 interrupt handler cycle profile
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      Collects the cycle count of each receive interrupt: minimum, maximum, a log2 histogram,
+ *      the path through the decoder of the slowest interrupt and the share of CPU time. The
+ *      receiver records it when OREGON_THN128_RX_PROFILE is set (see
+ *      ErriezOregonTHN128Receive.h), the host benchmark records it for the decoder with the CPU
+ *      time stamp counter.
+ */
+
+#ifndef ERRIEZ_OREGON_THN128_PROFILE_H_
+#define ERRIEZ_OREGON_THN128_PROFILE_H_
+
+#include <stdint.h>
+#include "ErriezOregonTHN128.h"
+
+/*!
+ * \def OREGON_THN128_PROFILE_BINS
+ * \brief Number of histogram bins
+ * \details
+ *      Bin i counts interrupts of 2^i .. 2^(i+1)-1 cycles, the last bin all longer interrupts.
+ *      Can be overruled by a compiler define.
+ */
+#ifndef OREGON_THN128_PROFILE_BINS
+#define OREGON_THN128_PROFILE_BINS      16
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Path through the receive interrupt handler
+ */
+typedef enum {
+    OregonTHN128IsrPathGlitch = 0,  /*!< Short glitch ignored */
+    OregonTHN128IsrPathSearch = 1,  /*!< Preamble or sync search */
+    OregonTHN128IsrPathBit = 2,     /*!< Data bit of a frame */
+    OregonTHN128IsrPathFrame = 3,   /*!< Last bit, checksum and queue push */
+    OregonTHN128IsrPaths = 4        /*!< Number of paths */
+} OregonTHN128IsrPath_t;
+
+/*!
+ * \brief Interrupt handler cycle profile
+ */
+typedef struct {
+    uint32_t count;                 /*!< Number of interrupts */
+    uint32_t minCycles;             /*!< Fastest interrupt */
+    uint32_t maxCycles;             /*!< Slowest interrupt */
+    uint8_t maxPath;                /*!< Path of the slowest interrupt, OregonTHN128IsrPath_t */
+    uint32_t pathCount[OregonTHN128IsrPaths];     /*!< Interrupts per path */
+    uint32_t pathMaxCycles[OregonTHN128IsrPaths]; /*!< Slowest interrupt per path */
+    uint64_t totalCycles;           /*!< Sum of all interrupts */
+    uint32_t histogram[OREGON_THN128_PROFILE_BINS]; /*!< Interrupts per log2 cycle bin */
+    uint32_t elapsedUs;             /*!< Measurement time, set by OregonTHN128_ProfileLoad() */
+    uint16_t load;                  /*!< Share of CPU time in 0.01%, see elapsedUs */
+} OregonTHN128IsrProfile_t;
+
+/* Public functions */
+void OregonTHN128_ProfileReset(OregonTHN128IsrProfile_t *profile);
+void OregonTHN128_ProfileAdd(OregonTHN128IsrProfile_t *profile, uint32_t cycles, uint8_t path);
+void OregonTHN128_ProfileLoad(OregonTHN128IsrProfile_t *profile, uint32_t elapsedUs,
+                              uint32_t cyclesPerUs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ERRIEZ_OREGON_THN128_PROFILE_H_ */
@@ -38,141 +38,221 @@
 
 #include "ErriezOregonTHN128Receive.h"
 
-/*!
- * \brief Receive state
- */
-typedef enum {
-    StateSearchSync = 0,    /*!< Search for sync */
-    StateMid0 = 1,          /*!< Sample at the middle of a pulse part 1 */
-    StateMid1 = 2,          /*!< Sample at the middle of a pulse part 2 */
-    StateEnd = 3,           /*!< Sample at the end of a pulse to store bit */
-    StateRxComplete = 4     /*!< Receive complete */
-} RxState_t;
+/* Check receive queue size */
+#if (OREGON_THN128_RX_QUEUE_SIZE < 2) || (OREGON_THN128_RX_QUEUE_SIZE > 128) || \
+    ((OREGON_THN128_RX_QUEUE_SIZE & (OREGON_THN128_RX_QUEUE_SIZE - 1)) != 0)
+#error "OREGON_THN128_RX_QUEUE_SIZE must be a power of 2 between 2 and 128"
+#endif
+
+/* Check number of receivers */
+#if (OREGON_THN128_RX_MAX_INSTANCES < 1) || (OREGON_THN128_RX_MAX_INSTANCES > 4)
+#error "OREGON_THN128_RX_MAX_INSTANCES must be between 1 and 4"
+#endif
+
+/*! Receive queue index mask */
+#define RX_QUEUE_MASK       (OREGON_THN128_RX_QUEUE_SIZE - 1)
+
+/*! Queued frames are checked by recovery or the repeat filter before they are read */
+#define RX_QUEUE_FILTER     (OREGON_THN128_RX_DEDUP || OREGON_THN128_RX_RECOVER)
+
+/*! Receiver context not bound to an interrupt handler (zero initialized context) */
+#define RX_INSTANCE_NONE    0
 
 /* Static variables */
-static uint8_t _rxPin;
-static uint32_t _tPulseBegin;
-static uint16_t _tPinHigh;
-static uint16_t _tPinLow;
-static int8_t _rxBit;
-static volatile uint32_t _rxData;
-static volatile RxState_t _rxState = StateSearchSync;
+static OregonTHN128Rx_t _rx;
+static OregonTHN128Rx_t *_rxInstances[OREGON_THN128_RX_MAX_INSTANCES];
 
 /* Pin functions */
 #if defined(ARDUINO_ARCH_AVR)
-static uint8_t _rxPinPort;
-static uint8_t _rxPinBit;
-
 /*!
  * \def RF_RX_PIN_INIT()
  * \brief Initialize RF receive pin
- * \param rfTxPin
+ * \param rx
+ *      Receiver context
+ * \param rfRxPin
  *      RX pin to any external interrupt pin (INT0 or INT1)
  */
-#define RF_RX_PIN_INIT(rfRxPin) {                   \
-    /* Save interrupt number of the RF pin */       \
-    _rxPin = digitalPinToInterrupt(extIntPin);      \
-    /* Save pin port and bit */                     \
-    _rxPinPort = digitalPinToPort(extIntPin);       \
-    _rxPinBit = digitalPinToBitMask(extIntPin);     \
+#define RF_RX_PIN_INIT(rx, rfRxPin) {                   \
+    /* Save interrupt number of the RF pin */           \
+    (rx)->rxPin = digitalPinToInterrupt(rfRxPin);       \
+    /* Save pin port and bit */                         \
+    (rx)->rxPinPort = digitalPinToPort(rfRxPin);        \
+    (rx)->rxPinBit = digitalPinToBitMask(rfRxPin);      \
 }
 
 /*!
  * \def RF_RX_PIN_READ()
  * \brief Return RX pin state
+ * \param rx
+ *      Receiver context
  * \retval True: RF RX pin high, false: RF RX pin low
  */
-#define RF_RX_PIN_READ() (*portInputRegister(_rxPinPort) & _rxPinBit)
+#define RF_RX_PIN_READ(rx) (*portInputRegister((rx)->rxPinPort) & (rx)->rxPinBit)
 
 #elif defined(ARDUINO_ARCH_ESP8266) || defined(ARDUINO_ARCH_ESP32)
 
 /*!
  * \def RF_RX_PIN_INIT()
  * \brief Initialize RF receive pin
- * \param rfTxPin
+ * \param rx
+ *      Receiver context
+ * \param rfRxPin
  *      RX pin to any external interrupt pin (On AVR: INT0 or INT1)
  */
-#define RF_RX_PIN_INIT(rfRxPin) { _rxPin = rfRxPin; }
+#define RF_RX_PIN_INIT(rx, rfRxPin) { (rx)->rxPin = rfRxPin; }
 
 /*!
  * \def RF_RX_PIN_READ()
  * \brief Return RX pin state
+ * \param rx
+ *      Receiver context
  * \retval True: RF RX pin high, false: RF RX pin low
  */
-#define RF_RX_PIN_READ() (digitalRead(_rxPin) ? HIGH : LOW)
+#define RF_RX_PIN_READ(rx) (digitalRead((rx)->rxPin) ? HIGH : LOW)
 
 #else
 #error "May work, but not tested on this target"
 #endif
 
-/* Forward declaration */
-void rfPinChange(void);
-
-
+#if OREGON_THN128_RX_PROFILE
+#if defined(ARDUINO_ARCH_AVR)
 /*!
- * \brief Receive enable
+ * \defgroup Cycle counter
+ * \details
+ *      Timer0 (millis) counts at F_CPU / 64. An interrupt handler is shorter than one Timer0
+ *      period (1024us at 16MHz), so the 8-bit difference is sufficient.
+ * @{
+ */
+/*! Cycle counter timestamp type */
+#define PROFILE_STAMP_T             uint8_t
+/*! Read cycle counter */
+#define PROFILE_STAMP()             TCNT0
+/*! Cycles since timestamp */
+#define PROFILE_CYCLES(stamp)       ((uint32_t)(uint8_t)(TCNT0 - (stamp)) * 64)
+/*! CPU cycles per us */
+#define PROFILE_CYCLES_PER_US()     (F_CPU / 1000000UL)
+/*! @} */
+#elif defined(ARDUINO_ARCH_ESP8266) || defined(ARDUINO_ARCH_ESP32)
+#if defined(__XTENSA__)
+/*!
+ * \brief Read Xtensa CPU cycle counter
+ * \return
+ *      CCOUNT register
  */
-static void rxEnable()
+static inline uint32_t IRAM_ATTR profileCycleCount(void)
 {
-    /* Enable INTx change interrupt */
-    attachInterrupt(_rxPin, rfPinChange, CHANGE);
+    uint32_t ccount;
 
-    /* Initialize with search for sync state */
-    _rxState = StateSearchSync;
+    __asm__ __volatile__("rsr %0, ccount" : "=a"(ccount));
+
+    return ccount;
 }
+#else
+#include <esp_cpu.h>
+/*! Read RISC-V CPU cycle counter */
+#define profileCycleCount()         esp_cpu_get_cycle_count()
+#endif
+/*!
+ * \defgroup Cycle counter
+ * @{
+ */
+/*! Cycle counter timestamp type */
+#define PROFILE_STAMP_T             uint32_t
+/*! Read cycle counter */
+#define PROFILE_STAMP()             profileCycleCount()
+/*! Cycles since timestamp */
+#define PROFILE_CYCLES(stamp)       (profileCycleCount() - (stamp))
+#if defined(ARDUINO_ARCH_ESP32)
+/*! CPU cycles per us */
+#define PROFILE_CYCLES_PER_US()     getCpuFrequencyMhz()
+#else
+/*! CPU cycles per us */
+#define PROFILE_CYCLES_PER_US()     (F_CPU / 1000000UL)
+#endif
+/*! @} */
+#endif
+#endif
+
+/* Forward declaration */
+static void rfPinChange(OregonTHN128Rx_t *rx);
 
 /*!
- * \brief Receive disable
+ * \defgroup Interrupt trampolines
+ * \details
+ *      attachInterrupt() does not pass an argument to the handler, so each receiver instance gets
+ *      its own interrupt handler which forwards the pin change to the bound receiver context.
+ * @{
  */
-static void rxDisable()
-{
-    /* Disable INTx change interrupt */
-    detachInterrupt(_rxPin);
-}
+/*! Pin change receiver instance 0 */
+static void IRAM_ATTR rfPinChange0(void) { rfPinChange(_rxInstances[0]); }
+#if OREGON_THN128_RX_MAX_INSTANCES > 1
+/*! Pin change receiver instance 1 */
+static void IRAM_ATTR rfPinChange1(void) { rfPinChange(_rxInstances[1]); }
+#endif
+#if OREGON_THN128_RX_MAX_INSTANCES > 2
+/*! Pin change receiver instance 2 */
+static void IRAM_ATTR rfPinChange2(void) { rfPinChange(_rxInstances[2]); }
+#endif
+#if OREGON_THN128_RX_MAX_INSTANCES > 3
+/*! Pin change receiver instance 3 */
+static void IRAM_ATTR rfPinChange3(void) { rfPinChange(_rxInstances[3]); }
+#endif
+
+/*! Interrupt handler per receiver instance */
+static void (* const _rxIsr[OREGON_THN128_RX_MAX_INSTANCES])(void) = {
+    rfPinChange0,
+#if OREGON_THN128_RX_MAX_INSTANCES > 1
+    rfPinChange1,
+#endif
+#if OREGON_THN128_RX_MAX_INSTANCES > 2
+    rfPinChange2,
+#endif
+#if OREGON_THN128_RX_MAX_INSTANCES > 3
+    rfPinChange3,
+#endif
+};
+
+/*! @} */
+
 
 /*!
- * \brief Check is pulse duration is within range
- * \param tPulse
- *      Measured pulse length in us
- * \param tMin
- *      Minimum pulse length in us
- * \param tMax
- *      Maximum pulse length in us
- * \retval true
- *      Pulse is in range
- * \retval false
- *      Pulse not in range
+ * \brief Find the interrupt handler bound to a receiver context
+ * \details
+ *      Compares the context address only: fields of a context which is not bound, for example
+ *      on the stack before OregonTHN128Rx_Begin(), are not initialized.
+ * \param rx
+ *      Receiver context
+ * \return
+ *      Interrupt handler index, OREGON_THN128_RX_MAX_INSTANCES: not bound
  */
-static bool isPulseInRange(uint16_t tPulse, uint16_t tMin, uint16_t tMax)
+static uint8_t rxFindInstance(const OregonTHN128Rx_t *rx)
 {
-    /* Check is pulse length between min and max time */
-    if ((tPulse >= tMin) && (tPulse <= tMax)) {
-        return true;
-    } else {
-        return false;
+    uint8_t i;
+
+    for (i = 0; i < OREGON_THN128_RX_MAX_INSTANCES; i++) {
+        if (_rxInstances[i] == rx) {
+            break;
+        }
     }
+
+    return i;
 }
 
 /*!
- * \brief Find synchronisation
+ * \brief Bind receiver context to a free interrupt handler
+ * \param rx
+ *      Receiver context
  * \retval true
- *      Sync found
+ *      Success
  * \retval false
- *      Sync not found
+ *      All OREGON_THN128_RX_MAX_INSTANCES handlers in use
  */
-static bool findSync()
+static bool rxBindInstance(OregonTHN128Rx_t *rx)
 {
-    /* Read sync pulse */
-    if (isPulseInRange(_tPinHigh, T_SYNC_H_MIN, T_SYNC_H_MAX)) {
-        if (isPulseInRange(_tPinLow, T_SYNC_L_MIN_0, T_SYNC_L_MAX_0)) {
-            _rxData = 0;
-            _rxState = StateMid1;
-            _rxBit = 1;
-            return true;
-        } else if (isPulseInRange(_tPinLow, T_SYNC_L_MIN_1, T_SYNC_L_MAX_1)) {
-            _rxData = 0;
-            _rxState = StateEnd;
-            _rxBit = 0;
+    for (uint8_t i = 0; i < OREGON_THN128_RX_MAX_INSTANCES; i++) {
+        if ((_rxInstances[i] == rx) || (_rxInstances[i] == NULL)) {
+            _rxInstances[i] = rx;
+            rx->instance = i + 1;
             return true;
         }
     }
@@ -181,139 +261,591 @@ static bool findSync()
 }
 
 /*!
- * \brief Store a logical bit 1 or 0
- * \param one
- *      true: Bit 1\n
- *      false: Bit 0
+ * \brief Receive enable
+ * \param rx
+ *      Receiver context
  */
-static void storeBit(bool one)
+static void rxEnable(OregonTHN128Rx_t *rx)
 {
-    /* Store received bit */
-    if (one) {
-        _rxData |= (1UL << _rxBit);
+    /* Receive is not initialized or already running, don't abort a frame in progress */
+    if ((rx->instance == RX_INSTANCE_NONE) || rx->rxEnabled) {
+        return;
     }
 
-    /* Check if all 32 data bits are received */
-    _rxBit++;
-    if (_rxBit >= 32) {
-        if (OregonTHN128_CheckCRC(_rxData)) {
-            _rxState = StateRxComplete;
-            /* Disable receive */
-            rxDisable();
-        } else {
-            _rxState = StateSearchSync;
-        }
+#if OREGON_THN128_RX_STATS
+    /* Keep statistics over disable and enable */
+    OregonTHN128RxStats_t stats = rx->decoder.stats;
+#endif
+
+    /* Initialize with search for sync state */
+    OregonTHN128_DecoderInit(&rx->decoder);
+#if OREGON_THN128_RX_PROTOCOL_SELECT
+    OregonTHN128_DecoderSetProtocol(&rx->decoder, rx->protocol);
+#endif
+#if OREGON_THN128_RX_STATS
+    rx->decoder.stats = stats;
+#endif
+#if OREGON_THN128_RX_RECOVER && OREGON_THN128_RX_SOFT_BITS
+    /* Soft windows only with recovery, which retries the least confident bits */
+    OregonTHN128_DecoderSetSoft(&rx->decoder, rx->rxRecover);
+#endif
+
+    /* Enable INTx change interrupt */
+    attachInterrupt(rx->rxPin, _rxIsr[rx->instance - 1], CHANGE);
+    rx->rxEnabled = true;
+}
+
+/*!
+ * \brief Receive disable
+ * \param rx
+ *      Receiver context
+ */
+static void rxDisable(OregonTHN128Rx_t *rx)
+{
+    if (!rx->rxEnabled) {
+        return;
     }
+
+    /* Disable INTx change interrupt */
+    detachInterrupt(rx->rxPin);
+    rx->rxEnabled = false;
 }
 
 /*!
- * \brief Handle pulse RF receive pin
+ * \brief Push received frame into the receive queue
+ * \details
+ *      Called from the ISR only. The frame is dropped and the overrun counter incremented
+ *      when the application did not read the queue in time.
+ * \param rx
+ *      Receiver context
+ * \param rawData
+ *      32-bit raw data
+ * \param crcError
+ *      Frame has a checksum error
  */
-static void handlePulse()
+static void IRAM_ATTR rxQueuePush(OregonTHN128Rx_t *rx, uint32_t rawData, bool crcError)
 {
-    if (isPulseInRange(_tPinHigh, T_BIT_SHORT_MIN, T_BIT_SHORT_MAX)) {
-        if (_rxState == StateEnd) {
-            _rxState = StateMid0;
-            storeBit(1);
-        } else if (_rxState == StateMid1) {
-            _rxState = StateEnd;
-        } else {
-            _rxState = StateSearchSync;
-        }
-    } else if (isPulseInRange(_tPinHigh, T_BIT_LONG_MIN, T_BIT_LONG_MAX)) {
-        if (_rxState == StateMid1) {
-            _rxState = StateMid0;
-            storeBit(1);
-        } else {
-            _rxState = StateSearchSync;
+    uint8_t head = rx->rxQueueHead;
+
+    /* Check queue full */
+    if ((uint8_t)(head - rx->rxQueueTail) >= OREGON_THN128_RX_QUEUE_SIZE) {
+        rx->rxOverrunCount++;
+        return;
+    }
+
+    /* Store frame before publishing the new head to the reader */
+    rx->rxQueue[head & RX_QUEUE_MASK] = rawData;
+#if RX_QUEUE_FILTER
+    rx->rxQueueTime[head & RX_QUEUE_MASK] = millis();
+#endif
+#if OREGON_THN128_RX_RECOVER
+    rx->rxQueueCrcError[head & RX_QUEUE_MASK] = crcError;
+#if OREGON_THN128_RX_SOFT_BITS
+    if (crcError) {
+        for (uint8_t i = 0; i < OREGON_THN128_RX_SOFT_BITS; i++) {
+            rx->rxQueueSoftBits[head & RX_QUEUE_MASK][i] = rx->decoder.softBits[i];
         }
-    } else {
-        _rxState = StateSearchSync;
     }
+#endif
+#else
+    (void)crcError;
+#endif
+    rx->rxQueueHead = head + 1;
 }
 
+#if RX_QUEUE_FILTER
 /*!
- * \brief Handle space RF receive pin
+ * \brief Recover frames with checksum errors and remove repeated frames from the receive queue
+ * \details
+ *      Runs on the oldest queued frames until a frame to report is found, which is marked as
+ *      checked so recovery and the repeat filter see every frame once. Frames with a checksum
+ *      error which cannot be recovered and repeats are removed.
+ * \param rx
+ *      Receiver context
  */
-static void handleSpace()
+static void rxQueueFilter(OregonTHN128Rx_t *rx)
 {
-    /* State machine */
-    if (isPulseInRange(_tPinLow, T_BIT_SHORT_MIN, T_BIT_SHORT_MAX)) {
-        if (_rxState == StateEnd) {
-            _rxState = StateMid1;
-            storeBit(0);
-        } else if (_rxState == StateMid0) {
-            _rxState = StateEnd;
-        } else {
-            _rxState = StateSearchSync;
+    uint8_t tail = rx->rxQueueTail;
+    uint8_t index;
+#if OREGON_THN128_RX_RECOVER
+    uint32_t rawData;
+#endif
+
+    while (!rx->rxQueueChecked && (tail != rx->rxQueueHead)) {
+        index = tail & RX_QUEUE_MASK;
+
+#if OREGON_THN128_RX_RECOVER
+        if (rx->rxQueueCrcError[index]) {
+#if OREGON_THN128_RX_SOFT_BITS
+            if (!OregonTHN128_RecoverFrame(&rx->recover, rx->rxQueue[index],
+                                           (const uint8_t *)rx->rxQueueSoftBits[index],
+                                           OREGON_THN128_RX_SOFT_BITS, rx->rxQueueTime[index],
+                                           &rawData)) {
+#else
+            if (!OregonTHN128_RecoverFrame(&rx->recover, rx->rxQueue[index], NULL, 0,
+                                           rx->rxQueueTime[index], &rawData)) {
+#endif
+                /* Release failed frame to the ISR, kept for the next copy */
+                rx->rxQueueTail = ++tail;
+                continue;
+            }
+
+            /* Replace by recovered frame, the ISR does not write queued entries */
+            rx->rxQueue[index] = rawData;
+            rx->rxQueueCrcError[index] = false;
         }
-    } else if (isPulseInRange(_tPinLow, T_BIT_LONG_MIN, T_BIT_LONG_MAX)) {
-        if (_rxState == StateMid0) {
-            _rxState = StateMid1;
-            storeBit(0);
-        } else {
-            _rxState = StateSearchSync;
+#endif
+
+#if OREGON_THN128_RX_DEDUP
+        if (rx->dedup.windowMs &&
+            OregonTHN128_DedupFilter(&rx->dedup, rx->rxQueue[index], rx->rxQueueTime[index])) {
+            /* Release repeat to the ISR */
+            rx->rxQueueTail = ++tail;
+            continue;
         }
-    } else {
-        _rxState = StateSearchSync;
+#endif
+
+        rx->rxQueueChecked = true;
     }
 }
+#endif
 
 /*!
- * \brief RF pin level change
+ * \brief Decode RF pin level change
+ * \param rx
+ *      Receiver context
+ * \return
+ *      Path through the decoder, OregonTHN128IsrPath_t
  */
-void IRAM_ATTR rfPinChange(void)
+static uint8_t IRAM_ATTR rfPinDecode(OregonTHN128Rx_t *rx)
 {
     uint32_t tNow;
     uint16_t _tPulseLength;
     uint8_t rfPinHigh;
-
-    /* Return when previous completed receive is not read */
-    if (_rxState == StateRxComplete) {
-        return;
-    }
+    uint32_t rawData;
+    uint8_t path;
 
     /* Read absolute pulse time in us for sync */
     tNow = micros();
-    if (tNow > _tPulseBegin) {
-        _tPulseLength = tNow - _tPulseBegin;
+    if (tNow > rx->tPulseBegin) {
+        _tPulseLength = tNow - rx->tPulseBegin;
     } else {
-        _tPulseLength = _tPulseBegin - tNow;
+        _tPulseLength = rx->tPulseBegin - tNow;
     }
 
+#if OREGON_THN128_RX_STATS
+    rx->decoder.stats.edges++;
+#endif
+
     /* Ignore short pulses */
-    if (_tPulseLength < T_RX_TOLERANCE_US) {
-        return;
+    if (_tPulseLength < OREGON_THN128_DECODER_TOLERANCE(&rx->decoder)) {
+#if OREGON_THN128_RX_STATS
+        rx->decoder.stats.glitches++;
+#endif
+        return OregonTHN128IsrPathGlitch;
     }
-    _tPulseBegin = tNow;
+    rx->tPulseBegin = tNow;
 
     /* Get RF pin state */
-    rfPinHigh = RF_RX_PIN_READ();
+    rfPinHigh = RF_RX_PIN_READ(rx);
+    path = OREGON_THN128_DECODER_IDLE(&rx->decoder) ? OregonTHN128IsrPathSearch :
+                                                      OregonTHN128IsrPathBit;
+
+    /* Pin high: space (low) ended, pin low: pulse (high) ended */
+    if (OregonTHN128_DecodeEdge(&rx->decoder, _tPulseLength, rfPinHigh ? false : true, &rawData)) {
+        rxQueuePush(rx, rawData, false);
+        path = OregonTHN128IsrPathFrame;
+    }
+#if OREGON_THN128_RX_RECOVER
+    else if (rx->decoder.crcError) {
+        /* Recovered outside the ISR */
+        rx->decoder.crcError = false;
+        if (rx->rxRecover) {
+            rxQueuePush(rx, rx->decoder.rxData, true);
+            path = OregonTHN128IsrPathFrame;
+        }
+    }
+#endif
 
-    /* Store pulse (high) or space (low) length */
-    if (rfPinHigh) {
-        _tPinLow = _tPulseLength;
-    } else {
-        _tPinHigh = _tPulseLength;
+    return path;
+}
+
+/*!
+ * \brief RF pin level change
+ * \param rx
+ *      Receiver context
+ */
+static void IRAM_ATTR rfPinChange(OregonTHN128Rx_t *rx)
+{
+#if OREGON_THN128_RX_PROFILE
+    PROFILE_STAMP_T stamp = PROFILE_STAMP();
+    uint8_t path = rfPinDecode(rx);
+
+    /* Bookkeeping after the measurement */
+    OregonTHN128_ProfileAdd(&rx->profile, PROFILE_CYCLES(stamp), path);
+#else
+    rfPinDecode(rx);
+#endif
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                     Public functions                                           */
+/*------------------------------------------------------------------------------------------------*/
+/*!
+ * \brief Initialize receiver context and pin
+ * \details
+ *      Connect RX pin to an external interrupt pin such as INT0 (D2) or INT1 (D3). Up to
+ *      OREGON_THN128_RX_MAX_INSTANCES receivers can be used at the same time, each on its own pin.
+ *      The context must remain valid while receive is enabled. The context does not need to be
+ *      initialized: only a context which was passed to this function before is stopped first.
+ * \param rx
+ *      Receiver context
+ * \param extIntPin
+ *      External interrupt pin
+ * \retval true
+ *      Success
+ * \retval false
+ *      No free receiver instance
+ */
+bool OregonTHN128Rx_Begin(OregonTHN128Rx_t *rx, uint8_t extIntPin)
+{
+    /* Stop previous receive on this context, only a bound context has initialized fields */
+    if (rxFindInstance(rx) < OREGON_THN128_RX_MAX_INSTANCES) {
+        rxDisable(rx);
     }
 
-    /* Always search for sync */
-    if (findSync()) {
+    /* Clear context */
+    memset(rx, 0, sizeof(OregonTHN128Rx_t));
+    rx->protocol = &OregonTHN128_ProtocolTHN128;
+#if OREGON_THN128_RX_RECOVER
+    OregonTHN128_RecoverInit(&rx->recover);
+#endif
+
+    /* Assign interrupt handler */
+    if (!rxBindInstance(rx)) {
+        return false;
+    }
+
+    /* Initialize RF RX pin */
+    RF_RX_PIN_INIT(rx, extIntPin);
+
+#if OREGON_THN128_RX_PROFILE
+    OregonTHN128Rx_ResetIsrProfile(rx);
+#endif
+
+    /* Enable receive */
+    rxEnable(rx);
+
+    return true;
+}
+
+/*!
+ * \brief Stop receive and release the interrupt handler of the receiver context
+ * \details
+ *      Call before the context goes out of scope, or to start more than
+ *      OREGON_THN128_RX_MAX_INSTANCES receivers one after another. OregonTHN128Rx_Begin() can be
+ *      called again afterwards.
+ * \param rx
+ *      Receiver context
+ */
+void OregonTHN128Rx_End(OregonTHN128Rx_t *rx)
+{
+    uint8_t i = rxFindInstance(rx);
+
+    if (i == OREGON_THN128_RX_MAX_INSTANCES) {
         return;
     }
 
-    /* Handle received pulse */
-    if (_rxState != StateSearchSync) {
-        if (rfPinHigh) {
-            handleSpace();
-        } else {
-            handlePulse();
-        }
+    /* The handler is detached, so it does not run while the slot is released */
+    rxDisable(rx);
+    _rxInstances[i] = NULL;
+    rx->instance = RX_INSTANCE_NONE;
+}
+
+/*!
+ * \brief Receive enable
+ * \param rx
+ *      Receiver context
+ */
+void OregonTHN128Rx_Enable(OregonTHN128Rx_t *rx)
+{
+    /* Enable receive */
+    rxEnable(rx);
+}
+
+/*!
+ * \brief Receive disable
+ * \param rx
+ *      Receiver context
+ */
+void OregonTHN128Rx_Disable(OregonTHN128Rx_t *rx)
+{
+    /* Disable receive */
+    rxDisable(rx);
+}
+
+#if OREGON_THN128_RX_PROTOCOL_SELECT
+/*!
+ * \brief Set the protocol of the receiver
+ * \details
+ *      The receive interrupt handler is the same for all Oregon v1 sensors, only the timings,
+ *      tolerance, number of frame bits, checksum and fields differ. Call after
+ *      OregonTHN128Rx_Begin(), which selects OregonTHN128_ProtocolTHN128. A frame in progress is
+ *      aborted.
+ * \param rx
+ *      Receiver context
+ * \param protocol
+ *      Protocol, must remain valid while receive is enabled
+ */
+void OregonTHN128Rx_SetProtocol(OregonTHN128Rx_t *rx, const OregonTHN128Protocol_t *protocol)
+{
+    bool enabled = rx->rxEnabled;
+
+    /* Restart the decoder with the new protocol */
+    rxDisable(rx);
+    rx->protocol = protocol;
+#if OREGON_THN128_RX_RECOVER
+    OregonTHN128_RecoverSetProtocol(&rx->recover, protocol);
+#endif
+    if (enabled) {
+        rxEnable(rx);
+    }
+}
+#endif
+
+/*!
+ * \brief Check if data received
+ * \param rx
+ *      Receiver context
+ * \retval true
+ *      One or more frames in the receive queue
+ * \retval false
+ *      No data available
+ */
+bool OregonTHN128Rx_Available(OregonTHN128Rx_t *rx)
+{
+#if RX_QUEUE_FILTER
+    rxQueueFilter(rx);
+
+    /* Return checked frame at the tail, a frame pushed after the filter is checked next call */
+    return rx->rxQueueChecked;
+#else
+    /* Return receive queue not empty */
+    return (rx->rxQueueHead != rx->rxQueueTail) ? true : false;
+#endif
+}
+
+/*!
+ * \brief Read data
+ * \details
+ *      Removes the oldest frame from the receive queue. Repeated frames are skipped when enabled
+ *      with OregonTHN128Rx_SetDedup(), frames with checksum errors are recovered when enabled with
+ *      OregonTHN128Rx_SetRecover().
+ * \param rx
+ *      Receiver context
+ * \param data
+ *      Structure OregonTHN128Data_t output
+ * \retval true
+ *      Data received
+ * \retval false
+ *      No data available
+ */
+bool OregonTHN128Rx_Read(OregonTHN128Rx_t *rx, OregonTHN128Data_t *data)
+{
+    uint8_t tail;
+
+#if RX_QUEUE_FILTER
+    rxQueueFilter(rx);
+
+    /* Read only the frame checked by the filter, not a frame the ISR pushed after the filter */
+    if (!rx->rxQueueChecked) {
+        return false;
+    }
+    rx->rxQueueChecked = false;
+#endif
+
+    tail = rx->rxQueueTail;
+
+    if (rx->rxQueueHead == tail) {
+        return false;
     }
+
+    /* Convert raw 32-bit data to data structure */
+    rx->protocol->rawToData(rx->rxQueue[tail & RX_QUEUE_MASK], data);
+
+    /* Release queue entry to the ISR */
+    rx->rxQueueTail = tail + 1;
+
+    return true;
+}
+
+/*!
+ * \brief Get number of received frames dropped because the receive queue was full
+ * \param rx
+ *      Receiver context
+ * \return
+ *      Overrun count
+ */
+uint16_t OregonTHN128Rx_GetOverrunCount(OregonTHN128Rx_t *rx)
+{
+    uint16_t overrunCount;
+
+    /* 16-bit read is not atomic on AVR */
+    noInterrupts();
+    overrunCount = rx->rxOverrunCount;
+    interrupts();
+
+    return overrunCount;
+}
+
+#if OREGON_THN128_RX_STATS
+/*!
+ * \brief Get receive statistics
+ * \details
+ *      Counts edges, glitches, syncs, aborted frames per reason, checksum errors, received
+ *      frames and overruns since OregonTHN128Rx_Begin() or the last reset, to diagnose poor
+ *      reception.
+ * \param rx
+ *      Receiver context
+ * \param stats
+ *      Statistics output
+ */
+void OregonTHN128Rx_GetRxStats(OregonTHN128Rx_t *rx, OregonTHN128RxStats_t *stats)
+{
+    /* Consistent snapshot of the counters updated by the ISR */
+    noInterrupts();
+    *stats = rx->decoder.stats;
+    stats->overruns = rx->rxOverrunCount;
+    interrupts();
+#if OREGON_THN128_RX_RECOVER
+    stats->recovered = rx->recover.recovered;
+    stats->softRecovered = rx->recover.softRecovered;
+#endif
+}
+
+/*!
+ * \brief Clear receive statistics and overrun count
+ * \param rx
+ *      Receiver context
+ */
+void OregonTHN128Rx_ResetRxStats(OregonTHN128Rx_t *rx)
+{
+    noInterrupts();
+    memset(&rx->decoder.stats, 0, sizeof(OregonTHN128RxStats_t));
+    rx->rxOverrunCount = 0;
+    interrupts();
+#if OREGON_THN128_RX_RECOVER
+    rx->recover.recovered = 0;
+    rx->recover.softRecovered = 0;
+    rx->recover.rejected = 0;
+#endif
 }
+#endif
+
+#if OREGON_THN128_RX_DEDUP
+/*!
+ * \brief Report only the first copy of repeated frames
+ * \details
+ *      A THN128 transmits every frame twice. When enabled, OregonTHN128Rx_Available() and
+ *      OregonTHN128Rx_Read() skip frames with identical data from the same sensor received within
+ *      the window after the previous copy. Call after OregonTHN128Rx_Begin().
+ * \param rx
+ *      Receiver context
+ * \param windowMs
+ *      Repeat window in ms, for example OREGON_THN128_DEDUP_WINDOW_MS. 0: Report all frames.
+ */
+void OregonTHN128Rx_SetDedup(OregonTHN128Rx_t *rx, uint16_t windowMs)
+{
+    OregonTHN128_DedupInit(&rx->dedup, windowMs);
+    rx->rxQueueChecked = false;
+}
+
+/*!
+ * \brief Get number of repeats skipped after a frame
+ * \details
+ *      The repeat arrives T_SPACE_FRAMES_MS after the frame has been read, so the count is final
+ *      only after the repeat window set with OregonTHN128Rx_SetDedup() has expired. A call
+ *      directly after OregonTHN128Rx_Read() usually returns 0.
+ * \param rx
+ *      Receiver context
+ * \param data
+ *      Frame returned by OregonTHN128Rx_Read()
+ * \return
+ *      Number of repeats
+ */
+uint8_t OregonTHN128Rx_GetRepeatCount(OregonTHN128Rx_t *rx, const OregonTHN128Data_t *data)
+{
+    /* Count repeats still in the queue */
+    rxQueueFilter(rx);
+
+    return OregonTHN128_DedupRepeatCount(&rx->dedup, data);
+}
+#endif
+
+#if OREGON_THN128_RX_RECOVER
+/*!
+ * \brief Recover frames with checksum errors
+ * \details
+ *      When enabled, frames with a checksum error are queued by the ISR. OregonTHN128Rx_Read()
+ *      combines two failed copies of a transmission received within
+ *      OREGON_THN128_RECOVER_WINDOW_MS and returns the frame when exactly one combination has a
+ *      valid checksum and plausible fields. A single failed copy is retried by flipping its
+ *      OREGON_THN128_RX_SOFT_BITS least confident bits, and the decoder accepts levels between
+ *      0.5 and 2.5 bit times while enabled. Recovered frames are counted in the receive
+ *      statistics.
+ * \param rx
+ *      Receiver context
+ * \param enable
+ *      true: Enable, false: disable (default)
+ */
+void OregonTHN128Rx_SetRecover(OregonTHN128Rx_t *rx, bool enable)
+{
+    rx->rxRecover = enable;
+#if OREGON_THN128_RX_SOFT_BITS
+    OregonTHN128_DecoderSetSoft(&rx->decoder, enable);
+#endif
+}
+#endif
+
+#if OREGON_THN128_RX_PROFILE
+/*!
+ * \brief Get receive interrupt cycle profile
+ * \details
+ *      Copies the profile and calculates the share of CPU time of the receive interrupt since
+ *      the last reset. Reset the profile at least once per 71 minutes.
+ * \param rx
+ *      Receiver context
+ * \param profile
+ *      Profile output
+ */
+void OregonTHN128Rx_GetIsrProfile(OregonTHN128Rx_t *rx, OregonTHN128IsrProfile_t *profile)
+{
+    uint32_t tElapsed;
+
+    noInterrupts();
+    memcpy(profile, &rx->profile, sizeof(OregonTHN128IsrProfile_t));
+    tElapsed = micros() - rx->tProfileBegin;
+    interrupts();
+
+    OregonTHN128_ProfileLoad(profile, tElapsed, PROFILE_CYCLES_PER_US());
+}
+
+/*!
+ * \brief Clear receive interrupt cycle profile
+ * \param rx
+ *      Receiver context
+ */
+void OregonTHN128Rx_ResetIsrProfile(OregonTHN128Rx_t *rx)
+{
+    noInterrupts();
+    OregonTHN128_ProfileReset(&rx->profile);
+    rx->tProfileBegin = micros();
+    interrupts();
+}
+#endif
 
 /*------------------------------------------------------------------------------------------------*/
-/*                                     Public functions                                           */
+/*                           Single receiver functions (default context)                          */
 /*------------------------------------------------------------------------------------------------*/
 /*!
  * \brief Initialize receiver pin
@@ -323,20 +855,26 @@ void IRAM_ATTR rfPinChange(void)
  */
 void OregonTHN128_RxBegin(uint8_t extIntPin)
 {
-    /* Initialize RF RX pin */
-    RF_RX_PIN_INIT(extIntPin);
+    OregonTHN128Rx_Begin(&_rx, extIntPin);
+}
 
-    /* Enable receive */
-    rxEnable();
+/*!
+ * \brief Stop receive and release the interrupt handler
+ */
+void OregonTHN128_RxEnd()
+{
+    OregonTHN128Rx_End(&_rx);
 }
 
 /*!
  * \brief Receive enable
+ * \details
+ *      Receive is enabled by OregonTHN128_RxBegin() and keeps running while frames are queued, so
+ *      calling this function after OregonTHN128_Read() is not needed anymore.
  */
 void OregonTHN128_RxEnable()
 {
-    /* Enable receive */
-    rxEnable();
+    OregonTHN128Rx_Enable(&_rx);
 }
 
 /*!
@@ -344,21 +882,31 @@ void OregonTHN128_RxEnable()
  */
 void OregonTHN128_RxDisable()
 {
-    /* Disable receive */
-    rxDisable();
+    OregonTHN128Rx_Disable(&_rx);
 }
 
+#if OREGON_THN128_RX_PROTOCOL_SELECT
+/*!
+ * \brief Set the protocol of the receiver
+ * \param protocol
+ *      Protocol, for example OregonTHN128_ProtocolTHN128 (default)
+ */
+void OregonTHN128_RxSetProtocol(const OregonTHN128Protocol_t *protocol)
+{
+    OregonTHN128Rx_SetProtocol(&_rx, protocol);
+}
+#endif
+
 /*!
  * \brief Check if data received
  * \retval true
- *      Data received
+ *      One or more frames in the receive queue
  * \retval false
  *      No data available
  */
 bool OregonTHN128_Available()
 {
-    /* Return receive complete */
-    return (_rxState == StateRxComplete) ? true : false;
+    return OregonTHN128Rx_Available(&_rx);
 }
 
 /*!
@@ -372,11 +920,94 @@ bool OregonTHN128_Available()
  */
 bool OregonTHN128_Read(OregonTHN128Data_t *data)
 {
-    if (OregonTHN128_Available()) {
-        /* Convert raw 32-bit data to data structure */
-        OregonTHN128_RawToData(_rxData, data);
-        return true;
-    } else {
-        return false;
-    }
+    return OregonTHN128Rx_Read(&_rx, data);
+}
+
+/*!
+ * \brief Get number of received frames dropped because the receive queue was full
+ * \return
+ *      Overrun count
+ */
+uint16_t OregonTHN128_GetOverrunCount()
+{
+    return OregonTHN128Rx_GetOverrunCount(&_rx);
 }
+
+#if OREGON_THN128_RX_STATS
+/*!
+ * \brief Get receive statistics
+ * \param stats
+ *      Statistics output
+ */
+void OregonTHN128_GetRxStats(OregonTHN128RxStats_t *stats)
+{
+    OregonTHN128Rx_GetRxStats(&_rx, stats);
+}
+
+/*!
+ * \brief Clear receive statistics and overrun count
+ */
+void OregonTHN128_ResetRxStats()
+{
+    OregonTHN128Rx_ResetRxStats(&_rx);
+}
+#endif
+
+#if OREGON_THN128_RX_DEDUP
+/*!
+ * \brief Report only the first copy of repeated frames
+ * \param windowMs
+ *      Repeat window in ms, for example OREGON_THN128_DEDUP_WINDOW_MS. 0: Report all frames.
+ */
+void OregonTHN128_RxSetDedup(uint16_t windowMs)
+{
+    OregonTHN128Rx_SetDedup(&_rx, windowMs);
+}
+
+/*!
+ * \brief Get number of repeats skipped after a frame
+ * \details
+ *      The count is final only after the repeat window set with OregonTHN128_RxSetDedup(), for
+ *      example OREGON_THN128_DEDUP_WINDOW_MS, has expired after OregonTHN128_Read().
+ * \param data
+ *      Frame returned by OregonTHN128_Read()
+ * \return
+ *      Number of repeats
+ */
+uint8_t OregonTHN128_GetRepeatCount(const OregonTHN128Data_t *data)
+{
+    return OregonTHN128Rx_GetRepeatCount(&_rx, data);
+}
+#endif
+
+#if OREGON_THN128_RX_RECOVER
+/*!
+ * \brief Recover frames with checksum errors
+ * \param enable
+ *      true: Enable, false: disable (default)
+ */
+void OregonTHN128_RxSetRecover(bool enable)
+{
+    OregonTHN128Rx_SetRecover(&_rx, enable);
+}
+#endif
+
+#if OREGON_THN128_RX_PROFILE
+/*!
+ * \brief Get receive interrupt cycle profile
+ * \param profile
+ *      Profile output
+ */
+void OregonTHN128_GetIsrProfile(OregonTHN128IsrProfile_t *profile)
+{
+    OregonTHN128Rx_GetIsrProfile(&_rx, profile);
+}
+
+/*!
+ * \brief Clear receive interrupt cycle profile
+ */
+void OregonTHN128_ResetIsrProfile()
+{
+    OregonTHN128Rx_ResetIsrProfile(&_rx);
+}
+#endif
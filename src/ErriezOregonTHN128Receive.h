@@ -88,22 +88,167 @@
 
 #include <stdint.h>
 #include "ErriezOregonTHN128.h"
+#include "ErriezOregonTHN128Decoder.h"
+#include "ErriezOregonTHN128Dedup.h"
+#include "ErriezOregonTHN128Profile.h"
+#include "ErriezOregonTHN128Recover.h"
 
-// Macro IRAM_ATTR is defined for ESP pin interrupts
-#ifndef IRAM_ATTR
-#define IRAM_ATTR
+/*!
+ * \def OREGON_THN128_RX_QUEUE_SIZE
+ * \brief Number of received frames buffered between the ISR and OregonTHN128_Read()
+ * \details
+ *      Power of 2, can be overruled by a compiler define
+ */
+#ifndef OREGON_THN128_RX_QUEUE_SIZE
+#define OREGON_THN128_RX_QUEUE_SIZE     4
+#endif
+
+/*!
+ * \def OREGON_THN128_RX_MAX_INSTANCES
+ * \brief Maximum number of receivers on different interrupt pins (1..4)
+ * \details
+ *      Can be overruled by a compiler define
+ */
+#ifndef OREGON_THN128_RX_MAX_INSTANCES
+#define OREGON_THN128_RX_MAX_INSTANCES  2
+#endif
+
+/*!
+ * \def OREGON_THN128_RX_DEDUP
+ * \brief Repeated frame filter in the receiver context
+ * \details
+ *      1: Frames are time stamped in the receive queue and repeats can be filtered with
+ *      OregonTHN128_RxSetDedup(). 0: Saves RAM. Can be overruled by a compiler define.
+ */
+#ifndef OREGON_THN128_RX_DEDUP
+#define OREGON_THN128_RX_DEDUP          1
+#endif
+
+/*!
+ * \def OREGON_THN128_RX_RECOVER
+ * \brief Recovery of frames with checksum errors in the receiver context
+ * \details
+ *      1: Frames with a checksum error are queued and combined with the repeated copy when
+ *      enabled with OregonTHN128_RxSetRecover(). 0: Saves RAM. Can be overruled by a compiler
+ *      define.
+ */
+#ifndef OREGON_THN128_RX_RECOVER
+#define OREGON_THN128_RX_RECOVER        1
+#endif
+
+/*!
+ * \def OREGON_THN128_RX_PROFILE
+ * \brief Measure the CPU cycles of each receive interrupt
+ * \details
+ *      1: Results are read with OregonTHN128_GetIsrProfile(). Cycles are counted with the CPU
+ *      cycle counter on ESP8266 and ESP32 and with Timer0 (resolution 64 cycles) on AVR.
+ *      0: Disabled (default). Can be overruled by a compiler define.
+ */
+#ifndef OREGON_THN128_RX_PROFILE
+#define OREGON_THN128_RX_PROFILE        0
 #endif
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/*!
+ * \brief Receiver context
+ * \details
+ *      Holds the complete decoder state of one receiver. Fields are private to the library.
+ */
+typedef struct {
+    uint8_t rxPin;                  /*!< Interrupt pin */
+#if defined(ARDUINO_ARCH_AVR)
+    uint8_t rxPinPort;              /*!< AVR input port of the pin */
+    uint8_t rxPinBit;               /*!< AVR bit mask of the pin */
+#endif
+    uint8_t instance;               /*!< Interrupt handler index + 1, 0: not initialized */
+    bool rxEnabled;                 /*!< Pin change interrupt attached */
+    uint32_t tPulseBegin;           /*!< Timestamp previous edge in us */
+    const OregonTHN128Protocol_t *protocol; /*!< Protocol of the decoder */
+    OregonTHN128Decoder_t decoder;  /*!< Receive state machine */
+    volatile uint32_t rxQueue[OREGON_THN128_RX_QUEUE_SIZE]; /*!< Received frames */
+    volatile uint8_t rxQueueHead;   /*!< Queue write index (ISR) */
+    volatile uint8_t rxQueueTail;   /*!< Queue read index (application) */
+    volatile uint16_t rxOverrunCount; /*!< Frames dropped on a full queue */
+#if OREGON_THN128_RX_DEDUP || OREGON_THN128_RX_RECOVER
+    volatile uint32_t rxQueueTime[OREGON_THN128_RX_QUEUE_SIZE]; /*!< Receive time in ms */
+    bool rxQueueChecked;            /*!< Oldest queued frame passed recovery and repeat filter */
+#endif
+#if OREGON_THN128_RX_DEDUP
+    OregonTHN128Dedup_t dedup;      /*!< Repeated frame filter */
+#endif
+#if OREGON_THN128_RX_RECOVER
+    volatile uint8_t rxQueueCrcError[OREGON_THN128_RX_QUEUE_SIZE]; /*!< Frame checksum error */
+#if OREGON_THN128_RX_SOFT_BITS
+    volatile uint8_t rxQueueSoftBits[OREGON_THN128_RX_QUEUE_SIZE][OREGON_THN128_RX_SOFT_BITS];
+                                    /*!< Least confident bits of a frame with a checksum error */
+#endif
+    volatile bool rxRecover;        /*!< Queue frames with checksum errors */
+    OregonTHN128Recover_t recover;  /*!< Frame recovery */
+#endif
+#if OREGON_THN128_RX_PROFILE
+    OregonTHN128IsrProfile_t profile; /*!< Interrupt handler cycle profile */
+    uint32_t tProfileBegin;         /*!< Timestamp profile reset in us */
+#endif
+} OregonTHN128Rx_t;
+
 /* Public functions */
+bool OregonTHN128Rx_Begin(OregonTHN128Rx_t *rx, uint8_t extIntPin);
+void OregonTHN128Rx_End(OregonTHN128Rx_t *rx);
+void OregonTHN128Rx_Enable(OregonTHN128Rx_t *rx);
+void OregonTHN128Rx_Disable(OregonTHN128Rx_t *rx);
+#if OREGON_THN128_RX_PROTOCOL_SELECT
+void OregonTHN128Rx_SetProtocol(OregonTHN128Rx_t *rx, const OregonTHN128Protocol_t *protocol);
+#endif
+bool OregonTHN128Rx_Available(OregonTHN128Rx_t *rx);
+bool OregonTHN128Rx_Read(OregonTHN128Rx_t *rx, OregonTHN128Data_t *data);
+uint16_t OregonTHN128Rx_GetOverrunCount(OregonTHN128Rx_t *rx);
+#if OREGON_THN128_RX_STATS
+void OregonTHN128Rx_GetRxStats(OregonTHN128Rx_t *rx, OregonTHN128RxStats_t *stats);
+void OregonTHN128Rx_ResetRxStats(OregonTHN128Rx_t *rx);
+#endif
+#if OREGON_THN128_RX_DEDUP
+void OregonTHN128Rx_SetDedup(OregonTHN128Rx_t *rx, uint16_t windowMs);
+/* Repeat count is final only after the dedup window has expired */
+uint8_t OregonTHN128Rx_GetRepeatCount(OregonTHN128Rx_t *rx, const OregonTHN128Data_t *data);
+#endif
+#if OREGON_THN128_RX_RECOVER
+void OregonTHN128Rx_SetRecover(OregonTHN128Rx_t *rx, bool enable);
+#endif
+#if OREGON_THN128_RX_PROFILE
+void OregonTHN128Rx_GetIsrProfile(OregonTHN128Rx_t *rx, OregonTHN128IsrProfile_t *profile);
+void OregonTHN128Rx_ResetIsrProfile(OregonTHN128Rx_t *rx);
+#endif
+
+/* Single receiver functions */
 void OregonTHN128_RxBegin(uint8_t extIntPin);
+void OregonTHN128_RxEnd();
 void OregonTHN128_RxEnable();
 void OregonTHN128_RxDisable();
+#if OREGON_THN128_RX_PROTOCOL_SELECT
+void OregonTHN128_RxSetProtocol(const OregonTHN128Protocol_t *protocol);
+#endif
 bool OregonTHN128_Available(void);
 bool OregonTHN128_Read(OregonTHN128Data_t *data);
+uint16_t OregonTHN128_GetOverrunCount(void);
+#if OREGON_THN128_RX_STATS
+void OregonTHN128_GetRxStats(OregonTHN128RxStats_t *stats);
+void OregonTHN128_ResetRxStats(void);
+#endif
+#if OREGON_THN128_RX_DEDUP
+void OregonTHN128_RxSetDedup(uint16_t windowMs);
+/* Repeat count is final only after the dedup window has expired */
+uint8_t OregonTHN128_GetRepeatCount(const OregonTHN128Data_t *data);
+#endif
+#if OREGON_THN128_RX_RECOVER
+void OregonTHN128_RxSetRecover(bool enable);
+#endif
+#if OREGON_THN128_RX_PROFILE
+void OregonTHN128_GetIsrProfile(OregonTHN128IsrProfile_t *profile);
+void OregonTHN128_ResetIsrProfile(void);
+#endif
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,237 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Recover.c
+ * \brief Oregon THN128 recovery of frames with checksum errors
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ */
+
+#include <string.h>
+#include "ErriezOregonTHN128Recover.h"
+
+/* Check maximum number of different bits */
+#if (OREGON_THN128_RECOVER_MAX_DIFF < 1) || (OREGON_THN128_RECOVER_MAX_DIFF > 16)
+#error "OREGON_THN128_RECOVER_MAX_DIFF must be between 1 and 16"
+#endif
+
+/*!
+ * \brief Count bits set
+ * \param x
+ *      Value
+ * \return
+ *      Number of bits set
+ */
+static uint8_t bitCount(uint32_t x)
+{
+    uint8_t n = 0;
+
+    while (x) {
+        x &= x - 1;
+        n++;
+    }
+
+    return n;
+}
+
+/*!
+ * \brief Initialize frame recovery for OregonTHN128_ProtocolTHN128
+ * \param rec
+ *      Frame recovery state
+ */
+void OregonTHN128_RecoverInit(OregonTHN128Recover_t *rec)
+{
+    memset(rec, 0, sizeof(OregonTHN128Recover_t));
+    rec->protocol = &OregonTHN128_ProtocolTHN128;
+}
+
+/*!
+ * \brief Set the protocol of the frames
+ * \details
+ *      Drops a stored failed frame of the previous protocol.
+ * \param rec
+ *      Frame recovery state
+ * \param protocol
+ *      Protocol, must remain valid while recovery uses it
+ */
+void OregonTHN128_RecoverSetProtocol(OregonTHN128Recover_t *rec,
+                                     const OregonTHN128Protocol_t *protocol)
+{
+    rec->protocol = protocol;
+    rec->pending = false;
+}
+
+/*!
+ * \brief Combine two copies of a frame with checksum errors
+ * \details
+ *      Tries all combinations of the bits in which the copies differ.
+ * \param protocol
+ *      Protocol of the frames
+ * \param copy0
+ *      First copy
+ * \param copy1
+ *      Second copy
+ * \param rawData
+ *      Recovered frame output
+ * \retval true
+ *      Exactly one combination has a valid checksum and plausible fields
+ * \retval false
+ *      Copies are equal, differ in more than OREGON_THN128_RECOVER_MAX_DIFF bits, or no or
+ *      more than one valid combination
+ */
+bool OregonTHN128_RecoverCombine(const OregonTHN128Protocol_t *protocol, uint32_t copy0,
+                                 uint32_t copy1, uint32_t *rawData)
+{
+    uint32_t diff = copy0 ^ copy1;
+    uint32_t subset = 0;
+    uint32_t candidate;
+    uint8_t found = 0;
+
+    if ((diff == 0) || (bitCount(diff) > OREGON_THN128_RECOVER_MAX_DIFF)) {
+        return false;
+    }
+
+    /* Enumerate all subsets of the different bits, including both copies */
+    do {
+        candidate = copy0 ^ subset;
+        if (protocol->checkCrc(candidate) && protocol->isPlausible(candidate)) {
+            if (found++) {
+                return false;
+            }
+            *rawData = candidate;
+        }
+        subset = (subset - diff) & diff;
+    } while (subset);
+
+    return found ? true : false;
+}
+
+/*!
+ * \brief Recover a frame with a checksum error
+ * \details
+ *      The failed frame is combined with the previous failed frame when it was received within
+ *      OREGON_THN128_RECOVER_WINDOW_MS. Otherwise only its least confident bits are flipped, see
+ *      OregonTHN128_RecoverSoft(), and it is stored for the next failed frame. Other bits of a
+ *      single copy are never flipped: the 8-bit checksum would accept too many wrong frames.
+ * \param rec
+ *      Frame recovery state
+ * \param failedData
+ *      Frame with a checksum error
+ * \param softBits
+ *      Least confident bit numbers of failedData, may be NULL
+ * \param numBits
+ *      Number of bit numbers, 0..8
+ * \param tMs
+ *      Receive time in ms, for example millis()
+ * \param rawData
+ *      Recovered frame output
+ * \retval true
+ *      Frame recovered
+ * \retval false
+ *      Not recovered
+ */
+bool OregonTHN128_RecoverFrame(OregonTHN128Recover_t *rec, uint32_t failedData,
+                               const uint8_t *softBits, uint8_t numBits, uint32_t tMs,
+                               uint32_t *rawData)
+{
+    uint32_t diff;
+
+    if (rec->pending && ((uint32_t)(tMs - rec->tFailed) <= OREGON_THN128_RECOVER_WINDOW_MS)) {
+        diff = rec->failedData ^ failedData;
+        if (OregonTHN128_RecoverCombine(rec->protocol, rec->failedData, failedData, rawData)) {
+            rec->pending = false;
+            rec->recovered++;
+            return true;
+        }
+        if (diff && (bitCount(diff) <= OREGON_THN128_RECOVER_MAX_DIFF)) {
+            rec->rejected++;
+        }
+    }
+
+    if (softBits && OregonTHN128_RecoverSoft(rec->protocol, failedData, softBits, numBits,
+                                             rawData)) {
+        /* Not combined again with the next copy */
+        rec->pending = false;
+        rec->softRecovered++;
+        return true;
+    }
+
+    /* Keep for the next copy */
+    rec->failedData = failedData;
+    rec->tFailed = tMs;
+    rec->pending = true;
+
+    return false;
+}
+
+/*!
+ * \brief Recover a frame with a checksum error from its least confident bits
+ * \details
+ *      Tries all 2^numBits - 1 combinations of flips of the given bits, for example the
+ *      softBits[] recorded by the decoder. Runs outside the interrupt handler.
+ * \param protocol
+ *      Protocol of the frame
+ * \param failedData
+ *      Frame with a checksum error
+ * \param softBits
+ *      Bit numbers 0..31 to retry
+ * \param numBits
+ *      Number of bit numbers, 1..8
+ * \param rawData
+ *      Recovered frame output
+ * \retval true
+ *      Exactly one combination has a valid checksum and plausible fields
+ * \retval false
+ *      No or more than one valid combination
+ */
+bool OregonTHN128_RecoverSoft(const OregonTHN128Protocol_t *protocol, uint32_t failedData,
+                              const uint8_t *softBits, uint8_t numBits, uint32_t *rawData)
+{
+    uint32_t mask = 0;
+    uint32_t subset = 0;
+    uint32_t candidate;
+    uint8_t found = 0;
+
+    if ((numBits == 0) || (numBits > 8)) {
+        return false;
+    }
+    for (uint8_t i = 0; i < numBits; i++) {
+        mask |= 1UL << (softBits[i] & 31);
+    }
+
+    /* Enumerate all non-empty subsets of the bits */
+    while ((subset = (subset - mask) & mask) != 0) {
+        candidate = failedData ^ subset;
+        if (protocol->checkCrc(candidate) && protocol->isPlausible(candidate)) {
+            if (found++) {
+                return false;
+            }
+            *rawData = candidate;
+        }
+    }
+
+    return found ? true : false;
+}
@@ -0,0 +1,103 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Recover.h
+ * \brief Oregon THN128 recovery of frames with checksum errors
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      A THN128 transmits every frame twice. At the edge of the range both copies may fail the
+ *      checksum with errors in different bits. The bits in which both copies agree are taken as
+ *      received, all combinations of the bits in which they differ are tried. A combination is
+ *      accepted when it is the only one with a valid checksum and plausible fields, checked with
+ *      the checkCrc and isPlausible functions of the protocol.
+ *
+ *      A single copy is retried by flipping the bits the decoder received with the largest timing
+ *      deviation, see OREGON_THN128_RX_SOFT_BITS.
+ */
+
+#ifndef ERRIEZ_OREGON_THN128_RECOVER_H_
+#define ERRIEZ_OREGON_THN128_RECOVER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ErriezOregonTHN128.h"
+#include "ErriezOregonTHN128Decoder.h"
+
+/*!
+ * \def OREGON_THN128_RECOVER_MAX_DIFF
+ * \brief Maximum number of bits in which the two copies differ (1..16)
+ * \details
+ *      2^n combinations are checked. Can be overruled by a compiler define.
+ */
+#ifndef OREGON_THN128_RECOVER_MAX_DIFF
+#define OREGON_THN128_RECOVER_MAX_DIFF  6
+#endif
+
+/*!
+ * \def OREGON_THN128_RECOVER_WINDOW_MS
+ * \brief Maximum time between the two copies in ms
+ */
+#ifndef OREGON_THN128_RECOVER_WINDOW_MS
+#define OREGON_THN128_RECOVER_WINDOW_MS 500
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Frame recovery state
+ * \details
+ *      Fields are private to the library. Initialize with OregonTHN128_RecoverInit().
+ */
+typedef struct {
+    const OregonTHN128Protocol_t *protocol; /*!< Protocol of the frames */
+    uint32_t failedData;            /*!< Last frame with a checksum error */
+    uint32_t tFailed;               /*!< Receive time of the failed frame in ms */
+    bool pending;                   /*!< Failed frame stored */
+    uint16_t recovered;             /*!< Number of frames recovered from two copies */
+    uint16_t softRecovered;         /*!< Number of frames recovered from least confident bits */
+    uint16_t rejected;              /*!< Copies without exactly one valid combination */
+} OregonTHN128Recover_t;
+
+/* Public functions */
+void OregonTHN128_RecoverInit(OregonTHN128Recover_t *rec);
+void OregonTHN128_RecoverSetProtocol(OregonTHN128Recover_t *rec,
+                                     const OregonTHN128Protocol_t *protocol);
+bool OregonTHN128_RecoverCombine(const OregonTHN128Protocol_t *protocol, uint32_t copy0,
+                                 uint32_t copy1, uint32_t *rawData);
+bool OregonTHN128_RecoverFrame(OregonTHN128Recover_t *rec, uint32_t failedData,
+                               const uint8_t *softBits, uint8_t numBits, uint32_t tMs,
+                               uint32_t *rawData);
+bool OregonTHN128_RecoverSoft(const OregonTHN128Protocol_t *protocol, uint32_t failedData,
+                              const uint8_t *softBits, uint8_t numBits, uint32_t *rawData);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ERRIEZ_OREGON_THN128_RECOVER_H_ */
@@ -0,0 +1,258 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Registry.c
+ * \brief Oregon THN128 sensor registry
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ */
+
+#include <string.h>
+#include "ErriezOregonTHN128Registry.h"
+
+/* Check registry size */
+#if (OREGON_THN128_REGISTRY_SIZE < 1) || (OREGON_THN128_REGISTRY_SIZE > OREGON_THN128_SENSOR_KEYS)
+#error "OREGON_THN128_REGISTRY_SIZE must be between 1 and 32"
+#endif
+
+/*! Sensor key of an entry */
+#define SENSOR_KEY(sensor)  OREGON_THN128_SENSOR((sensor)->channel, (sensor)->rollingAddress)
+
+/*!
+ * \brief Find the entry of a silent sensor on a channel
+ * \details
+ *      Only called for a new rolling address.
+ * \param reg
+ *      Sensor registry
+ * \param channel
+ *      Channel
+ * \param tMs
+ *      Current time in ms
+ * \return
+ *      Entry silent for at least OREGON_THN128_REGISTRY_SWAP_MS, the longest silent first, or NULL
+ */
+static OregonTHN128Sensor_t *findSilent(OregonTHN128Registry_t *reg, uint8_t channel,
+                                        uint32_t tMs)
+{
+    OregonTHN128Sensor_t *silent = NULL;
+    uint32_t tSilentMax = OREGON_THN128_REGISTRY_SWAP_MS;
+    uint32_t tSilent;
+
+    for (uint8_t i = 0; i < OREGON_THN128_REGISTRY_SIZE; i++) {
+        if (reg->sensors[i].channel == channel) {
+            tSilent = tMs - reg->sensors[i].tLastSeen;
+            if (tSilent >= tSilentMax) {
+                tSilentMax = tSilent;
+                silent = &reg->sensors[i];
+            }
+        }
+    }
+
+    return silent;
+}
+
+/*!
+ * \brief Find a free entry
+ * \param reg
+ *      Sensor registry
+ * \return
+ *      Unused entry, a stale entry when all entries are used, or NULL
+ */
+static OregonTHN128Sensor_t *findFree(OregonTHN128Registry_t *reg)
+{
+    OregonTHN128Sensor_t *stale = NULL;
+
+    for (uint8_t i = 0; i < OREGON_THN128_REGISTRY_SIZE; i++) {
+        if (reg->sensors[i].channel == 0) {
+            return &reg->sensors[i];
+        }
+        if (reg->sensors[i].stale && (stale == NULL)) {
+            stale = &reg->sensors[i];
+        }
+    }
+
+    /* Replace stale sensor */
+    if (stale) {
+        OregonTHN128_RegistryRemove(reg, stale);
+    }
+
+    return stale;
+}
+
+/*!
+ * \brief Initialize sensor registry
+ * \param reg
+ *      Sensor registry
+ * \param timeoutMs
+ *      Time in ms after which a sensor which is not received is stale, for example 2 minutes
+ */
+void OregonTHN128_RegistryInit(OregonTHN128Registry_t *reg, uint32_t timeoutMs)
+{
+    memset(reg, 0, sizeof(OregonTHN128Registry_t));
+    reg->timeoutMs = timeoutMs;
+}
+
+/*!
+ * \brief Store received frame
+ * \details
+ *      A known sensor is found with the key index. A new rolling address replaces the entry of a
+ *      sensor on the same channel which has been silent for OREGON_THN128_REGISTRY_SWAP_MS,
+ *      otherwise it is added as new sensor in a free or stale entry.
+ * \param reg
+ *      Sensor registry
+ * \param data
+ *      Received frame
+ * \param tMs
+ *      Receive time in ms, for example millis()
+ * \param sensor
+ *      Output updated sensor entry, NULL when the registry is full. May be NULL.
+ * \return
+ *      OregonTHN128SensorEvent_t
+ */
+uint8_t OregonTHN128_RegistryUpdate(OregonTHN128Registry_t *reg, const OregonTHN128Data_t *data,
+                                    uint32_t tMs, OregonTHN128Sensor_t **sensor)
+{
+    uint8_t key = OREGON_THN128_SENSOR(data->channel, data->rollingAddress);
+    uint8_t event = OregonTHN128SensorUpdated;
+    OregonTHN128Sensor_t *entry;
+
+    if (reg->index[key]) {
+        entry = &reg->sensors[reg->index[key] - 1];
+    } else {
+        entry = findSilent(reg, data->channel, tMs);
+        if (entry) {
+            /* Battery swap: the sensor continues with a new rolling address */
+            reg->index[SENSOR_KEY(entry)] = 0;
+            entry->previousRollingAddress = entry->rollingAddress;
+            event = OregonTHN128SensorAddressChanged;
+        } else {
+            entry = findFree(reg);
+            if (entry == NULL) {
+                if (sensor) {
+                    *sensor = NULL;
+                }
+                return OregonTHN128SensorFull;
+            }
+            entry->previousRollingAddress = data->rollingAddress;
+            event = OregonTHN128SensorNew;
+        }
+
+        entry->channel = data->channel;
+        entry->rollingAddress = data->rollingAddress;
+        reg->index[key] = (uint8_t)(entry - reg->sensors) + 1;
+    }
+
+    entry->tLastSeen = tMs;
+    entry->temperature = data->temperature;
+    entry->lowBattery = data->lowBattery;
+    entry->stale = false;
+
+    if (sensor) {
+        *sensor = entry;
+    }
+
+    return event;
+}
+
+/*!
+ * \brief Find sensor
+ * \param reg
+ *      Sensor registry
+ * \param channel
+ *      Channel 1..4
+ * \param rollingAddress
+ *      Rolling address
+ * \return
+ *      Sensor entry or NULL
+ */
+OregonTHN128Sensor_t *OregonTHN128_RegistryFind(OregonTHN128Registry_t *reg, uint8_t channel,
+                                                uint8_t rollingAddress)
+{
+    uint8_t slot = reg->index[OREGON_THN128_SENSOR(channel, rollingAddress)];
+
+    return slot ? &reg->sensors[slot - 1] : NULL;
+}
+
+/*!
+ * \brief Get sensor entry
+ * \param reg
+ *      Sensor registry
+ * \param i
+ *      Entry 0 .. OREGON_THN128_REGISTRY_SIZE - 1
+ * \return
+ *      Sensor entry or NULL when not used
+ */
+OregonTHN128Sensor_t *OregonTHN128_RegistryGet(OregonTHN128Registry_t *reg, uint8_t i)
+{
+    if ((i >= OREGON_THN128_REGISTRY_SIZE) || (reg->sensors[i].channel == 0)) {
+        return NULL;
+    }
+
+    return &reg->sensors[i];
+}
+
+/*!
+ * \brief Check the next sensor entry for a timeout
+ * \details
+ *      Call periodically, for example every second. Each call checks one entry, so all sensors
+ *      are checked within OREGON_THN128_REGISTRY_SIZE calls at a constant cost per call.
+ * \param reg
+ *      Sensor registry
+ * \param tMs
+ *      Current time in ms, for example millis()
+ * \return
+ *      Sensor which became stale or NULL
+ */
+OregonTHN128Sensor_t *OregonTHN128_RegistryTick(OregonTHN128Registry_t *reg, uint32_t tMs)
+{
+    OregonTHN128Sensor_t *sensor = &reg->sensors[reg->sweep];
+
+    if (++reg->sweep >= OREGON_THN128_REGISTRY_SIZE) {
+        reg->sweep = 0;
+    }
+
+    if (sensor->channel && !sensor->stale && ((tMs - sensor->tLastSeen) > reg->timeoutMs)) {
+        sensor->stale = true;
+        return sensor;
+    }
+
+    return NULL;
+}
+
+/*!
+ * \brief Remove sensor
+ * \param reg
+ *      Sensor registry
+ * \param sensor
+ *      Sensor entry
+ */
+void OregonTHN128_RegistryRemove(OregonTHN128Registry_t *reg, OregonTHN128Sensor_t *sensor)
+{
+    if (sensor->channel) {
+        reg->index[SENSOR_KEY(sensor)] = 0;
+    }
+    memset(sensor, 0, sizeof(OregonTHN128Sensor_t));
+}
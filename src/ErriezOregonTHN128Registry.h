@@ -0,0 +1,123 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Registry.h
+ * \brief Oregon THN128 sensor registry
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      Keeps the last reading of each sensor, identified by channel and rolling address, in a
+ *      fixed table. A key index finds the sensor of a frame without a search. A timer tick marks
+ *      one sensor per call stale when it has not been received within the timeout, and a new
+ *      rolling address on the channel of a silent sensor is reported as an address change after
+ *      a battery swap.
+ */
+
+#ifndef ERRIEZ_OREGON_THN128_REGISTRY_H_
+#define ERRIEZ_OREGON_THN128_REGISTRY_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ErriezOregonTHN128.h"
+
+/*!
+ * \def OREGON_THN128_REGISTRY_SIZE
+ * \brief Maximum number of sensors in the registry (1..32)
+ * \details
+ *      Can be overruled by a compiler define.
+ */
+#ifndef OREGON_THN128_REGISTRY_SIZE
+#define OREGON_THN128_REGISTRY_SIZE     4
+#endif
+
+/*!
+ * \def OREGON_THN128_REGISTRY_SWAP_MS
+ * \brief Minimum silence of a sensor in ms before a new rolling address on its channel is an
+ *        address change
+ * \details
+ *      A sensor transmits every 30 seconds. Two missed frames plus margin are required, so a
+ *      single dropped frame of a running sensor does not hand its entry to a second sensor which
+ *      starts on the same channel. Shorter silences register the new rolling address as another
+ *      sensor. Can be overruled by a compiler define.
+ */
+#ifndef OREGON_THN128_REGISTRY_SWAP_MS
+#define OREGON_THN128_REGISTRY_SWAP_MS  65000UL
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*!
+ * \brief Result of OregonTHN128_RegistryUpdate()
+ */
+typedef enum {
+    OregonTHN128SensorUpdated = 0,  /*!< Known sensor updated */
+    OregonTHN128SensorNew = 1,      /*!< New sensor added */
+    OregonTHN128SensorAddressChanged = 2, /*!< Rolling address of a silent sensor changed */
+    OregonTHN128SensorFull = 3      /*!< New sensor not added, registry full */
+} OregonTHN128SensorEvent_t;
+
+/*!
+ * \brief Sensor entry
+ */
+typedef struct {
+    uint32_t tLastSeen;             /*!< Receive time of the last frame in ms */
+    int16_t temperature;            /*!< Last temperature */
+    uint8_t channel;                /*!< Channel, 0: entry not used */
+    uint8_t rollingAddress;         /*!< Rolling address */
+    uint8_t previousRollingAddress; /*!< Rolling address before the last address change */
+    bool lowBattery;                /*!< Last low battery indication */
+    bool stale;                     /*!< Not received within the timeout */
+} OregonTHN128Sensor_t;
+
+/*!
+ * \brief Sensor registry
+ * \details
+ *      Fields are private to the library. Initialize with OregonTHN128_RegistryInit().
+ */
+typedef struct {
+    uint32_t timeoutMs;             /*!< Stale timeout in ms */
+    uint8_t index[OREGON_THN128_SENSOR_KEYS]; /*!< Sensor entry + 1 per key, 0: unknown */
+    uint8_t sweep;                  /*!< Next entry checked by OregonTHN128_RegistryTick() */
+    OregonTHN128Sensor_t sensors[OREGON_THN128_REGISTRY_SIZE]; /*!< Sensor entries */
+} OregonTHN128Registry_t;
+
+/* Public functions */
+void OregonTHN128_RegistryInit(OregonTHN128Registry_t *reg, uint32_t timeoutMs);
+uint8_t OregonTHN128_RegistryUpdate(OregonTHN128Registry_t *reg, const OregonTHN128Data_t *data,
+                                    uint32_t tMs, OregonTHN128Sensor_t **sensor);
+OregonTHN128Sensor_t *OregonTHN128_RegistryFind(OregonTHN128Registry_t *reg, uint8_t channel,
+                                                uint8_t rollingAddress);
+OregonTHN128Sensor_t *OregonTHN128_RegistryGet(OregonTHN128Registry_t *reg, uint8_t i);
+OregonTHN128Sensor_t *OregonTHN128_RegistryTick(OregonTHN128Registry_t *reg, uint32_t tMs);
+void OregonTHN128_RegistryRemove(OregonTHN128Registry_t *reg, OregonTHN128Sensor_t *sensor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ERRIEZ_OREGON_THN128_REGISTRY_H_ */
@@ -0,0 +1,222 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Store.c
+ * \brief Oregon THN128 columnar reading store
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ */
+
+#include "ErriezOregonTHN128Store.h"
+
+/*!
+ * \brief Find first reading with a timestamp equal or later than the requested timestamp
+ * \param store
+ *      Reading store
+ * \param timestamp
+ *      Timestamp
+ * \return
+ *      Index 0..count
+ */
+static size_t lowerBound(const OregonTHN128Store_t *store, uint32_t timestamp)
+{
+    size_t first = 0;
+    size_t count = store->count;
+
+    /* Binary search, reads only the timestamp array */
+    while (count > 0) {
+        size_t half = count / 2;
+
+        if (store->timestamp[first + half] < timestamp) {
+            first += half + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+
+    return first;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+/*                                     Public functions                                           */
+/*------------------------------------------------------------------------------------------------*/
+/*!
+ * \brief Initialize reading store
+ * \param store
+ *      Reading store
+ * \param timestamp
+ *      Array of capacity timestamps
+ * \param sensor
+ *      Array of capacity sensor keys
+ * \param temperature
+ *      Array of capacity temperatures
+ * \param flags
+ *      Array of capacity flags
+ * \param capacity
+ *      Maximum number of readings
+ */
+void OregonTHN128_StoreInit(OregonTHN128Store_t *store, uint32_t *timestamp, uint8_t *sensor,
+                            int16_t *temperature, uint8_t *flags, size_t capacity)
+{
+    store->timestamp = timestamp;
+    store->sensor = sensor;
+    store->temperature = temperature;
+    store->flags = flags;
+    store->capacity = capacity;
+    store->count = 0;
+}
+
+/*!
+ * \brief Append reading
+ * \param store
+ *      Reading store
+ * \param timestamp
+ *      Receive time in application units, for example seconds. Must be equal or later than the
+ *      previous reading.
+ * \param data
+ *      Decoded frame, see OregonTHN128_RawToData()
+ * \return
+ *      true: Success, false: store full or timestamp earlier than the previous reading
+ */
+bool OregonTHN128_StoreAppend(OregonTHN128Store_t *store, uint32_t timestamp,
+                              const OregonTHN128Data_t *data)
+{
+    size_t i = store->count;
+
+    if ((i >= store->capacity) || (i && (timestamp < store->timestamp[i - 1]))) {
+        return false;
+    }
+
+    store->timestamp[i] = timestamp;
+    store->sensor[i] = OREGON_THN128_SENSOR(data->channel, data->rollingAddress);
+    store->temperature[i] = data->temperature;
+    store->flags[i] = data->lowBattery ? OREGON_THN128_FLAG_LOW_BATTERY : 0;
+    store->count = i + 1;
+
+    return true;
+}
+
+/*!
+ * \brief Find readings in a time range
+ * \param store
+ *      Reading store
+ * \param tBegin
+ *      First timestamp
+ * \param tEnd
+ *      End timestamp, not included
+ * \param first
+ *      Output index of the first reading in the range
+ * \return
+ *      Number of readings in the range
+ */
+size_t OregonTHN128_StoreRange(const OregonTHN128Store_t *store, uint32_t tBegin, uint32_t tEnd,
+                               size_t *first)
+{
+    size_t end;
+
+    *first = lowerBound(store, tBegin);
+    end = lowerBound(store, tEnd);
+
+    return (end > *first) ? (end - *first) : 0;
+}
+
+/*!
+ * \brief Find readings of one sensor
+ * \param store
+ *      Reading store
+ * \param first
+ *      Index of the first reading to scan
+ * \param count
+ *      Number of readings to scan
+ * \param sensor
+ *      Sensor key, see OREGON_THN128_SENSOR()
+ * \param indices
+ *      Output indices of the matching readings
+ * \param maxIndices
+ *      Size of the indices array, the scan stops when it is full
+ * \return
+ *      Number of indices written
+ */
+size_t OregonTHN128_StoreFilter(const OregonTHN128Store_t *store, size_t first, size_t count,
+                                uint8_t sensor, size_t *indices, size_t maxIndices)
+{
+    const uint8_t *sensors = store->sensor;
+    size_t end = first + count;
+    size_t n = 0;
+
+    /* Branchless: the index is always written and kept only on a match */
+    for (size_t i = first; (i < end) && (n < maxIndices); i++) {
+        indices[n] = i;
+        n += (sensors[i] == sensor);
+    }
+
+    return n;
+}
+
+/*!
+ * \brief Calculate temperature statistics of one sensor
+ * \param store
+ *      Reading store
+ * \param first
+ *      Index of the first reading to scan
+ * \param count
+ *      Number of readings to scan
+ * \param sensor
+ *      Sensor key, see OREGON_THN128_SENSOR()
+ * \param stats
+ *      Output statistics, minimum and maximum are INT16_MAX and INT16_MIN without readings
+ */
+void OregonTHN128_StoreStats(const OregonTHN128Store_t *store, size_t first, size_t count,
+                             uint8_t sensor, OregonTHN128StoreStats_t *stats)
+{
+    const uint8_t *sensors = store->sensor;
+    const int16_t *temperatures = store->temperature;
+    int16_t minTemperature = INT16_MAX;
+    int16_t maxTemperature = INT16_MIN;
+    int64_t sumTemperature = 0;
+    size_t n = 0;
+
+    for (size_t i = first; i < (first + count); i++) {
+        if (sensors[i] == sensor) {
+            int16_t temperature = temperatures[i];
+
+            if (temperature < minTemperature) {
+                minTemperature = temperature;
+            }
+            if (temperature > maxTemperature) {
+                maxTemperature = temperature;
+            }
+            sumTemperature += temperature;
+            n++;
+        }
+    }
+
+    stats->count = n;
+    stats->minTemperature = minTemperature;
+    stats->maxTemperature = maxTemperature;
+    stats->sumTemperature = sumTemperature;
+}
@@ -0,0 +1,93 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2020-2026 Erriez
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*!
+ * \file ErriezOregonTHN128Store.h
+ * \brief Oregon THN128 columnar reading store
+ * \details
+ *      Source:         https://github.com/Erriez/ErriezOregonTHN128
+ *      Documentation:  https://erriez.github.io/ErriezOregonTHN128
+ *
+ *      Keeps received readings in separate arrays per field (structure of arrays), 8 Bytes per
+ *      reading. Range scans read only the timestamps, sensor filters only the sensor keys and
+ *      the temperature statistics only the sensor keys and temperatures. The arrays are provided
+ *      by the application, so the store can be used on a host with millions of readings and on
+ *      a microcontroller with a small history.
+ */
+
+#ifndef ERRIEZ_OREGON_THN128_STORE_H_
+#define ERRIEZ_OREGON_THN128_STORE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ErriezOregonTHN128.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! Flag low battery */
+#define OREGON_THN128_FLAG_LOW_BATTERY  0x01
+
+/*!
+ * \brief Reading store
+ * \details
+ *      Fields are private to the library. Initialize with OregonTHN128_StoreInit().
+ */
+typedef struct {
+    uint32_t *timestamp;        /*!< Timestamp per reading, non-decreasing */
+    uint8_t *sensor;            /*!< Sensor key per reading, see OREGON_THN128_SENSOR() */
+    int16_t *temperature;       /*!< Temperature per reading */
+    uint8_t *flags;             /*!< Flags per reading */
+    size_t capacity;            /*!< Size of the arrays */
+    size_t count;               /*!< Number of readings */
+} OregonTHN128Store_t;
+
+/*!
+ * \brief Temperature statistics
+ */
+typedef struct {
+    size_t count;               /*!< Number of readings */
+    int16_t minTemperature;     /*!< Minimum temperature */
+    int16_t maxTemperature;     /*!< Maximum temperature */
+    int64_t sumTemperature;     /*!< Sum of the temperatures */
+} OregonTHN128StoreStats_t;
+
+/* Public functions */
+void OregonTHN128_StoreInit(OregonTHN128Store_t *store, uint32_t *timestamp, uint8_t *sensor,
+                            int16_t *temperature, uint8_t *flags, size_t capacity);
+bool OregonTHN128_StoreAppend(OregonTHN128Store_t *store, uint32_t timestamp,
+                              const OregonTHN128Data_t *data);
+size_t OregonTHN128_StoreRange(const OregonTHN128Store_t *store, uint32_t tBegin, uint32_t tEnd,
+                               size_t *first);
+size_t OregonTHN128_StoreFilter(const OregonTHN128Store_t *store, size_t first, size_t count,
+                                uint8_t sensor, size_t *indices, size_t maxIndices);
+void OregonTHN128_StoreStats(const OregonTHN128Store_t *store, size_t first, size_t count,
+                             uint8_t sensor, OregonTHN128StoreStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ERRIEZ_OREGON_THN128_STORE_H_ */
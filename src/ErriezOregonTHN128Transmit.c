@@ -31,6 +31,7 @@
  */
 
 #include <Arduino.h>
+#include "ErriezOregonTHN128Encoder.h"
 #include "ErriezOregonTHN128Transmit.h"
 
 /* Function prototypes */
@@ -104,6 +105,44 @@ static int8_t _rfTxBit = -1;
  */
 #define RF_TX_DELAY_MS(ms)          _delay_ms(ms)
 
+/*!
+ * \def TX_TIMER_TICKS(us)
+ * \brief Timer1 compare value, clock F_CPU / 64: 4us resolution and 262ms range at 16MHz
+ */
+#define TX_TIMER_TICKS(us)          ((uint16_t)((((uint32_t)(us) * (F_CPU / 1000000UL)) / 64) - 1))
+
+/*!
+ * \def TX_TIMER_START(us)
+ * \brief Start Timer1 in CTC mode with compare A interrupt after us
+ */
+#define TX_TIMER_START(us)          {                               \
+    TCCR1A = 0;                                                     \
+    TCCR1B = 0;                                                     \
+    TCNT1 = 0;                                                      \
+    OCR1A = TX_TIMER_TICKS(us);                                     \
+    TIFR1 = _BV(OCF1A);                                             \
+    TIMSK1 |= _BV(OCIE1A);                                          \
+    TCCR1B = _BV(WGM12) | _BV(CS11) | _BV(CS10);                    \
+}
+
+/*!
+ * \def TX_TIMER_NEXT(us)
+ * \brief Next interrupt us after the previous interrupt
+ * \details
+ *      Called from the compare interrupt. The counter restarted at the compare match, so the
+ *      interrupt latency does not accumulate.
+ */
+#define TX_TIMER_NEXT(us)           { OCR1A = TX_TIMER_TICKS(us); }
+
+/*!
+ * \def TX_TIMER_STOP()
+ * \brief Stop Timer1
+ */
+#define TX_TIMER_STOP()             {                               \
+    TIMSK1 &= ~_BV(OCIE1A);                                         \
+    TCCR1B = 0;                                                     \
+}
+
 #elif defined(ARDUINO_ARCH_ESP8266) || defined(ARDUINO_ARCH_ESP32)
 static int8_t _rfTxPin = -1;
 
@@ -158,12 +197,171 @@ static int8_t _rfTxPin = -1;
  * \brief Generic delay in ms
  */
 #define RF_TX_DELAY_MS(ms)          delay(ms)
+
+#if defined(ARDUINO_ARCH_ESP8266)
+/*! ESP8266 minimum timer1 ticks when the deadline has passed */
+#define TX_TIMER_MIN_TICKS          10
+
+/*! ESP8266 deadline of the running timer in us, micros() */
+static uint32_t _txDeadline;
+
+/*!
+ * \def TX_TIMER_START(us)
+ * \brief Start timer1 single shot, clock 80MHz / 16: 5 ticks per us
+ */
+#define TX_TIMER_START(us)          {                               \
+    timer1_attachInterrupt(txTimerIsr);                             \
+    timer1_enable(TIM_DIV16, TIM_EDGE, TIM_SINGLE);                 \
+    _txDeadline = micros() + (us);                                  \
+    timer1_write((us) * 5);                                         \
+}
+
+/*!
+ * \def TX_TIMER_NEXT(us)
+ * \brief Next interrupt us after the previous deadline
+ * \details
+ *      Scheduling from the deadline instead of from now prevents that the interrupt latency
+ *      accumulates over the levels of the frame.
+ */
+#define TX_TIMER_NEXT(us)           {                               \
+    int32_t timeout;                                                \
+    _txDeadline += (us);                                            \
+    timeout = (int32_t)(_txDeadline - micros());                    \
+    timer1_write((timeout > (TX_TIMER_MIN_TICKS / 5)) ?             \
+                 (uint32_t)timeout * 5 : TX_TIMER_MIN_TICKS);       \
+}
+
+/*!
+ * \def TX_TIMER_STOP()
+ * \brief Stop timer1
+ */
+#define TX_TIMER_STOP()             {                               \
+    timer1_disable();                                               \
+    timer1_detachInterrupt();                                       \
+}
+#else
+#include <esp_timer.h>
+
+/*!
+ * \def TX_TIMER_DISPATCH
+ * \brief esp_timer dispatch method
+ * \details
+ *      ISR dispatch when the core supports it, otherwise the esp_timer task. The task adds
+ *      latency to each level, which does not accumulate because levels are scheduled from the
+ *      deadline.
+ */
+#if CONFIG_ESP_TIMER_SUPPORTS_ISR_DISPATCH_METHOD
+#define TX_TIMER_DISPATCH           ESP_TIMER_ISR
+#else
+#define TX_TIMER_DISPATCH           ESP_TIMER_TASK
+#endif
+
+/*! ESP32 transmit timer */
+static esp_timer_handle_t _txTimer;
+
+/*! ESP32 deadline of the running timer in us since boot */
+static int64_t _txDeadline;
+
+/*!
+ * \def TX_TIMER_START(us)
+ * \brief Create the esp_timer once and start it single shot
+ */
+#define TX_TIMER_START(us)          {                               \
+    if (_txTimer == NULL) {                                         \
+        esp_timer_create_args_t args = {                            \
+            .callback = txTimerCallback,                            \
+            .arg = NULL,                                            \
+            .dispatch_method = TX_TIMER_DISPATCH,                   \
+            .name = "oregon_tx"                                     \
+        };                                                          \
+        esp_timer_create(&args, &_txTimer);                         \
+    }                                                               \
+    _txDeadline = esp_timer_get_time() + (us);                      \
+    esp_timer_start_once(_txTimer, (us));                           \
+}
+
+/*!
+ * \def TX_TIMER_NEXT(us)
+ * \brief Next timer callback us after the previous deadline
+ * \details
+ *      Scheduling from the deadline instead of from now prevents that the callback latency
+ *      accumulates over the levels of the frame.
+ */
+#define TX_TIMER_NEXT(us)           {                               \
+    int64_t timeout;                                                \
+    _txDeadline += (us);                                            \
+    timeout = _txDeadline - esp_timer_get_time();                   \
+    esp_timer_start_once(_txTimer, (timeout > 0) ? (uint64_t)timeout : 0); \
+}
+
+/*!
+ * \def TX_TIMER_STOP()
+ * \brief Stop timer
+ */
+#define TX_TIMER_STOP()             { esp_timer_stop(_txTimer); }
+#endif
+
 #else
 #error "May work, but not tested on this target"
 #endif
 
 /*! @} */
 
+/* Asynchronous transmit state */
+static OregonTHN128Encoder_t _txEncoder;
+static volatile bool _txBusy;
+static OregonTHN128TxCallback_t _txCallback;
+static void *_txCallbackArg;
+
+
+/*!
+ * \brief Transmit timer interrupt: output next level of the waveform
+ */
+static void IRAM_ATTR txTimerIsr(void)
+{
+    uint32_t duration;
+    uint8_t level;
+
+    if (OregonTHN128_EncoderNext(&_txEncoder, &level, &duration)) {
+        if (level) {
+            RF_TX_PIN_HIGH();
+        } else {
+            RF_TX_PIN_LOW();
+        }
+        TX_TIMER_NEXT(duration);
+    } else {
+        /* Transmission complete */
+        RF_TX_PIN_LOW();
+        TX_TIMER_STOP();
+        _txBusy = false;
+        if (_txCallback) {
+            _txCallback(_txCallbackArg);
+        }
+    }
+}
+
+#if defined(ARDUINO_ARCH_AVR)
+/*!
+ * \brief Timer1 compare A interrupt
+ * \details
+ *      Weak, so sketches using Timer1 (for example Servo) still link. The asynchronous
+ *      transmit functions cannot be used together with such libraries.
+ */
+ISR(TIMER1_COMPA_vect, __attribute__((weak)))
+{
+    txTimerIsr();
+}
+#elif defined(ARDUINO_ARCH_ESP32)
+/*!
+ * \brief esp_timer callback, called from the timer interrupt or the esp_timer task
+ */
+static void IRAM_ATTR txTimerCallback(void *arg)
+{
+    (void)arg;
+
+    txTimerIsr();
+}
+#endif
 
 /*!
  * \brief Transmit sync pulse
@@ -258,6 +456,12 @@ void OregonTHN128_TxBegin(uint8_t rfTxPin)
  */
 void OregonTHN128_TxEnd(void)
 {
+    /* Abort asynchronous transmit */
+    if (_txBusy) {
+        TX_TIMER_STOP();
+        _txBusy = false;
+    }
+
     /* Set RF transmit pin input */
     RF_TX_PIN_DISABLE();
 }
@@ -269,8 +473,8 @@ void OregonTHN128_TxEnd(void)
  */
 void OregonTHN128_TxRawData(uint32_t rawData)
 {
-    /* Check RF transmit pin initialized */
-    if (!IS_RF_TX_PIN_INITIALIZED()) {
+    /* Check RF transmit pin initialized and not transmitting asynchronously */
+    if (!IS_RF_TX_PIN_INITIALIZED() || _txBusy) {
         return;
     }
 
@@ -296,4 +500,80 @@ void OregonTHN128_Transmit(OregonTHN128Data_t *data)
 
     // Send raw data
     OregonTHN128_TxRawData(data->rawData);
-}
\ No newline at end of file
+}
+
+/*!
+ * \brief Transmit data in the background
+ * \details
+ *      Transmits the frame OREGON_THN128_TX_FRAMES times with T_SPACE_FRAMES_MS between the
+ *      frames, driven by a timer interrupt: Timer1 on AVR, timer1 on ESP8266 and esp_timer on
+ *      ESP32. The application continues during the transmission, but must not enter a sleep mode
+ *      which stops the timer, such as AVR power-down.
+ * \param rawData
+ *      32-bit raw data input
+ * \param callback
+ *      Called from the timer interrupt when the transmission is complete, can be NULL
+ * \param arg
+ *      User argument passed to the callback
+ * \return
+ *      true: Transmission started, false: pin not initialized or transmit busy
+ */
+bool OregonTHN128_TxRawDataAsync(uint32_t rawData, OregonTHN128TxCallback_t callback, void *arg)
+{
+    uint32_t duration;
+    uint8_t level;
+
+    /* Check RF transmit pin initialized and not transmitting */
+    if (!IS_RF_TX_PIN_INITIALIZED() || _txBusy) {
+        return false;
+    }
+
+    _txCallback = callback;
+    _txCallbackArg = arg;
+    _txBusy = true;
+
+    /* Output first level, the timer interrupt outputs the next levels */
+    OregonTHN128_EncoderInit(&_txEncoder, rawData, OREGON_THN128_TX_FRAMES);
+    OregonTHN128_EncoderNext(&_txEncoder, &level, &duration);
+    if (level) {
+        RF_TX_PIN_HIGH();
+    } else {
+        RF_TX_PIN_LOW();
+    }
+    TX_TIMER_START(duration);
+
+    return true;
+}
+
+/*!
+ * \brief Transmit in the background
+ * \details
+ *      See OregonTHN128_TxRawDataAsync(), the frame is repeated automatically.
+ * \param data
+ *      Oregon THN128 input structure
+ * \param callback
+ *      Called from the timer interrupt when the transmission is complete, can be NULL
+ * \param arg
+ *      User argument passed to the callback
+ * \return
+ *      true: Transmission started, false: pin not initialized or transmit busy
+ */
+bool OregonTHN128_TransmitAsync(OregonTHN128Data_t *data, OregonTHN128TxCallback_t callback,
+                                void *arg)
+{
+    // Convert data structure to 32-bit raw data;
+    data->rawData = OregonTHN128_DataToRaw(data);
+
+    // Send raw data in the background
+    return OregonTHN128_TxRawDataAsync(data->rawData, callback, arg);
+}
+
+/*!
+ * \brief Check if an asynchronous transmission is in progress
+ * \return
+ *      true: Transmitting, false: idle
+ */
+bool OregonTHN128_TxBusy(void)
+{
+    return _txBusy;
+}
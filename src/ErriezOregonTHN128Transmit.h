@@ -41,10 +41,33 @@ extern "C" {
 #include <stdint.h>
 #include "ErriezOregonTHN128.h"
 
+/*!
+ * \def OREGON_THN128_TX_FRAMES
+ * \brief Number of times a frame is transmitted by the asynchronous transmit functions
+ * \details
+ *      Can be overruled by a compiler define
+ */
+#ifndef OREGON_THN128_TX_FRAMES
+#define OREGON_THN128_TX_FRAMES     2
+#endif
+
+/*!
+ * \brief Callback when an asynchronous transmission is complete
+ * \param arg
+ *      User argument passed to OregonTHN128_TxRawDataAsync()
+ */
+typedef void (*OregonTHN128TxCallback_t)(void *arg);
+
 void OregonTHN128_TxBegin(uint8_t rfTxPin);
+void OregonTHN128_TxEnd(void);
 void OregonTHN128_TxRawData(uint32_t rawData);
 void OregonTHN128_Transmit(OregonTHN128Data_t *data);
 
+bool OregonTHN128_TxRawDataAsync(uint32_t rawData, OregonTHN128TxCallback_t callback, void *arg);
+bool OregonTHN128_TransmitAsync(OregonTHN128Data_t *data, OregonTHN128TxCallback_t callback,
+                                void *arg);
+bool OregonTHN128_TxBusy(void);
+
 #ifdef __cplusplus
 }
 #endif